@@ -0,0 +1,443 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  cholesky.h
+ *  Nov 27, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_ALGEBRA_CHOLESKY_H__INCLUDED
+#define TILEDARRAY_ALGEBRA_CHOLESKY_H__INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <Eigen/Cholesky>
+#include <TiledArray/conversions/eigen.h>
+#include <TiledArray/algebra/utils.h>
+#include "../dist_array.h"
+
+namespace TiledArray {
+
+  namespace detail {
+
+    // Tile kernels -----------------------------------------------------------
+
+    /// Cholesky factor of a diagonal tile
+
+    /// \tparam Tile A contiguous tensor type
+    /// \param a A Hermitian positive-definite tile
+    /// \return The lower triangular tile \c l , <tt>a = l * l^H</tt>
+    /// \throw TiledArray::Exception if \c a is not positive definite
+    template <typename Tile>
+    Tile cholesky_potrf(const Tile& a) {
+      typedef Eigen::Matrix<typename Tile::value_type, Eigen::Dynamic,
+          Eigen::Dynamic, Eigen::RowMajor> matrix_type;
+      const auto n = a.range().extent(0);
+
+      Eigen::LLT<matrix_type> llt(eigen_map(a, n, n));
+      if(llt.info() != Eigen::Success)
+        TA_EXCEPTION("cholesky(): the matrix is not positive definite");
+
+      Tile result(a.range());
+      eigen_map(result, n, n) = llt.matrixL();
+      return result;
+    }
+
+    /// Off-diagonal tile of the Cholesky factor
+
+    /// \tparam Tile A contiguous tensor type
+    /// \param a The updated off-diagonal tile, (i,j)
+    /// \param l The diagonal tile of the factor, (j,j)
+    /// \return <tt>a * l^-H</tt>
+    template <typename Tile>
+    Tile cholesky_trsm(const Tile& a, const Tile& l) {
+      const auto m = a.range().extent(0);
+      const auto n = a.range().extent(1);
+
+      Tile result = a.clone();
+      auto result_map = eigen_map(result, m, n);
+      eigen_map(l, n, n).template triangularView<Eigen::Lower>().adjoint().
+          template solveInPlace<Eigen::OnTheRight>(result_map);
+      return result;
+    }
+
+    /// Trailing update of the Cholesky factorization
+
+    /// \tparam Tile A contiguous tensor type
+    /// \param c The tile, (i,j), to be updated
+    /// \param a Tile (i,k) of the factor
+    /// \param b Tile (j,k) of the factor
+    /// \return <tt>c - a * b^H</tt>
+    template <typename Tile>
+    Tile cholesky_update(const Tile& c, const Tile& a, const Tile& b) {
+      const auto m = c.range().extent(0);
+      const auto n = c.range().extent(1);
+      const auto k = a.range().extent(1);
+
+      Tile result = c.clone();
+      eigen_map(result, m, n).noalias() -=
+          eigen_map(a, m, k) * eigen_map(b, n, k).adjoint();
+      return result;
+    }
+
+    /// Diagonal block of a triangular solve
+
+    /// \tparam Tile A contiguous tensor type
+    /// \param l A diagonal tile of the lower triangular factor
+    /// \param b The updated right-hand side tile
+    /// \param adjoint If true, solve with <tt>l^H</tt> instead of \c l
+    /// \return <tt>l^-1 * b</tt>, or <tt>l^-H * b</tt>
+    template <typename Tile>
+    Tile triangular_solve_trsm(const Tile& l, const Tile& b, const bool adjoint) {
+      const auto m = b.range().extent(0);
+      const auto n = b.range().extent(1);
+
+      Tile result = b.clone();
+      auto result_map = eigen_map(result, m, n);
+      const auto l_map = eigen_map(l, m, m);
+      if(adjoint)
+        l_map.template triangularView<Eigen::Lower>().adjoint().solveInPlace(result_map);
+      else
+        l_map.template triangularView<Eigen::Lower>().solveInPlace(result_map);
+      return result;
+    }
+
+    /// Update of the right-hand side of a triangular solve
+
+    /// \tparam Tile A contiguous tensor type
+    /// \param c The right-hand side tile to be updated
+    /// \param l A tile of the lower triangular factor
+    /// \param x A tile of the solution
+    /// \param adjoint If true, use <tt>l^H</tt> instead of \c l
+    /// \return <tt>c - l * x</tt>, or <tt>c - l^H * x</tt>
+    template <typename Tile>
+    Tile triangular_solve_update(const Tile& c, const Tile& l, const Tile& x,
+        const bool adjoint)
+    {
+      const auto m = c.range().extent(0);
+      const auto n = c.range().extent(1);
+      const auto k = x.range().extent(0);
+
+      Tile result = c.clone();
+      auto result_map = eigen_map(result, m, n);
+      if(adjoint)
+        result_map.noalias() -= eigen_map(l, k, m).adjoint() * eigen_map(x, k, n);
+      else
+        result_map.noalias() -= eigen_map(l, m, k) * eigen_map(x, k, n);
+      return result;
+    }
+
+    // Shapes -----------------------------------------------------------------
+
+    /// Estimate of the norm of the inverse of a lower triangular tile
+
+    /// Exact for multiples of the identity, but not a bound: it may
+    /// underestimate the norm of the inverse of an ill-conditioned tile by
+    /// orders of magnitude.
+    /// \param norm The Frobenius norm of the tile
+    /// \param n The number of rows of the tile
+    inline float inverse_norm_estimate(const float norm, const std::size_t n) {
+      return (norm > 0.0f ? std::sqrt(float(n)) / norm : 0.0f);
+    }
+
+    /// Norm of a structurally non-zero tile
+
+    /// The norm estimates of the fill-in of a factorization are not bounds,
+    /// so they must not decide which tiles are zero. This returns the
+    /// estimate, raised if needed so that the tile survives screening.
+    /// \param norm The norm estimate of the tile
+    /// \param volume The volume of the tile
+    /// \return A tile norm that is not screened by the current threshold
+    inline float structural_norm(const float norm, const std::size_t volume) {
+      const double scoped = shape_threshold_accessor();
+      const float threshold =
+          (scoped >= 0.0 ? float(scoped) : SparseShape<float>::threshold());
+      // the factor 2 leaves room for rounding when the norm is scaled
+      const float min_norm = std::max(2.0f * threshold,
+          std::numeric_limits<float>::min()) * float(volume);
+      return std::max(norm, min_norm);
+    }
+
+    template <typename Tile>
+    DenseShape cholesky_shape(const DistArray<Tile, DensePolicy>&) {
+      return DenseShape();
+    }
+
+    /// Shape of the Cholesky factor of a block-sparse array
+
+    /// The fill-in of the factor is determined symbolically: tile \c (i,j)
+    /// of the factor is non-zero if tile \c (i,j) of \c a is, or if tiles
+    /// \c (i,k) and \c (j,k) of the factor are for some <tt>k < j</tt>.
+    /// Every structurally non-zero tile is kept; its norm is estimated by
+    /// propagating tile norms through the tiled factorization. Tiles above
+    /// the diagonal are zero.
+    /// \param a The array to be factorized
+    /// \return The shape of the Cholesky factor of \c a
+    template <typename Tile>
+    SparseShape<float> cholesky_shape(const DistArray<Tile, SparsePolicy>& a) {
+      const auto& a_shape = a.shape();
+      const auto& a_norms = a_shape.tile_norms();
+      const auto& tiling = a.trange().data()[0];
+      const std::size_t n = tiling.tile_extent();
+
+      Tensor<float> norms(a.trange().tiles_range(), 0.0f);
+      std::vector<bool> nonzero(n * n, false);
+      for(std::size_t j = 0ul; j < n; ++j) {
+        const std::size_t n_j = tiling.tile(j).second - tiling.tile(j).first;
+        for(std::size_t i = j; i < n; ++i) {
+          const std::size_t n_i = tiling.tile(i).second - tiling.tile(i).first;
+          bool fill = ! a_shape.is_zero(i * n + j);
+          float s = a_norms[i * n + j];
+          for(std::size_t k = 0ul; k < j; ++k) {
+            if(! (nonzero[i * n + k] && nonzero[j * n + k])) continue;
+            fill = true;
+            s += norms[i * n + k] * norms[j * n + k];
+          }
+
+          if(i == j) {
+            TA_USER_ASSERT(! a_shape.is_zero(j * n + j),
+                "cholesky(): diagonal tiles of the array must be non-zero");
+            norms[j * n + j] = structural_norm(std::sqrt(s * std::sqrt(float(n_j))),
+                n_j * n_j);
+            nonzero[j * n + j] = true;
+          } else if(fill) {
+            norms[i * n + j] = structural_norm(
+                s * inverse_norm_estimate(norms[j * n + j], n_j), n_i * n_j);
+            nonzero[i * n + j] = true;
+          }
+        }
+      }
+
+      return SparseShape<float>(norms, a.trange());
+    }
+
+    template <typename Tile>
+    DenseShape triangular_solve_shape(const DistArray<Tile, DensePolicy>&,
+        const DistArray<Tile, DensePolicy>&, const bool)
+    {
+      return DenseShape();
+    }
+
+    /// Shape of the solution of a block-sparse triangular solve
+
+    /// As for \c cholesky_shape() the fill-in of the solution is determined
+    /// symbolically from the non-zero tiles of \c l and \c b , and the norms
+    /// of its tiles are estimates.
+    /// \param l The lower triangular factor
+    /// \param b The right-hand side
+    /// \param adjoint If true, solve with <tt>l^H</tt> instead of \c l
+    /// \return The shape of the solution
+    template <typename Tile>
+    SparseShape<float> triangular_solve_shape(
+        const DistArray<Tile, SparsePolicy>& l,
+        const DistArray<Tile, SparsePolicy>& b, const bool adjoint)
+    {
+      const auto& l_shape = l.shape();
+      const auto& b_shape = b.shape();
+      const auto& l_norms = l_shape.tile_norms();
+      const auto& b_norms = b_shape.tile_norms();
+      const auto& row_tiling = l.trange().data()[0];
+      const auto& col_tiling = b.trange().data()[1];
+      const std::size_t n = row_tiling.tile_extent();
+      const std::size_t m = col_tiling.tile_extent();
+
+      Tensor<float> norms(b.trange().tiles_range(), 0.0f);
+      std::vector<bool> nonzero(n * m, false);
+      for(std::size_t r = 0ul; r < n; ++r) {
+        // forward substitution visits the rows in ascending order, backward
+        // substitution in descending order
+        const std::size_t i = (adjoint ? n - r - 1ul : r);
+        const std::size_t n_i = row_tiling.tile(i).second - row_tiling.tile(i).first;
+        const float l_ii_inv = inverse_norm_estimate(l_norms[i * n + i], n_i);
+        const std::size_t first = (adjoint ? i + 1ul : 0ul);
+        const std::size_t last = (adjoint ? n : i);
+        for(std::size_t c = 0ul; c < m; ++c) {
+          const std::size_t m_c = col_tiling.tile(c).second - col_tiling.tile(c).first;
+          bool fill = ! b_shape.is_zero(i * m + c);
+          float s = b_norms[i * m + c];
+          for(std::size_t k = first; k < last; ++k) {
+            const std::size_t l_ord = (adjoint ? k * n + i : i * n + k);
+            if(l_shape.is_zero(l_ord) || ! nonzero[k * m + c]) continue;
+            fill = true;
+            s += l_norms[l_ord] * norms[k * m + c];
+          }
+          if(fill) {
+            norms[i * m + c] = structural_norm(s * l_ii_inv, n_i * m_c);
+            nonzero[i * m + c] = true;
+          }
+        }
+      }
+
+      return SparseShape<float>(norms, b.trange());
+    }
+
+  } // namespace detail
+
+  /// Tiled Cholesky factorization
+
+  /// Computes the lower triangular factor \c L , <tt>A = L * L^H</tt>, of a
+  /// Hermitian positive-definite matrix with a right-looking tiled algorithm.
+  /// Every tile operation is a task on the owner of the tile it produces, the
+  /// tiles of \c L are exchanged via the array itself, so the factorization
+  /// works on the tiles and process map of \c A without redistribution. For
+  /// block-sparse arrays the fill-in of \c L is determined symbolically from
+  /// the shape of \c A and only the non-zero tiles of \c L are computed. Only the lower
+  /// triangle of \c A is referenced.
+  /// \tparam Tile A contiguous tensor type
+  /// \tparam Policy The array policy type
+  /// \param A A Hermitian positive-definite matrix; its row and column
+  /// tilings must be identical
+  /// \return The Cholesky factor of \c A , with the tiling and process map
+  /// of \c A
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> cholesky(const DistArray<Tile, Policy>& A) {
+    typedef DistArray<Tile, Policy> array_type;
+    typedef typename array_type::value_type value_type;
+    typedef typename array_type::element_type element_type;
+
+    const auto& trange = A.trange();
+    TA_USER_ASSERT((trange.rank() == 2u) && (trange.data()[0] == trange.data()[1]),
+        "cholesky(): the array must be a matrix with identical row and column tilings");
+
+    World& world = A.world();
+    const std::size_t n = trange.data()[0].tile_extent();
+    array_type L(world, trange, detail::cholesky_shape(A), A.pmap());
+
+    for(const auto ord : *L.pmap()) {
+      if(L.is_zero(ord)) continue;
+      const std::size_t i = ord / n;
+      const std::size_t j = ord % n;
+
+      // The upper triangle of dense factors is zero
+      if(i < j) {
+        L.set(ord, value_type(trange.make_tile_range(ord), element_type(0)));
+        continue;
+      }
+
+      Future<value_type> a_ij = (A.is_zero(ord) ?
+          Future<value_type>(value_type(trange.make_tile_range(ord), element_type(0))) :
+          A.find(ord));
+
+      // Apply the updates from the preceding columns of the factor
+      for(std::size_t k = 0ul; k < j; ++k) {
+        if(L.is_zero(i * n + k) || L.is_zero(j * n + k)) continue;
+        a_ij = world.taskq.add(& detail::cholesky_update<value_type>, a_ij,
+            L.find(i * n + k), L.find(j * n + k));
+      }
+
+      if(i == j)
+        L.set(ord, world.taskq.add(& detail::cholesky_potrf<value_type>, a_ij));
+      else
+        L.set(ord, world.taskq.add(& detail::cholesky_trsm<value_type>, a_ij,
+            L.find(j * n + j)));
+    }
+
+    return L;
+  }
+
+  /// Tiled triangular solve
+
+  /// Solves <tt>L * X = B</tt> (or <tt>L^H * X = B</tt>) by tiled forward
+  /// (backward) substitution; as in \c cholesky() every tile operation is a
+  /// task on the owner of the tile of \c X it contributes to.
+  /// \tparam Tile A contiguous tensor type
+  /// \tparam Policy The array policy type
+  /// \param L A lower triangular matrix, e.g. computed by \c cholesky()
+  /// \param B The right-hand side matrix; its row tiling must match the
+  /// tiling of \c L
+  /// \param adjoint If true, solve with <tt>L^H</tt> instead of \c L
+  /// \return The solution \c X , with the tiling and process map of \c B
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> triangular_solve(const DistArray<Tile, Policy>& L,
+      const DistArray<Tile, Policy>& B, const bool adjoint = false)
+  {
+    typedef DistArray<Tile, Policy> array_type;
+    typedef typename array_type::value_type value_type;
+    typedef typename array_type::element_type element_type;
+
+    const auto& trange = B.trange();
+    TA_USER_ASSERT((L.trange().rank() == 2u) && (trange.rank() == 2u) &&
+        (L.trange().data()[0] == L.trange().data()[1]) &&
+        (L.trange().data()[0] == trange.data()[0]),
+        "triangular_solve(): the tilings of the arguments are not compatible");
+
+    World& world = B.world();
+    const std::size_t n = trange.data()[0].tile_extent();
+    const std::size_t m = trange.data()[1].tile_extent();
+    array_type X(world, trange, detail::triangular_solve_shape(L, B, adjoint),
+        B.pmap());
+
+    for(const auto ord : *X.pmap()) {
+      if(X.is_zero(ord)) continue;
+      const std::size_t i = ord / m;
+      const std::size_t c = ord % m;
+
+      Future<value_type> b_ic = (B.is_zero(ord) ?
+          Future<value_type>(value_type(trange.make_tile_range(ord), element_type(0))) :
+          B.find(ord));
+
+      // Apply the updates from the rows of X solved before row i
+      const std::size_t first = (adjoint ? i + 1ul : 0ul);
+      const std::size_t last = (adjoint ? n : i);
+      for(std::size_t k = first; k < last; ++k) {
+        const std::size_t l_ord = (adjoint ? k * n + i : i * n + k);
+        if(L.is_zero(l_ord) || X.is_zero(k * m + c)) continue;
+        b_ic = world.taskq.add(& detail::triangular_solve_update<value_type>,
+            b_ic, L.find(l_ord), X.find(k * m + c), adjoint);
+      }
+
+      X.set(ord, world.taskq.add(& detail::triangular_solve_trsm<value_type>,
+          L.find(i * n + i), b_ic, adjoint));
+    }
+
+    return X;
+  }
+
+  /// Inverse of a lower triangular matrix
+
+  /// \tparam Tile A contiguous tensor type
+  /// \tparam Policy The array policy type
+  /// \param L A lower triangular matrix, e.g. computed by \c cholesky()
+  /// \return <tt>L^-1</tt>
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> triangular_inverse(const DistArray<Tile, Policy>& L) {
+    return triangular_solve(L, detail::make_identity(L));
+  }
+
+  /// Solves a Hermitian positive-definite linear system
+
+  /// \tparam Tile A contiguous tensor type
+  /// \tparam Policy The array policy type
+  /// \param A A Hermitian positive-definite matrix
+  /// \param B The right-hand side matrix
+  /// \return \c X , <tt>A * X = B</tt>
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> cholesky_solve(const DistArray<Tile, Policy>& A,
+      const DistArray<Tile, Policy>& B)
+  {
+    const auto L = cholesky(A);
+    return triangular_solve(L, triangular_solve(L, B), true);
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_ALGEBRA_CHOLESKY_H__INCLUDED
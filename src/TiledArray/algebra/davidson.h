@@ -0,0 +1,337 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  davidson.h
+ *  Dec 5, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_ALGEBRA_DAVIDSON_H__INCLUDED
+#define TILEDARRAY_ALGEBRA_DAVIDSON_H__INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <Eigen/Eigenvalues>
+#include <TiledArray/algebra/utils.h>
+#include <TiledArray/conversions/eigen.h>
+#include "../dist_array.h"
+
+namespace TiledArray {
+
+  /// Block-Davidson solver for the lowest eigenpairs of a real symmetric
+  /// linear operator
+
+  /// A block of vectors is stored as a single \c DistArray whose first mode
+  /// indexes the vectors in the block and whose remaining modes are those of
+  /// a single vector. All operations on the subspace are therefore batched:
+  /// the Gram and subspace matrices of two blocks are obtained from one
+  /// contraction, linear combinations of a block are one contraction with a
+  /// small coefficient matrix, and the sigma function receives a whole
+  /// block, so the user can batch the matrix-vector products as well.
+  ///
+  /// Usage:
+  /// \code
+  /// DavidsonSolver<TA::Tensor<double>, TA::DensePolicy> davidson(nroots);
+  /// // sigma(x, result) computes result("k,i,j") = A(x("k,i,j"))
+  /// const bool converged = davidson(sigma, guess, diagonal, 1e-8);
+  /// const auto& e = davidson.eigenvalues();
+  /// \endcode
+  /// \tparam Tile The tile type
+  /// \tparam Policy The array policy type
+  template <typename Tile, typename Policy>
+  class DavidsonSolver {
+  public:
+    typedef DistArray<Tile, Policy> array_type; ///< The block of vectors type
+    typedef typename array_type::value_type value_type; ///< The tile type
+    typedef typename array_type::element_type element_type; ///< The element type
+    typedef Eigen::Matrix<element_type, Eigen::Dynamic, Eigen::Dynamic> EigenMatrixX;
+    typedef Eigen::Matrix<element_type, Eigen::Dynamic, 1> EigenVectorX;
+
+  private:
+    unsigned int nroots_; ///< The number of roots
+    unsigned int max_subspace_; ///< The maximum number of subspace vectors
+    std::string vec_vars_; ///< Annotation of a single vector
+    std::string k_vars_; ///< Annotation of a block, batch index "k"
+    std::string l_vars_; ///< Annotation of a block, batch index "l"
+    std::vector<array_type> V_; ///< Blocks of orthonormal subspace vectors
+    std::vector<array_type> S_; ///< Sigma vectors of the subspace blocks
+    EigenMatrixX H_; ///< Subspace matrix
+    EigenVectorX eigenvalues_; ///< Ritz values
+    array_type eigenvectors_; ///< Ritz vectors
+    EigenVectorX residual_norms_; ///< Residual norms of the Ritz vectors
+    unsigned int iterations_; ///< The number of iterations performed
+
+    /// Gather a small distributed matrix on every rank
+    static EigenMatrixX to_eigen(array_type array) {
+      array.make_replicated();
+      return array_to_eigen(array);
+    }
+
+    /// Small matrix with a single tile
+    static array_type make_matrix(World& world, const EigenMatrixX& m) {
+      const TiledRange trange{TiledRange1{0, std::size_t(m.rows())},
+                              TiledRange1{0, std::size_t(m.cols())}};
+      return eigen_to_array<array_type>(world, trange, m);
+    }
+
+    /// Batched Gram matrix, <tt>G(k,l) = a(k) . b(l)</tt>
+    EigenMatrixX gram(const array_type& a, const array_type& b) const {
+      array_type g;
+      g("k,l") = a(k_vars_) * b(l_vars_);
+      return to_eigen(g);
+    }
+
+    /// Linear combination of a block, <tt>result(k) = sum_l c(k,l) v(l)</tt>
+    array_type combine(const EigenMatrixX& c, const array_type& v) const {
+      const array_type c_array = make_matrix(v.world(), c);
+      array_type result;
+      result(k_vars_) = c_array("k,l") * v(l_vars_);
+      return result;
+    }
+
+    /// Orthonormalize a block against the subspace and within itself
+
+    /// Vectors that are linearly dependent on the subspace (or on each other)
+    /// are dropped.
+    /// \return false if no vector is left
+    bool orthonormalize(array_type& block) const {
+      // classical Gram-Schmidt against the subspace, done twice
+      for(int pass = 0; pass < 2; ++pass) {
+        for(const auto& v : V_) {
+          const array_type c_array = make_matrix(block.world(), gram(block, v));
+          block(k_vars_) = block(k_vars_) - c_array("k,l") * v(l_vars_);
+        }
+      }
+
+      // symmetric orthonormalization of the block, dropping null vectors
+      Eigen::SelfAdjointEigenSolver<EigenMatrixX> es(gram(block, block));
+      const auto& lambda = es.eigenvalues();
+      const double threshold = 1e-12 * std::max(1.0, double(lambda.maxCoeff()));
+      std::vector<Eigen::Index> kept;
+      for(Eigen::Index i = 0; i < lambda.size(); ++i)
+        if(lambda(i) > threshold) kept.push_back(i);
+      if(kept.empty()) return false;
+
+      EigenMatrixX q(kept.size(), lambda.size());
+      for(std::size_t i = 0ul; i < kept.size(); ++i)
+        q.row(i) = es.eigenvectors().col(kept[i]).transpose() / std::sqrt(lambda(kept[i]));
+      block = combine(q, block);
+      return true;
+    }
+
+    /// Applies the diagonal preconditioner to a tile of the residual block
+    static value_type precondition_tile(const value_type& r, const value_type& d,
+        const std::vector<element_type>& theta)
+    {
+      value_type result(r.range());
+      const std::size_t nv = d.range().volume();
+      const std::size_t nk = r.range().volume() / nv;
+      const std::size_t k0 = r.range().lobound_data()[0];
+      for(std::size_t k = 0ul; k < nk; ++k) {
+        for(std::size_t i = 0ul; i < nv; ++i) {
+          const element_type denom = theta[k0 + k] - d[i];
+          result[k * nv + i] = (std::abs(denom) > 1e-8 ? r[k * nv + i] / denom :
+              r[k * nv + i] / element_type(1e-8));
+        }
+      }
+      return result;
+    }
+
+    /// Davidson correction vectors, <tt>(theta - D)^-1 r</tt>
+    array_type precondition(const array_type& r, const array_type& diagonal,
+        const std::vector<element_type>& theta) const
+    {
+      World& world = r.world();
+      array_type result(world, r.trange(), r.shape(), r.pmap());
+      const auto& tiles = r.trange().tiles_range();
+      const auto& diagonal_tiles = diagonal.trange().tiles_range();
+      for(const auto ord : *result.pmap()) {
+        if(result.is_zero(ord)) continue;
+        const auto index = tiles.idx(ord);
+        const std::vector<std::size_t> d_index(index.begin() + 1, index.end());
+        const auto d_ord = diagonal_tiles.ordinal(d_index);
+        const Future<value_type> d_tile = (diagonal.is_zero(d_ord) ?
+            Future<value_type>(value_type(diagonal.trange().make_tile_range(d_ord),
+                element_type(0))) : diagonal.find(d_ord));
+        result.set(ord, world.taskq.add(& DavidsonSolver::precondition_tile,
+            r.find(ord), d_tile, theta));
+      }
+      return result;
+    }
+
+  public:
+
+    /// Constructor
+
+    /// \param nroots The number of lowest eigenpairs to compute
+    /// \param max_subspace The maximum dimension of the subspace; the
+    /// subspace is collapsed to the current Ritz vectors when it would be
+    /// exceeded. If zero, <tt>8 * nroots</tt> is used.
+    explicit DavidsonSolver(const unsigned int nroots,
+        const unsigned int max_subspace = 0u) :
+      nroots_(nroots), max_subspace_(max_subspace ? max_subspace : 8u * nroots),
+      iterations_(0u)
+    {
+      TA_USER_ASSERT(nroots_ > 0u, "DavidsonSolver: the number of roots must be positive");
+      TA_USER_ASSERT(max_subspace_ >= 2u * nroots_,
+          "DavidsonSolver: the maximum subspace dimension must be at least twice the number of roots");
+    }
+
+    /// Solve the eigenvalue problem
+
+    /// \tparam Sigma The sigma function type, which must implement
+    /// <tt>void operator()(const array_type& x, array_type& result)</tt>;
+    /// \c x is a block of vectors (the first mode indexes the vectors and has a
+    /// single tile) and \c result must be the corresponding block of products
+    /// of the operator with the vectors
+    /// \param sigma The sigma function
+    /// \param guess A block of at least \c nroots guess vectors
+    /// \param diagonal The diagonal of the operator, used as preconditioner;
+    /// it has the tiling of a single vector
+    /// \param convergence_target The target norm of the residual of every root
+    /// \param max_iter The maximum number of iterations
+    /// \return true if all roots converged
+    template <typename Sigma>
+    bool operator()(Sigma& sigma, const array_type& guess,
+        const array_type& diagonal, const double convergence_target = 1e-8,
+        const unsigned int max_iter = 100u)
+    {
+      const unsigned int rank = diagonal.trange().rank();
+      TA_USER_ASSERT(guess.trange().rank() == rank + 1u,
+          "DavidsonSolver: the guess must be a block of vectors");
+      TA_USER_ASSERT(guess.trange().elements_range().extent(0) >= nroots_,
+          "DavidsonSolver: the guess must contain at least nroots vectors");
+
+      vec_vars_ = detail::dummy_annotation(rank);
+      k_vars_ = "k," + vec_vars_;
+      l_vars_ = "l," + vec_vars_;
+      V_.clear();
+      S_.clear();
+      H_.resize(0, 0);
+      iterations_ = 0u;
+
+      array_type block;
+      block(k_vars_) = guess(k_vars_);
+      if(! orthonormalize(block)) return false;
+
+      for(unsigned int iter = 0u; iter < max_iter; ++iter) {
+        iterations_ = iter + 1u;
+
+        // Batched sigma build
+        array_type sigma_block;
+        sigma(block, sigma_block);
+        V_.push_back(block);
+        S_.push_back(sigma_block);
+
+        // Extend the subspace matrix with the new block column
+        const Eigen::Index n_old = H_.rows();
+        std::vector<EigenMatrixX> h_blocks;
+        Eigen::Index n = 0;
+        for(const auto& v : V_) {
+          h_blocks.push_back(gram(v, sigma_block));
+          n += h_blocks.back().rows();
+        }
+        const Eigen::Index nb = h_blocks.back().cols();
+        H_.conservativeResize(n, n);
+        for(Eigen::Index offset = 0, j = 0; j < Eigen::Index(h_blocks.size()); ++j) {
+          H_.block(offset, n_old, h_blocks[j].rows(), nb) = h_blocks[j];
+          H_.block(n_old, offset, nb, h_blocks[j].rows()) = h_blocks[j].transpose();
+          offset += h_blocks[j].rows();
+        }
+
+        // Rayleigh-Ritz
+        Eigen::SelfAdjointEigenSolver<EigenMatrixX> es(
+            0.5 * (H_ + H_.transpose()));
+        const unsigned int nroots = std::min<unsigned int>(nroots_, n);
+        eigenvalues_ = es.eigenvalues().head(nroots);
+        const EigenMatrixX c = es.eigenvectors().leftCols(nroots).transpose();
+
+        // Ritz vectors and their sigma vectors, one contraction per block
+        array_type X, AX;
+        for(Eigen::Index offset = 0, j = 0; j < Eigen::Index(V_.size()); ++j) {
+          const Eigen::Index nj = V_[j].trange().elements_range().extent(0);
+          const array_type c_j = make_matrix(block.world(), c.middleCols(offset, nj));
+          if(j == 0) {
+            X(k_vars_) = c_j("k,l") * V_[j](l_vars_);
+            AX(k_vars_) = c_j("k,l") * S_[j](l_vars_);
+          } else {
+            X(k_vars_) = X(k_vars_) + c_j("k,l") * V_[j](l_vars_);
+            AX(k_vars_) = AX(k_vars_) + c_j("k,l") * S_[j](l_vars_);
+          }
+          offset += nj;
+        }
+        eigenvectors_ = X;
+
+        // Residuals and their norms, the latter in a single pass
+        const array_type theta = make_matrix(block.world(),
+            EigenMatrixX(eigenvalues_.asDiagonal()));
+        array_type R, r_norms;
+        R(k_vars_) = AX(k_vars_) - theta("k,l") * X(l_vars_);
+        r_norms("k") = R(k_vars_).norm(vec_vars_);
+        residual_norms_ = to_eigen(r_norms).col(0);
+
+        // Corrections for the unconverged roots
+        std::vector<element_type> theta_unconverged;
+        std::vector<Eigen::Index> unconverged;
+        for(Eigen::Index k = 0; k < residual_norms_.size(); ++k) {
+          if(residual_norms_(k) >= convergence_target) {
+            unconverged.push_back(k);
+            theta_unconverged.push_back(eigenvalues_(k));
+          }
+        }
+        if(unconverged.empty()) return true;
+
+        EigenMatrixX select = EigenMatrixX::Zero(unconverged.size(), nroots);
+        for(std::size_t k = 0ul; k < unconverged.size(); ++k)
+          select(k, unconverged[k]) = element_type(1);
+        block = precondition(combine(select, R), diagonal, theta_unconverged);
+
+        // Collapse the subspace onto the Ritz vectors
+        if(n + Eigen::Index(unconverged.size()) > Eigen::Index(max_subspace_)) {
+          V_.assign(1, X);
+          S_.assign(1, AX);
+          H_ = eigenvalues_.asDiagonal();
+        }
+
+        if(! orthonormalize(block)) return false;
+      }
+
+      return false;
+    }
+
+    /// \return The Ritz values of the last iteration
+    const EigenVectorX& eigenvalues() const { return eigenvalues_; }
+
+    /// \return The block of Ritz vectors of the last iteration
+    const array_type& eigenvectors() const { return eigenvectors_; }
+
+    /// \return The residual norms of the Ritz vectors of the last iteration
+    const EigenVectorX& residual_norms() const { return residual_norms_; }
+
+    /// \return The number of iterations performed
+    unsigned int iterations() const { return iterations_; }
+
+  }; // class DavidsonSolver
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_ALGEBRA_DAVIDSON_H__INCLUDED
@@ -0,0 +1,207 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  matrix_functions.h
+ *  Dec 2, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_ALGEBRA_MATRIX_FUNCTIONS_H__INCLUDED
+#define TILEDARRAY_ALGEBRA_MATRIX_FUNCTIONS_H__INCLUDED
+
+#include <cmath>
+#include <tuple>
+#include <TiledArray/algebra/utils.h>
+#include "../dist_array.h"
+
+namespace TiledArray {
+
+  /// Convergence diagnostics of a matrix-function iteration
+  struct MatrixFunctionInfo {
+    unsigned int iterations = 0u; ///< The number of iterations performed
+    double error = 0.0;           ///< Frobenius norm of the error matrix of the last iteration
+    double max_error = 0.0;       ///< Largest absolute element of the error matrix of the last iteration
+    bool converged = false;       ///< True if the convergence target was reached
+  }; // struct MatrixFunctionInfo
+
+  namespace detail {
+
+    /// Evaluates the Frobenius norm and the largest absolute element of an
+    /// error matrix in a single pass
+
+    /// \return true if the Frobenius norm is below \c convergence_target
+    template <typename Tile, typename E>
+    bool matrix_function_converged(const E& error_expr,
+        const double convergence_target, MatrixFunctionInfo& info)
+    {
+      const auto errors = error_expr.reduce(
+          std::make_tuple(TiledArray::SquaredNormReduction<Tile>(),
+                          TiledArray::AbsMaxReduction<Tile>())).get();
+      info.error = std::sqrt(double(std::get<0>(errors)));
+      info.max_error = double(std::get<1>(errors));
+      info.converged = (info.error < convergence_target);
+      return info.converged;
+    }
+
+  } // namespace detail
+
+  /// Inverse square root of a Hermitian positive-definite matrix
+
+  /// Computes <tt>S^-1/2</tt> with the coupled Newton-Schulz iteration
+  /// \f[
+  ///   T_k = (3 I - Z_k Y_k) / 2 ,\quad Y_{k+1} = Y_k T_k ,\quad Z_{k+1} = T_k Z_k
+  /// \f]
+  /// starting from <tt>Y_0 = S / |S|</tt>, <tt>Z_0 = I</tt>. The iteration
+  /// uses only matrix products, so for block-sparse arrays the screening of
+  /// the contraction shapes applies within each product; the iterates are
+  /// truncated once per iteration. The Frobenius and max-abs norms of the
+  /// error matrix, <tt>Z Y - I</tt>, are evaluated with a single reduction.
+  /// \tparam Tile The tile type
+  /// \tparam Policy The array policy type
+  /// \param S A Hermitian positive-definite matrix
+  /// \param convergence_target The target Frobenius norm of <tt>Z Y - I</tt>
+  /// \param max_iter The maximum number of iterations
+  /// \param info If not null, receives the convergence diagnostics
+  /// \return <tt>S^-1/2</tt>
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> inverse_sqrt(const DistArray<Tile, Policy>& S,
+      const double convergence_target = 1e-10, const unsigned int max_iter = 100u,
+      MatrixFunctionInfo* info = nullptr)
+  {
+    typedef DistArray<Tile, Policy> array_type;
+
+    MatrixFunctionInfo local_info;
+    MatrixFunctionInfo& result_info = (info ? *info : local_info);
+    result_info = MatrixFunctionInfo();
+
+    // scaling by the Frobenius norm puts the spectrum of Y_0 in (0,1]
+    const double scale = S("i,j").norm().get();
+    TA_USER_ASSERT(scale > 0.0, "inverse_sqrt(): the matrix is zero");
+
+    const array_type I = detail::make_identity(S);
+    array_type Y, Z = I, ZY;
+    Y("i,j") = (1.0 / scale) * S("i,j");
+
+    for(unsigned int iter = 0u; iter < max_iter; ++iter) {
+      ZY("i,j") = Z("i,k") * Y("k,j");
+      result_info.iterations = iter + 1u;
+      if(detail::matrix_function_converged<Tile>(ZY("i,j") - I("i,j"),
+          convergence_target, result_info))
+        break;
+
+      // T = (3 I - Z Y) / 2
+      array_type T;
+      T("i,j") = 1.5 * I("i,j") - 0.5 * ZY("i,j");
+      Y("i,j") = Y("i,k") * T("k,j");
+      Z("i,j") = T("i,k") * Z("k,j");
+      Y.truncate();
+      Z.truncate();
+    }
+
+    Z("i,j") = (1.0 / std::sqrt(scale)) * Z("i,j");
+    return Z;
+  }
+
+  /// Matrix sign function
+
+  /// Computes <tt>sign(A)</tt> of a Hermitian matrix without zero eigenvalues
+  /// with the Newton-Schulz iteration
+  /// <tt>X_{k+1} = X_k (3 I - X_k^2) / 2</tt>, starting from
+  /// <tt>X_0 = A / |A|</tt>. The error matrix is <tt>X^2 - I</tt>.
+  /// \tparam Tile The tile type
+  /// \tparam Policy The array policy type
+  /// \param A A Hermitian matrix
+  /// \param convergence_target The target Frobenius norm of <tt>X^2 - I</tt>
+  /// \param max_iter The maximum number of iterations
+  /// \param info If not null, receives the convergence diagnostics
+  /// \return <tt>sign(A)</tt>
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> matrix_sign(const DistArray<Tile, Policy>& A,
+      const double convergence_target = 1e-10, const unsigned int max_iter = 100u,
+      MatrixFunctionInfo* info = nullptr)
+  {
+    typedef DistArray<Tile, Policy> array_type;
+
+    MatrixFunctionInfo local_info;
+    MatrixFunctionInfo& result_info = (info ? *info : local_info);
+    result_info = MatrixFunctionInfo();
+
+    const double scale = A("i,j").norm().get();
+    TA_USER_ASSERT(scale > 0.0, "matrix_sign(): the matrix is zero");
+
+    const array_type I = detail::make_identity(A);
+    array_type X, X2;
+    X("i,j") = (1.0 / scale) * A("i,j");
+
+    for(unsigned int iter = 0u; iter < max_iter; ++iter) {
+      X2("i,j") = X("i,k") * X("k,j");
+      result_info.iterations = iter + 1u;
+      if(detail::matrix_function_converged<Tile>(X2("i,j") - I("i,j"),
+          convergence_target, result_info))
+        break;
+
+      X("i,j") = 1.5 * X("i,j") - 0.5 * (X("i,k") * X2("k,j"));
+      X.truncate();
+    }
+
+    return X;
+  }
+
+  /// McWeeny purification of a density matrix
+
+  /// Iterates <tt>P_{k+1} = 3 P_k^2 - 2 P_k^3</tt>, which drives the
+  /// eigenvalues of a nearly idempotent matrix to 0 and 1. The error matrix
+  /// is <tt>P^2 - P</tt>.
+  /// \tparam Tile The tile type
+  /// \tparam Policy The array policy type
+  /// \param P A Hermitian matrix with eigenvalues in (-1/2, 3/2)
+  /// \param convergence_target The target Frobenius norm of <tt>P^2 - P</tt>
+  /// \param max_iter The maximum number of iterations
+  /// \param info If not null, receives the convergence diagnostics
+  /// \return The purified matrix
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy> mcweeny_purification(const DistArray<Tile, Policy>& P,
+      const double convergence_target = 1e-10, const unsigned int max_iter = 100u,
+      MatrixFunctionInfo* info = nullptr)
+  {
+    typedef DistArray<Tile, Policy> array_type;
+
+    MatrixFunctionInfo local_info;
+    MatrixFunctionInfo& result_info = (info ? *info : local_info);
+    result_info = MatrixFunctionInfo();
+
+    array_type D = P, D2;
+    for(unsigned int iter = 0u; iter < max_iter; ++iter) {
+      D2("i,j") = D("i,k") * D("k,j");
+      result_info.iterations = iter + 1u;
+      if(detail::matrix_function_converged<Tile>(D2("i,j") - D("i,j"),
+          convergence_target, result_info))
+        break;
+
+      D("i,j") = 3.0 * D2("i,j") - 2.0 * (D2("i,k") * D("k,j"));
+      D.truncate();
+    }
+
+    return D;
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_ALGEBRA_MATRIX_FUNCTIONS_H__INCLUDED
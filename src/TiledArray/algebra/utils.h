@@ -26,6 +26,8 @@
 #ifndef TILEDARRAY_ALGEBRA_UTILS_H__INCLUDED
 #define TILEDARRAY_ALGEBRA_UTILS_H__INCLUDED
 
+#include <array>
+#include <cmath>
 #include <sstream>
 
 #include "../dist_array.h"
@@ -43,6 +45,60 @@ namespace TiledArray {
       return oss.str();
     }
 
+    template <typename Tile>
+    DenseShape identity_shape(const DistArray<Tile, DensePolicy>&) {
+      return DenseShape();
+    }
+
+    /// Shape of the identity matrix with the tiling of a square array
+
+    /// \param a A square array
+    /// \return The shape of the identity matrix with the tiling of \c a
+    template <typename Tile>
+    SparseShape<float> identity_shape(const DistArray<Tile, SparsePolicy>& a) {
+      const auto& tiling = a.trange().data()[0];
+      const std::size_t n = tiling.tile_extent();
+
+      Tensor<float> norms(a.trange().tiles_range(), 0.0f);
+      for(std::size_t i = 0ul; i < n; ++i)
+        norms[i * n + i] =
+            std::sqrt(float(tiling.tile(i).second - tiling.tile(i).first));
+
+      return SparseShape<float>(norms, a.trange());
+    }
+
+    /// Identity matrix with the tiling and process map of a square array
+
+    /// \tparam Tile The tile type
+    /// \tparam Policy The array policy type
+    /// \param a A square array
+    /// \return The identity matrix with the tiling and process map of \c a
+    template <typename Tile, typename Policy>
+    DistArray<Tile, Policy> make_identity(const DistArray<Tile, Policy>& a) {
+      typedef DistArray<Tile, Policy> array_type;
+      typedef typename array_type::value_type value_type;
+      typedef typename array_type::element_type element_type;
+
+      const auto& trange = a.trange();
+      TA_USER_ASSERT((trange.rank() == 2u) && (trange.data()[0] == trange.data()[1]),
+          "make_identity(): the array must be a matrix with identical row and column tilings");
+      const std::size_t n = trange.data()[0].tile_extent();
+
+      array_type result(a.world(), trange, identity_shape(a), a.pmap());
+      for(const auto ord : *result.pmap()) {
+        if(result.is_zero(ord)) continue;
+        value_type tile(trange.make_tile_range(ord), element_type(0));
+        if(ord / n == ord % n) {
+          const auto extent = tile.range().extent(0);
+          for(std::size_t d = 0ul; d < extent; ++d)
+            tile[d * extent + d] = element_type(1);
+        }
+        result.set(ord, tile);
+      }
+
+      return result;
+    }
+
   } // namespace detail
 
   template <typename Tile, typename Policy>
@@ -119,6 +175,55 @@ namespace TiledArray {
     y(vars) = y(vars) + a * x(vars);
   }
 
+  /// Computes <tt> y = x + b * y </tt> in a single pass
+  template <typename Tile, typename Policy>
+  inline void xpby(DistArray<Tile,Policy>& y,
+                   typename DistArray<Tile,Policy>::element_type b,
+                   const DistArray<Tile,Policy>& x) {
+    const std::string vars = detail::dummy_annotation(y.trange().tiles_range().rank());
+    y(vars) = x(vars) + b * y(vars);
+  }
+
+  /// Dot products of the pipelined conjugate gradient solver
+
+  /// Computes <tt> r.u </tt>, <tt> w.u </tt>, and <tt> r.r </tt> from the
+  /// tiles of \c r and a single global reduction, instead of the three
+  /// reductions of separate \c dot_product and \c norm2 calls. Tiles of
+  /// \c u and \c w that are not owned by the owner of the tile of \c r are
+  /// fetched.
+  /// \note This is a collective operation.
+  /// \param r The residual vector
+  /// \param u The preconditioned residual vector
+  /// \param w The product of the operator and \c u
+  /// \return <tt> {r.u, w.u, r.r} </tt>
+  template <typename Tile, typename Policy>
+  inline std::array<typename DistArray<Tile,Policy>::element_type, 3>
+  dot_products(const DistArray<Tile,Policy>& r, const DistArray<Tile,Policy>& u,
+               const DistArray<Tile,Policy>& w) {
+    typedef typename DistArray<Tile,Policy>::element_type value_type;
+    TA_ASSERT(r.trange() == u.trange());
+    TA_ASSERT(r.trange() == w.trange());
+
+    std::array<value_type, 3> result{{value_type(0), value_type(0), value_type(0)}};
+    for(const auto i : *r.pmap()) {
+      // Each product is accumulated over the non-zero tiles of its own pair
+      const bool r_nonzero = ! r.is_zero(i);
+      const bool u_nonzero = ! u.is_zero(i);
+      const Tile u_i = (u_nonzero ? u.find(i).get() : Tile());
+      if(r_nonzero) {
+        const Tile r_i = r.find(i).get();
+        result[2] += squared_norm(r_i);
+        if(u_nonzero)
+          result[0] += dot(r_i, u_i);
+      }
+      if(u_nonzero && ! w.is_zero(i))
+        result[1] += dot(w.find(i).get(), u_i);
+    }
+    r.world().gop.sum(result.data(), result.size());
+
+    return result;
+  }
+
   template <typename Tile, typename Policy>
   inline void assign(DistArray<Tile,Policy>& m1,
                      const DistArray<Tile,Policy>& m2) {
@@ -28,6 +28,7 @@
 
 #include <TiledArray/type_traits.h>
 #include <TiledArray/shape.h>
+#include <TiledArray/utility.h>
 
 /// Forward declarations
 namespace Eigen {
@@ -157,6 +158,29 @@ namespace TiledArray {
             : Future<typename A::value_type>(typename A::value_type()));
       }
 
+      /// Append one tile future of each argument to the chunk of that argument
+      template <typename... Chunks, std::size_t... Is, typename... Tiles>
+      void push_chunk_tiles(std::tuple<Chunks...>& chunks,
+          std::index_sequence<Is...>, Tiles&&... tiles)
+      {
+        int expand[] = {0, (std::get<Is>(chunks).push_back(std::forward<Tiles>(tiles)), 0)...};
+        (void)expand;
+      }
+
+      /// Submit a task that evaluates a chunk of tiles
+      template <typename Task, typename Results, typename Chunk,
+          typename... Chunks, std::size_t... Is>
+      void submit_chunk_task(World& world, const Task& task,
+          const Results& results, Chunk& chunk, std::tuple<Chunks...>& chunks,
+          std::index_sequence<Is...>)
+      {
+        world.taskq.add(task, results, std::move(chunk),
+            std::move(std::get<Is>(chunks))...);
+        chunk.clear();
+        int expand[] = {0, (std::get<Is>(chunks).clear(), 0)...};
+        (void)expand;
+      }
+
     }
 
     /// base implementation of dense TiledArray::foreach
@@ -194,15 +218,66 @@ namespace TiledArray {
         return op_caller(std::forward<Op>(op), arg_tile, arg_tiles...);
       };
 
+      typedef typename arg_array_type::value_type arg_value_type;
+      typedef typename result_array_type::value_type result_value_type;
+      typedef std::vector<Future<result_value_type> > result_chunk_type;
+
+      // Construct the task function for making a chunk of small result tiles.
+      // The result futures are held by a pointer so that they are not treated
+      // as dependencies of the task.
+      auto chunk_task = [task](const std::shared_ptr<result_chunk_type>& results,
+          const std::vector<Future<arg_value_type> >& arg_tiles,
+          const std::vector<Future<ArgTiles> >&... args_tiles) {
+        for(std::size_t n = 0ul; n < results->size(); ++n) {
+          Future<arg_value_type> arg_tile = arg_tiles[n];
+          (*results)[n].set(task(arg_tile.get(), args_tiles[n].get()...));
+        }
+      };
+
+      // Small tiles are coalesced into chunks that are evaluated by a single
+      // task
+      const std::size_t chunk_volume = eval_chunk_volume();
+      auto results = std::make_shared<result_chunk_type>();
+      std::vector<Future<arg_value_type> > arg_chunk;
+      std::tuple<std::vector<Future<ArgTiles> >...> args_chunks;
+      std::size_t chunk_size = 0ul;
+      auto submit_chunk = [&] () {
+        if(! results->empty()) {
+          submit_chunk_task(world, chunk_task, results, arg_chunk, args_chunks,
+              std::index_sequence_for<ArgTiles...>());
+          results = std::make_shared<result_chunk_type>();
+        }
+        chunk_size = 0ul;
+      };
+
       // Iterate over local tiles of arg
       for (auto index: *(arg.pmap())) {
-        // Spawn a task to evaluate the tile
-        Future<typename result_array_type::value_type> tile =
-            world.taskq.add(task, arg.find(index), args.find(index)...);
-
-        // Store result tile
-        result.set(index, tile);
+        const std::size_t volume = (chunk_volume ?
+            arg.trange().make_tile_range(index).volume() : 0ul);
+
+        if(volume && (volume < chunk_volume)) {
+          // Add the tile to the current chunk
+          Future<result_value_type> tile;
+          results->push_back(tile);
+          arg_chunk.push_back(arg.find(index));
+          push_chunk_tiles(args_chunks, std::index_sequence_for<ArgTiles...>(),
+              args.find(index)...);
+          chunk_size += volume;
+          if((chunk_size >= chunk_volume) || (results->size() == eval_chunk_max_tiles))
+            submit_chunk();
+
+          // Store result tile
+          result.set(index, tile);
+        } else {
+          // Spawn a task to evaluate the tile
+          Future<result_value_type> tile =
+              world.taskq.add(task, arg.find(index), args.find(index)...);
+
+          // Store result tile
+          result.set(index, tile);
+        }
       }
+      submit_chunk();
 
       return result;
     }
@@ -181,6 +181,83 @@ namespace TiledArray {
   }
 
 
+  /// Construct sparse Array with estimated tile norms
+
+  /// This function is used to construct a sparse `DistArray` object in two
+  /// phases. First, the shape is constructed from the tile norms returned by
+  /// `norm_op`, which should be a cheap upper bound of the norm of the tile,
+  /// e.g. a Schwarz bound; then `op` is called only for the local tiles that
+  /// are nonzero in the shape. Unlike `make_array(world, trange, pmap, op)`,
+  /// tiles that are screened out are never computed or stored. For example:
+  /// \code
+  /// TiledArray::TSpArray<double> array =
+  ///     make_array<TiledArray::TSpArray<double> >(world, trange, pmap,
+  ///           [=] (const TiledArray::Range& range) -> double {
+  ///             return schwarz_bound(range);
+  ///           },
+  ///           [=] (TiledArray::Tensor<double>& tile, const TiledArray::Range& range) {
+  ///             tile = compute_integrals(range);
+  ///           });
+  /// \endcode
+  /// The expected signatures of the norm and tile operations are:
+  /// \code
+  /// value_t norm_op(const range_t& range);
+  /// void op(tile_t& tile, const range_t& range);
+  /// \endcode
+  /// where `value_t`, `tile_t` and `range_t` are your tile value type, tile
+  /// type, and tile range type, respectively. `norm_op` is called for the
+  /// local tiles by the calling thread, and `op` in tasks.
+  /// \note This is a collective operation.
+  /// \tparam Array The `DistArray` type
+  /// \tparam NormOp Tile norm estimator
+  /// \tparam Op Tile operation
+  /// \param world The world where the array will live
+  /// \param trange The tiled range of the array
+  /// \param pmap A shared pointer to the array process map
+  /// \param norm_op The tile norm estimator
+  /// \param op The tile function/functor
+  /// \return An array object of type `Array`, whose shape is constructed
+  /// from the estimated tile norms
+  template <typename Array, typename NormOp, typename Op,
+      typename std::enable_if<! is_dense<Array>::value>::type* = nullptr>
+  inline Array
+  make_array(World& world, const detail::trange_t<Array>& trange,
+      const std::shared_ptr<detail::pmap_t<Array> >& pmap, NormOp&& norm_op,
+      Op&& op)
+  {
+    typedef typename Array::value_type value_type;
+    typedef typename value_type::range_type range_type;
+
+    // Estimate the norms of the local tiles
+    TiledArray::Tensor<typename detail::shape_t<Array>::value_type,
+        Eigen::aligned_allocator<typename detail::shape_t<Array>::value_type> >
+    tile_norms(trange.tiles_range(), 0);
+    for(const auto index : *pmap)
+      tile_norms[index] = norm_op(trange.make_tile_range(index));
+
+    // Construct the new array
+    Array result(world, trange,
+        typename Array::shape_type(world, tile_norms, trange), pmap);
+
+    // Compute the nonzero local tiles
+    for(const auto index : *pmap) {
+      if(result.is_zero(index))
+        continue;
+
+      auto tile =
+          world.taskq.add([=] (const range_type& range) -> value_type {
+            value_type tile;
+            op(tile, range);
+            return tile;
+          }, trange.make_tile_range(index));
+
+      result.set(index, tile);
+    }
+
+    return result;
+  }
+
+
   /// Construct an Array
 
   /// This function is used to construct a `DistArray` object. Users must
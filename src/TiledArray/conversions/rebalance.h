@@ -0,0 +1,165 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  rebalance.h
+ *  Dec 11, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_CONVERSIONS_REBALANCE_H__INCLUDED
+#define TILEDARRAY_CONVERSIONS_REBALANCE_H__INCLUDED
+
+#include <TiledArray/pmap/table_pmap.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace TiledArray {
+
+  /// Forward declarations
+  template <typename, typename> class DistArray;
+
+  namespace detail {
+
+    /// Balance weighted tiles among processes
+
+    /// Tiles are moved from processes whose load exceeds the mean by more
+    /// than \c tolerance to the least loaded process, heaviest tiles first,
+    /// provided that the receiver stays within the limit. Tiles of processes
+    /// within the limit, and tiles of zero weight, keep their owner. The
+    /// result depends only on the arguments, so all processes compute the
+    /// same table.
+    /// \param owners The current owner of each tile
+    /// \param weights The weight of each tile
+    /// \param nproc The number of processes
+    /// \param tolerance The allowed relative excess of a process load over
+    /// the mean load
+    /// \return The new owner of each tile
+    inline std::vector<std::size_t>
+    balance_tiles(std::vector<std::size_t> owners,
+        const std::vector<std::size_t>& weights, const std::size_t nproc,
+        const double tolerance)
+    {
+      TA_ASSERT(owners.size() == weights.size());
+
+      std::vector<std::size_t> loads(nproc, 0ul);
+      std::vector<std::vector<std::size_t> > tiles(nproc);
+      std::size_t total = 0ul;
+      for(std::size_t tile = 0ul; tile < owners.size(); ++tile) {
+        TA_ASSERT(owners[tile] < nproc);
+        if(weights[tile] == 0ul) continue;
+        loads[owners[tile]] += weights[tile];
+        tiles[owners[tile]].push_back(tile);
+        total += weights[tile];
+      }
+      const double limit = (double(total) / double(nproc)) * (1.0 + tolerance);
+
+      // Processes ordered by load; the first one is the receiver of a move
+      std::set<std::pair<std::size_t, std::size_t> > by_load;
+      for(std::size_t p = 0ul; p < nproc; ++p)
+        by_load.emplace(loads[p], p);
+
+      for(std::size_t p = 0ul; p < nproc; ++p) {
+        if(double(loads[p]) <= limit) continue;
+
+        std::stable_sort(tiles[p].begin(), tiles[p].end(),
+            [&] (const std::size_t l, const std::size_t r)
+            { return weights[l] > weights[r]; });
+
+        for(const std::size_t tile : tiles[p]) {
+          if(double(loads[p]) <= limit) break;
+
+          const std::size_t receiver = by_load.begin()->second;
+          const std::size_t weight = weights[tile];
+          if(double(loads[receiver] + weight) > limit) continue;
+
+          by_load.erase(std::make_pair(loads[p], p));
+          by_load.erase(std::make_pair(loads[receiver], receiver));
+          loads[p] -= weight;
+          loads[receiver] += weight;
+          by_load.emplace(loads[p], p);
+          by_load.emplace(loads[receiver], receiver);
+          owners[tile] = receiver;
+        }
+      }
+
+      return owners;
+    }
+
+  } // namespace detail
+
+  /// Rebalance the tiles of an array among processes
+
+  /// The tiles are weighted by their volume, and zero tiles have no weight.
+  /// If the load of a process exceeds the mean load by more than
+  /// \c tolerance , some of its tiles are moved to the least loaded
+  /// processes; the result is distributed with a \c detail::TablePmap .
+  /// Only the tiles that change owner are sent, point-to-point; the other
+  /// tiles are shared with \c array . This is useful after \c truncate() or a
+  /// sparse \c foreach() , which can leave the nonzero tiles skewed toward a
+  /// few processes.
+  /// \note This is a collective operation.
+  /// \tparam Tile The tile type
+  /// \tparam Policy The policy type
+  /// \param array The array to be rebalanced
+  /// \param tolerance The allowed relative excess of a process load over the
+  /// mean load
+  /// \return An array with the same contents as \c array , or \c array if it
+  /// is already balanced
+  template <typename Tile, typename Policy>
+  DistArray<Tile, Policy>
+  rebalance(const DistArray<Tile, Policy>& array, const double tolerance = 0.1) {
+    typedef DistArray<Tile, Policy> array_type;
+    typedef typename array_type::size_type size_type;
+
+    World& world = array.world();
+    const auto& pmap = array.pmap();
+    if((world.size() == 1) || pmap->is_replicated())
+      return array;
+
+    const size_type n = array.size();
+    std::vector<std::size_t> owners(n), weights(n);
+    for(size_type i = 0ul; i < n; ++i) {
+      owners[i] = pmap->owner(i);
+      weights[i] = (array.is_zero(i) ? 0ul :
+          array.trange().make_tile_range(i).volume());
+    }
+
+    std::vector<std::size_t> balanced =
+        detail::balance_tiles(owners, weights, world.size(), tolerance);
+    if(balanced == owners)
+      return array;
+
+    std::shared_ptr<typename array_type::pmap_interface> balanced_pmap =
+        std::make_shared<detail::TablePmap>(world, std::move(balanced));
+    array_type result(world, array.trange(), array.shape(), balanced_pmap);
+    for(const size_type i : *balanced_pmap) {
+      if(! result.is_zero(i))
+        result.set(i, array.find(i));
+    }
+
+    return result;
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_CONVERSIONS_REBALANCE_H__INCLUDED
@@ -0,0 +1,86 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  subtile_norms.h
+ *  Dec 13, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_CONVERSIONS_SUBTILE_NORMS_H__INCLUDED
+#define TILEDARRAY_CONVERSIONS_SUBTILE_NORMS_H__INCLUDED
+
+#include <TiledArray/subtile_norms.h>
+
+#include <memory>
+
+namespace TiledArray {
+
+  /// Forward declarations
+  template <typename, typename> class DistArray;
+  class SparsePolicy;
+
+  /// Add slice norms to the shape of an array
+
+  /// Computes the norms of \c segments slices of each tile along each mode
+  /// (see \c detail::SubtileNorms ) and attaches them to the shape. The
+  /// shape of a contraction of two such arrays is then bounded by the slice
+  /// norms along a contracted mode instead of the tile norms, so fewer tile
+  /// products survive screening when the large elements of tiles are
+  /// concentrated in a few rows or columns. The slice norms are kept by
+  /// permuted and scaled arrays in expressions, but not by the results of
+  /// expressions.
+  /// \note This is a collective operation. The local tiles of \c array are
+  /// waited for.
+  /// \tparam Tile The tile type
+  /// \param array The array
+  /// \param segments The number of slices per tile and mode
+  /// \return An array that shares the tiles of \c array and has a shape
+  /// with slice norms
+  template <typename Tile>
+  DistArray<Tile, SparsePolicy>
+  add_subtile_norms(const DistArray<Tile, SparsePolicy>& array,
+      const unsigned int segments = 4u)
+  {
+    typedef DistArray<Tile, SparsePolicy> array_type;
+    typedef typename array_type::shape_type::value_type value_type;
+
+    World& world = array.world();
+    std::shared_ptr<detail::SubtileNorms<value_type> > subtile_norms =
+        std::make_shared<detail::SubtileNorms<value_type> >(
+            array.trange().tiles_range(), segments);
+    for(const auto i : *array.pmap()) {
+      if(! array.is_zero(i))
+        subtile_norms->accumulate(i, array.find(i).get());
+    }
+    subtile_norms->finalize(world);
+
+    array_type result(world, array.trange(),
+        array.shape().subtile(subtile_norms), array.pmap());
+    for(const auto i : *array.pmap()) {
+      if(! result.is_zero(i))
+        result.set(i, array.find(i));
+    }
+
+    return result;
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_CONVERSIONS_SUBTILE_NORMS_H__INCLUDED
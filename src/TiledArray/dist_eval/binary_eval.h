@@ -21,8 +21,12 @@
 #define TILEDARRAY_DIST_EVAL_BINARY_EVAL_H__INCLUDED
 
 #include <TiledArray/dist_eval/dist_eval.h>
+#include <TiledArray/dist_eval/work_stealing.h>
 #include <TiledArray/zero_tensor.h>
 
+#include <deque>
+#include <mutex>
+
 namespace TiledArray {
   namespace detail {
 
@@ -62,6 +66,16 @@ namespace TiledArray {
       right_type right_; ///< Right argument
       op_type op_; ///< binary element operator
 
+      // Task function argument types
+      typedef typename std::conditional<op_type::left_is_consumable,
+                typename left_type::value_type,
+          const typename left_type::value_type>::type &
+              left_argument_type;
+      typedef typename std::conditional<op_type::right_is_consumable,
+                typename right_type::value_type,
+          const typename right_type::value_type>::type &
+              right_argument_type;
+
     public:
 
       /// Construct a binary evaluator
@@ -114,6 +128,157 @@ namespace TiledArray {
 
     private:
 
+      /// The tile tasks of this evaluator that may be stolen by other ranks
+
+      /// A job is run by whichever comes first: the local task, once its
+      /// arguments are ready, or a thief. The \c claimed flag of the job
+      /// decides which; the other one does nothing.
+      class StealableTiles : public WorkStealer {
+      public:
+        /// A tile task
+        struct Job {
+          Job(const size_type i, const Future<typename left_type::value_type>& l,
+              const Future<typename right_type::value_type>& r) :
+            index(i), left(l), right(r), claimed(false)
+          { }
+
+          const size_type index; ///< The target tile index
+          Future<typename left_type::value_type> left; ///< The left-hand tile
+          Future<typename right_type::value_type> right; ///< The right-hand tile
+          std::atomic<bool> claimed; ///< Set by the local task or a thief that runs the job
+        }; // struct Job
+
+      private:
+        // Lazy argument tiles are evaluated before they are sent to a thief
+        typedef typename eval_trait<typename left_type::value_type>::type left_eval_type;
+        typedef typename eval_trait<typename right_type::value_type>::type right_eval_type;
+
+        std::shared_ptr<BinaryEvalImpl_> impl_; ///< The evaluator
+        std::deque<Job> jobs_; ///< The jobs; element addresses are stable
+        std::size_t end_; ///< The jobs after this position are claimed
+        std::mutex mutex_; ///< Guards \c jobs_ and \c end_
+
+      public:
+
+        /// Constructor
+
+        /// \param impl The evaluator
+        StealableTiles(const std::shared_ptr<BinaryEvalImpl_>& impl) :
+          WorkStealer(impl->world(), impl->id()), impl_(impl), jobs_(), end_(0ul)
+        { }
+
+        /// Add a job
+
+        /// \param index The target tile index
+        /// \param left The left-hand tile
+        /// \param right The right-hand tile
+        /// \return A pointer to the new job
+        Job* add(const size_type index,
+            const Future<typename left_type::value_type>& left,
+            const Future<typename right_type::value_type>& right)
+        {
+          WorkStealer::add_job();
+          std::lock_guard<std::mutex> lock(mutex_);
+          jobs_.emplace_back(index, left, right);
+          end_ = jobs_.size();
+          return & jobs_.back();
+        }
+
+        /// Claim a job
+
+        /// \param job The job
+        /// \return \c true if the caller is the first to claim \c job
+        static bool claim(Job& job) { return ! job.claimed.exchange(true); }
+
+        /// Release the argument tiles of a job that is done
+
+        /// \param job The job
+        void release(Job& job) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          job.left = Future<typename left_type::value_type>();
+          job.right = Future<typename right_type::value_type>();
+        }
+
+        /// Send a job whose arguments are ready to a thief
+
+        /// The most recently added jobs are given away first, since they are
+        /// the last ones that would run locally.
+        /// \param thief The rank that asked for work
+        /// \return \c true if a job was sent
+        virtual bool send_job(const ProcessID thief) {
+          Job* job = nullptr;
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for(; end_ > 0ul; --end_) {
+              Job& last = jobs_[end_ - 1ul];
+              if(! last.claimed.load())
+                break;
+            }
+            for(std::size_t n = end_; n > 0ul; --n) {
+              Job& candidate = jobs_[n - 1ul];
+              if(candidate.claimed.load() || ! candidate.left.probe() ||
+                  ! candidate.right.probe())
+                continue;
+              if(claim(candidate)) {
+                job = & candidate;
+                break;
+              }
+            }
+          }
+          if(! job)
+            return false;
+
+          WorkStealer::world().taskq.add(thief, & StealableTiles::run_stolen,
+              WorkStealer::id(), job->index,
+              static_cast<left_eval_type>(job->left.get()),
+              static_cast<right_eval_type>(job->right.get()),
+              madness::TaskAttributes::hipri());
+          release(*job);
+
+          // The thief sends the result tile to its owner
+          impl_->notify();
+          WorkStealer::job_done();
+          return true;
+        }
+
+        /// Task function that runs a stolen job on the thief
+
+        /// \param id The id of the evaluator
+        /// \param index The target tile index
+        /// \param left The left-hand tile
+        /// \param right The right-hand tile
+        static void run_stolen(const madness::uniqueidT id, const size_type index,
+            left_eval_type left, right_eval_type right)
+        {
+          std::shared_ptr<WorkStealer> stealer = WorkStealer::find(id);
+          TA_ASSERT(stealer);
+          BinaryEvalImpl_& impl = *static_cast<StealableTiles&>(*stealer).impl_;
+
+          // The argument tiles are private copies, so they may be consumed
+          impl.world().gop.send(impl.owner(index), madness::DistributedID(id, index),
+              value_type(impl.op_(left, right)));
+          stealer->steal_succeeded();
+        }
+
+      }; // class StealableTiles
+
+      /// Task function for evaluating a tile that may be stolen
+
+      /// \param tiles The stealable tiles of this evaluator
+      /// \param job The job of the tile
+      /// \param left The left-hand tile
+      /// \param right The right-hand tile
+      void eval_job(const std::shared_ptr<StealableTiles>& tiles,
+          typename StealableTiles::Job* job, left_argument_type left,
+          right_argument_type right)
+      {
+        if(! StealableTiles::claim(*job))
+          return;  // the job was sent to another rank
+        DistEvalImpl_::set_tile(job->index, op_(left, right));
+        tiles->release(*job);
+        tiles->job_done();
+      }
+
       /// Task function for evaluating tiles
 
 #ifdef TILEDARRAY_HAS_CUDA
@@ -145,6 +310,34 @@ namespace TiledArray {
         DistEvalImpl_::set_tile(i, op_(left, right));
       }
 #endif
+
+      /// Task function for evaluating a chunk of small tiles
+
+      /// \param indices The tile indices
+      /// \param left The left-hand tiles
+      /// \param right The right-hand tiles
+      void eval_tiles(const std::vector<size_type>& indices,
+          const std::vector<Future<typename left_type::value_type> >& left,
+          const std::vector<Future<typename right_type::value_type> >& right)
+      {
+        for(std::size_t n = 0ul; n < indices.size(); ++n) {
+          Future<typename left_type::value_type> left_tile = left[n];
+          Future<typename right_type::value_type> right_tile = right[n];
+          DistEvalImpl_::set_tile(indices[n],
+              op_(static_cast<left_argument_type>(left_tile.get()),
+                  static_cast<right_argument_type>(right_tile.get())));
+        }
+      }
+
+      /// \return \c true if the tiles of this tensor may be evaluated in chunks
+      static constexpr bool coalesce_tiles() {
+#ifdef TILEDARRAY_HAS_CUDA
+        return ! detail::is_cuda_tile<value_type>::value;
+#else
+        return true;
+#endif
+      }
+
       /// Evaluate the tiles of this tensor
 
       /// This function will evaluate the children of this distributed evaluator
@@ -158,16 +351,6 @@ namespace TiledArray {
         left_.eval();
         right_.eval();
 
-        // Task function argument types
-        typedef typename std::conditional<op_type::left_is_consumable,
-                  typename left_type::value_type,
-            const typename left_type::value_type>::type &
-                left_argument_type;
-        typedef typename std::conditional<op_type::right_is_consumable,
-                  typename right_type::value_type,
-            const typename right_type::value_type>::type &
-                right_argument_type;
-
         size_type task_count = 0ul;
 
         // Construct local iterator
@@ -176,6 +359,59 @@ namespace TiledArray {
         typename pmap_interface::const_iterator it = left_.pmap()->begin();
         const typename pmap_interface::const_iterator end = left_.pmap()->end();
 
+        // With work stealing, tiles where both arguments are nonzero are
+        // evaluated by jobs that idle ranks may take over
+        std::shared_ptr<StealableTiles> stealable;
+        if(coalesce_tiles() && work_stealing() && (TensorImpl_::world().size() > 1)) {
+          stealable = std::make_shared<StealableTiles>(self);
+          WorkStealer::enroll(stealable);
+        }
+
+        // Otherwise, small tiles where both arguments are nonzero are coalesced
+        // into chunks that are evaluated by a single task
+        const size_type chunk_volume =
+            (coalesce_tiles() && ! stealable ? eval_chunk_volume() : 0ul);
+        std::vector<size_type> chunk_indices;
+        std::vector<Future<typename left_type::value_type> > chunk_left;
+        std::vector<Future<typename right_type::value_type> > chunk_right;
+        size_type chunk_size = 0ul;
+        auto submit_chunk = [&] () {
+          if(! chunk_indices.empty())
+            TensorImpl_::world().taskq.add(self, & BinaryEvalImpl_::eval_tiles,
+                std::move(chunk_indices), std::move(chunk_left),
+                std::move(chunk_right));
+          chunk_indices.clear();
+          chunk_left.clear();
+          chunk_right.clear();
+          chunk_size = 0ul;
+        };
+        auto schedule = [&] (const size_type source_index, const size_type target_index) {
+          if(stealable) {
+            Future<typename left_type::value_type> left = left_.get(source_index);
+            Future<typename right_type::value_type> right = right_.get(source_index);
+            TensorImpl_::world().taskq.add(self, & BinaryEvalImpl_::eval_job,
+                stealable, stealable->add(target_index, left, right), left, right);
+            return;
+          }
+
+          const size_type volume = (chunk_volume ?
+              TensorImpl_::trange().make_tile_range(target_index).volume() : 0ul);
+          if(volume && (volume < chunk_volume)) {
+            // Add the tile to the current chunk
+            chunk_indices.push_back(target_index);
+            chunk_left.push_back(left_.get(source_index));
+            chunk_right.push_back(right_.get(source_index));
+            chunk_size += volume;
+            if((chunk_size >= chunk_volume) || (chunk_indices.size() == eval_chunk_max_tiles))
+              submit_chunk();
+          } else {
+            // Schedule tile evaluation task
+            TensorImpl_::world().taskq.add(self,
+                & BinaryEvalImpl_::template eval_tile<left_argument_type, right_argument_type>,
+                target_index, left_.get(source_index), right_.get(source_index));
+          }
+        };
+
         if(left_.is_dense() && right_.is_dense() && TensorImpl_::is_dense()) {
           // Evaluate tiles where both arguments and the result are dense
           for(; it != end; ++it) {
@@ -183,10 +419,7 @@ namespace TiledArray {
             const size_type source_index = *it;
             const size_type target_index = DistEvalImpl_::perm_index_to_target(source_index);
 
-            // Schedule tile evaluation task
-            TensorImpl_::world().taskq.add(self,
-                & BinaryEvalImpl_::template eval_tile<left_argument_type, right_argument_type>,
-                target_index, left_.get(source_index), right_.get(source_index));
+            schedule(source_index, target_index);
 
             ++task_count;
           }
@@ -208,9 +441,7 @@ namespace TiledArray {
                   & BinaryEvalImpl_::template eval_tile<left_argument_type, const ZeroTensor>,
                   target_index, left_.get(index), ZeroTensor());
               } else {
-                TensorImpl_::world().taskq.add(self,
-                  & BinaryEvalImpl_::template eval_tile<left_argument_type, right_argument_type>,
-                  target_index, left_.get(index), right_.get(index));
+                schedule(index, target_index);
               }
 
               ++task_count;
@@ -224,6 +455,10 @@ namespace TiledArray {
           }
         }
 
+        submit_chunk();
+        if(stealable)
+          stealable->job_done();
+
         // Wait for child tensors to be evaluated, and process tasks while waiting.
         left_.wait();
         right_.wait();
@@ -24,6 +24,7 @@
 
 #include <TiledArray/config.h>
 #include <TiledArray/dist_eval/dist_eval.h>
+#include <TiledArray/memory_usage.h>
 #include <TiledArray/proc_grid.h>
 #include <TiledArray/reduce_task.h>
 #include <TiledArray/type_traits.h>
@@ -72,6 +73,7 @@ namespace TiledArray {
     private:
       static size_type max_memory_; ///< Maximum memory used per node
       static size_type max_depth_; ///< Maximum number of concurrent SUMMA iterations
+      static bool in_place_reduce_; ///< Accumulate the contributions to each result tile in place
 
       // Arguments and operation
       left_type left_; ///< The left-hand argument
@@ -126,29 +128,7 @@ namespace TiledArray {
         const char* max_memory = getenv("TA_SUMMA_MAX_MEMORY");
         if(max_memory) {
             // Convert the string into bytes
-            std::stringstream ss(max_memory);
-            double memory = 0.0;
-            if(ss >> memory) {
-                if(memory > 0.0) {
-                    std::string unit;
-                    if(ss >> unit) { // Failure == assume bytes
-                        if(unit == "KB" || unit == "kB") {
-                          memory *= 1000.0;
-                        } else if(unit == "KiB" || unit == "kiB") {
-                          memory *= 1024.0;
-                        } else if(unit == "MB") {
-                          memory *= 1000000.0;
-                        } else if(unit == "MiB") {
-                          memory *= 1048576.0;
-                        } else if(unit == "GB") {
-                          memory *= 1000000000.0;
-                        } else if(unit == "GiB") {
-                          memory *= 1073741824.0;
-                        }
-                    }
-                }
-            }
-
+            double memory = detail::parse_memory_size(max_memory);
             memory = std::max(memory, 104857600.0); // Minimum 100 MiB
             return memory;
         }
@@ -165,6 +145,20 @@ namespace TiledArray {
       }
 
 
+      /// Initialize the in-place reduction flag for SUMMA
+
+      /// If \c TA_SUMMA_INPLACE_REDUCE is set to a nonzero value, the
+      /// contributions to each result tile are accumulated, one at a time,
+      /// into a single tile instead of into concurrent partial results. This
+      /// reduces the peak memory of deep SUMMA iterations.
+      static bool init_in_place_reduce() {
+        const char* in_place_reduce = getenv("TA_SUMMA_INPLACE_REDUCE");
+        if(in_place_reduce)
+          return std::stoul(in_place_reduce) != 0ul;
+        return false;
+      }
+
+
       // Process groups --------------------------------------------------------
 
       /// Process group factory function
@@ -612,8 +606,9 @@ namespace TiledArray {
 
       ProcessID get_row_group_root(const size_type k, const madness::Group& row_group) const {
         ProcessID group_root = k % proc_grid_.proc_cols();
-        if(! right_.shape().is_dense() && row_group.size() < static_cast<ProcessID>(proc_grid_.proc_cols())) {
-          const ProcessID world_root = proc_grid_.rank_row() * proc_grid_.proc_cols() + group_root;
+        if((! right_.shape().is_dense() && row_group.size() < static_cast<ProcessID>(proc_grid_.proc_cols()))
+            || proc_grid_.is_reordered()) {
+          const ProcessID world_root = proc_grid_.map_col(group_root);
           group_root = row_group.rank(world_root);
         }
         return group_root;
@@ -621,8 +616,9 @@ namespace TiledArray {
 
       ProcessID get_col_group_root(const size_type k, const madness::Group& col_group) const {
         ProcessID group_root = k % proc_grid_.proc_rows();
-        if(! left_.shape().is_dense() && col_group.size() < static_cast<ProcessID>(proc_grid_.proc_rows())) {
-          const ProcessID world_root = group_root * proc_grid_.proc_cols() + proc_grid_.rank_col();
+        if((! left_.shape().is_dense() && col_group.size() < static_cast<ProcessID>(proc_grid_.proc_rows()))
+            || proc_grid_.is_reordered()) {
+          const ProcessID world_root = proc_grid_.map_row(group_root);
           group_root = col_group.rank(world_root);
         }
         return group_root;
@@ -881,7 +877,8 @@ namespace TiledArray {
         for(size_type t = 0ul; t < n; ++t) {
           // Initialize the reduction task
           ReducePairTask<op_type>* MADNESS_RESTRICT const reduce_task = reduce_tasks_ + t;
-          new(reduce_task) ReducePairTask<op_type>(TensorImpl_::world(), op_);
+          new(reduce_task) ReducePairTask<op_type>(TensorImpl_::world(), op_,
+              nullptr, in_place_reduce_);
         }
 
         return proc_grid_.local_size();
@@ -927,7 +924,8 @@ namespace TiledArray {
               ss << index << " ";
 #endif // TILEDARRAY_ENABLE_SUMMA_TRACE_INITIALIZE
 
-              new(reduce_task) ReducePairTask<op_type>(TensorImpl_::world(), op_);
+              new(reduce_task) ReducePairTask<op_type>(TensorImpl_::world(), op_,
+                  nullptr, in_place_reduce_);
               ++tile_count;
             } else {
               // Construct an empty task to represent zero tiles.
@@ -1177,7 +1175,7 @@ namespace TiledArray {
           row_shape_values.push_back(right_.shape()[row_start + (row[j].first * right_stride_local_)]);
 
         const size_type col_start = left_start_local_ + k;
-        const float threshold_k = TensorImpl_::shape().threshold() / typename SparseShape<T>::value_type(k_);
+        const float threshold_k = TensorImpl_::shape().screening_threshold() / typename SparseShape<T>::value_type(k_);
         // Iterate over the row
         for(size_type i = 0ul; i != col.size(); ++i) {
           // Compute the local, result-tile offset
@@ -1543,7 +1541,7 @@ namespace TiledArray {
         const size_type proc_row = tile_row % proc_grid_.proc_rows();
         const size_type proc_col = tile_col % proc_grid_.proc_cols();
         // Compute the process that owns tile
-        const ProcessID source = proc_row * proc_grid_.proc_cols() + proc_col;
+        const ProcessID source = proc_grid_.map_proc(proc_row, proc_col);
 
         const madness::DistributedID key(DistEvalImpl_::id(), i);
         return TensorImpl_::world().gop.template recv<value_type>(source, key);
@@ -1569,9 +1567,11 @@ namespace TiledArray {
       /// is less than 1.
       size_type mem_bound_depth(size_type depth, const float left_sparsity, const float right_sparsity) {
 
-        // Check if a memory bound has been set
-        const size_type available_memory = max_memory_;
-        if(available_memory) {
+        // Check if a memory bound has been set; without an explicit SUMMA
+        // bound, the broadcast tiles must fit in the unused memory budget
+        const bool budget = (max_memory_ == 0ul) && (memory_budget() != 0ul);
+        const size_type available_memory = (budget ? memory_available() : max_memory_);
+        if(max_memory_ || budget) {
 
           // Compute the average memory requirement per iteration of this process
           const std::size_t local_memory_per_iter_left =
@@ -1584,9 +1584,8 @@ namespace TiledArray {
               proc_grid_.local_cols() * (1.0f - right_sparsity);
 
           // Compute the maximum number of iterations based on available memory
-          const size_type mem_bound_depth =
-              ((local_memory_per_iter_left + local_memory_per_iter_right) /
-              available_memory);
+          const size_type mem_bound_depth = available_memory /
+              std::max<std::size_t>(local_memory_per_iter_left + local_memory_per_iter_right, 1ul);
 
           // Check if the memory bounded depth is less than the optimal depth
           if(depth > mem_bound_depth) {
@@ -1595,7 +1594,12 @@ namespace TiledArray {
             switch(mem_bound_depth) {
               case 0:
                 // When memory bound depth is
-                TA_EXCEPTION("Insufficient memory available for SUMMA");
+                if(! budget)
+                  TA_EXCEPTION("Insufficient memory available for SUMMA");
+
+                // The memory budget is exhausted; throttle to one iteration
+                // at a time rather than fail
+                depth = 1ul;
                 break;
               case 1:
                 if(TensorImpl_::world().rank() == 0)
@@ -1718,6 +1722,10 @@ namespace TiledArray {
     typename Summa<Left, Right, Op, Policy>::size_type
     Summa<Left, Right, Op, Policy>::max_memory_ =
         Summa<Left, Right, Op, Policy>::init_max_memory();
+
+    template <typename Left, typename Right, typename Op, typename Policy>
+    bool Summa<Left, Right, Op, Policy>::in_place_reduce_ =
+        Summa<Left, Right, Op, Policy>::init_in_place_reduce();
   } // namespace detail
 }  // namespace TiledArray
 
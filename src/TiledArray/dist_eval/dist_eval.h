@@ -24,6 +24,7 @@
 #include <TiledArray/permutation.h>
 #include <TiledArray/perm_index.h>
 #include <TiledArray/type_traits.h>
+#include <TiledArray/utility.h>
 #include <TiledArray/config.h>
 #ifdef TILEDARRAY_HAS_CUDA
 #include <TiledArray/external/cuda.h>
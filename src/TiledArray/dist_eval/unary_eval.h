@@ -130,6 +130,30 @@ namespace TiledArray {
         DistEvalImpl_::set_tile(i, op_(tile));
       }
 #endif
+
+      /// Task function for evaluating a chunk of small tiles
+
+      /// \param indices The tile indices
+      /// \param tiles The tiles to be evaluated
+      void eval_tiles(const std::vector<size_type>& indices,
+          const std::vector<Future<typename arg_type::value_type> >& tiles)
+      {
+        for(std::size_t n = 0ul; n < indices.size(); ++n) {
+          Future<typename arg_type::value_type> tile = tiles[n];
+          DistEvalImpl_::set_tile(indices[n],
+              op_(static_cast<tile_argument_type>(tile.get())));
+        }
+      }
+
+      /// \return \c true if the tiles of this tensor may be evaluated in chunks
+      static constexpr bool coalesce_tiles() {
+#ifdef TILEDARRAY_HAS_CUDA
+        return ! detail::is_cuda_tile<value_type>::value;
+#else
+        return true;
+#endif
+      }
+
       /// Evaluate the tiles of this tensor
 
       /// This function will evaluate the children of this distributed evaluator
@@ -148,6 +172,21 @@ namespace TiledArray {
         // Counter for the number of tasks submitted by this object
         size_type task_count = 0ul;
 
+        // Small tiles are coalesced into chunks that are evaluated by a
+        // single task
+        const size_type chunk_volume = (coalesce_tiles() ? eval_chunk_volume() : 0ul);
+        std::vector<size_type> chunk_indices;
+        std::vector<Future<typename arg_type::value_type> > chunk_tiles;
+        size_type chunk_size = 0ul;
+        auto submit_chunk = [&] () {
+          if(! chunk_indices.empty())
+            TensorImpl_::world().taskq.add(self, & UnaryEvalImpl_::eval_tiles,
+                std::move(chunk_indices), std::move(chunk_tiles));
+          chunk_indices.clear();
+          chunk_tiles.clear();
+          chunk_size = 0ul;
+        };
+
         // Make sure all local tiles are present.
         const typename pmap_interface::const_iterator end = arg_.pmap()->end();
         typename pmap_interface::const_iterator it = arg_.pmap()->begin();
@@ -158,19 +197,31 @@ namespace TiledArray {
           if(! arg_.is_zero(index)) {
             // Get target tile index
             const size_type target_index = DistEvalImpl_::perm_index_to_target(index);
-
-            // Schedule tile evaluation task
+            const size_type volume = (chunk_volume ?
+                TensorImpl_::trange().make_tile_range(target_index).volume() : 0ul);
+
+            if(volume && (volume < chunk_volume)) {
+              // Add the tile to the current chunk
+              chunk_indices.push_back(target_index);
+              chunk_tiles.push_back(arg_.get(index));
+              chunk_size += volume;
+              if((chunk_size >= chunk_volume) || (chunk_indices.size() == eval_chunk_max_tiles))
+                submit_chunk();
+            } else {
+              // Schedule tile evaluation task
 #ifdef TILEDARRAY_HAS_CUDA
-            TensorImpl_::world().taskq.add(self, & UnaryEvalImpl_::template eval_tile<>,
-                                           target_index, arg_.get(index));
+              TensorImpl_::world().taskq.add(self, & UnaryEvalImpl_::template eval_tile<>,
+                                             target_index, arg_.get(index));
 #else
-            TensorImpl_::world().taskq.add(self, & UnaryEvalImpl_::eval_tile,
-                target_index, arg_.get(index));
+              TensorImpl_::world().taskq.add(self, & UnaryEvalImpl_::eval_tile,
+                  target_index, arg_.get(index));
 #endif
+            }
 
             ++task_count;
           }
         }
+        submit_chunk();
 
         // Wait for local tiles of argument to be evaluated
         arg_.wait();
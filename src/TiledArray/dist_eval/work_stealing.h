@@ -0,0 +1,254 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  work_stealing.h
+ *  Dec 11, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_DIST_EVAL_WORK_STEALING_H__INCLUDED
+#define TILEDARRAY_DIST_EVAL_WORK_STEALING_H__INCLUDED
+
+#include <TiledArray/external/madness.h>
+#include <TiledArray/error.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace TiledArray {
+  namespace detail {
+
+    inline bool& work_stealing_accessor() {
+      static bool enabled = [] () {
+        const char* value = std::getenv("TA_WORK_STEALING");
+        return (value != nullptr) && (std::atoi(value) != 0);
+      }();
+      return enabled;
+    }
+
+    inline std::atomic<std::size_t>& work_stealing_count_accessor() {
+      static std::atomic<std::size_t> count{0ul};
+      return count;
+    }
+
+    /// The maximum number of ranks an idle rank asks for work, per evaluator
+    constexpr ProcessID work_stealing_max_victims = 16;
+
+    /// Distributed work stealing for the tile tasks of an evaluator
+
+    /// Each rank holds one \c WorkStealer per evaluator that takes part in
+    /// work stealing; the stealers of the same evaluator on different ranks
+    /// are matched by the (globally unique) evaluator id. A stealer acts as a
+    /// victim, i.e. it hands tile tasks whose arguments are ready but that
+    /// have not started to other ranks, until its rank has no more local
+    /// work. It then acts as a thief: it asks the other ranks, one at a time,
+    /// for work until a fixed number of them has none left, and withdraws.
+    ///
+    /// Derived classes own the tile tasks; they implement \c send_job() ,
+    /// which must ship a task to the thief and call \c job_done() , and run
+    /// the stolen tasks, after which they call \c steal_succeeded() .
+    class WorkStealer {
+      World& world_; ///< The world of the evaluator
+      const madness::uniqueidT id_; ///< The id of the evaluator
+      std::atomic<std::size_t> pending_; ///< The number of local jobs that are not done, + 1 until all are added
+      ProcessID victim_; ///< The rank that is asked for work
+      ProcessID failures_; ///< The number of consecutive ranks that had no work
+
+      typedef std::pair<std::size_t, std::size_t> key_type;
+      typedef std::map<key_type, std::shared_ptr<WorkStealer> > registry_type;
+
+      static std::mutex& registry_mutex() {
+        static std::mutex mutex;
+        return mutex;
+      }
+
+      static registry_type& registry() {
+        static registry_type reg;
+        return reg;
+      }
+
+      static key_type make_key(const madness::uniqueidT& id) {
+        return key_type(id.get_world_id(), id.get_obj_id());
+      }
+
+      /// Remove a stealer from the registry
+
+      /// The stealer may be destroyed by this call, so it must be the last
+      /// use of \c this by the caller.
+      void withdraw() {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry().erase(make_key(id_));
+      }
+
+      /// Ask \c victim_ for a job
+      void request();
+
+      /// Start asking the other ranks for work
+      void steal() {
+        const ProcessID nproc = world_.size();
+        if(nproc == 1) {
+          withdraw();
+          return;
+        }
+        victim_ = (world_.rank() + 1) % nproc;
+        failures_ = 0;
+        request();
+      }
+
+    protected:
+
+      /// Constructor
+
+      /// \param world The world of the evaluator
+      /// \param id The id of the evaluator
+      WorkStealer(World& world, const madness::uniqueidT& id) :
+        world_(world), id_(id), pending_(1ul), victim_(0), failures_(0)
+      { }
+
+    public:
+
+      virtual ~WorkStealer() { }
+
+      /// Register a stealer
+
+      /// The registry owns the stealer until it withdraws, i.e. until its rank
+      /// is done with stealing work from the other ranks.
+      /// \param stealer The stealer to be registered
+      static void enroll(const std::shared_ptr<WorkStealer>& stealer) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry()[make_key(stealer->id_)] = stealer;
+      }
+
+      /// Find the stealer of an evaluator
+
+      /// \param id The id of the evaluator
+      /// \return The stealer of the evaluator, or a null pointer if it is not
+      /// (or no longer) registered on this rank
+      static std::shared_ptr<WorkStealer> find(const madness::uniqueidT& id) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry_type::const_iterator it = registry().find(make_key(id));
+        return (it != registry().end() ? it->second : std::shared_ptr<WorkStealer>());
+      }
+
+      /// \return The world of the evaluator
+      World& world() const { return world_; }
+
+      /// \return The id of the evaluator
+      const madness::uniqueidT& id() const { return id_; }
+
+      /// Record a local job
+      void add_job() { ++pending_; }
+
+      /// Record the completion of a local job, or that all jobs were added
+
+      /// When the last local job is done this rank starts stealing work.
+      void job_done() {
+        if(--pending_ == 0ul)
+          steal();
+      }
+
+      /// Send a job to a thief
+
+      /// \param thief The rank that asked for work
+      /// \return \c true if a job was sent
+      virtual bool send_job(const ProcessID thief) = 0;
+
+      /// The victim sent a job; ask it for the next one
+      void steal_succeeded() {
+        ++work_stealing_count_accessor();
+        request();
+      }
+
+      /// The victim had no job; ask the next rank or withdraw
+      void steal_failed() {
+        const ProcessID nproc = world_.size();
+        if(++failures_ == std::min(nproc - 1, work_stealing_max_victims)) {
+          withdraw();
+          return;
+        }
+        victim_ = (victim_ + 1) % nproc;
+        if(victim_ == world_.rank())
+          victim_ = (victim_ + 1) % nproc;
+        request();
+      }
+
+    }; // class WorkStealer
+
+    /// Task function that reports a failed steal attempt to a thief
+
+    /// \param id The id of the evaluator
+    inline void work_stealing_none(const madness::uniqueidT id) {
+      std::shared_ptr<WorkStealer> stealer = WorkStealer::find(id);
+      TA_ASSERT(stealer);
+      stealer->steal_failed();
+    }
+
+    /// Task function that handles a request for work on the victim
+
+    /// \param id The id of the evaluator
+    /// \param thief The rank that asked for work
+    inline void work_stealing_request(const madness::uniqueidT id, const ProcessID thief) {
+      std::shared_ptr<WorkStealer> stealer = WorkStealer::find(id);
+      if(stealer && stealer->send_job(thief))
+        return;
+
+      World* world = World::world_from_id(id.get_world_id());
+      TA_ASSERT(world);
+      world->taskq.add(thief, & work_stealing_none, id, madness::TaskAttributes::hipri());
+    }
+
+    inline void WorkStealer::request() {
+      world_.taskq.add(victim_, & work_stealing_request, id_, world_.rank(),
+          madness::TaskAttributes::hipri());
+    }
+
+  } // namespace detail
+
+  /// Enable or disable distributed work stealing
+
+  /// With work stealing enabled, a rank that has evaluated all of its tiles
+  /// of an element-wise expression takes tile tasks whose arguments are ready
+  /// from the other ranks; the argument tiles are sent to it and the result
+  /// tile is sent to its owner. It helps when the work of the ranks is
+  /// unbalanced, e.g. for irregular sparsity, at the cost of additional
+  /// messages. This is a collective setting: it must have the same value on
+  /// all ranks when an expression is evaluated. The initial value is read
+  /// from the \c TA_WORK_STEALING environment variable [ default = 0 ].
+  /// \param enable \c true to enable work stealing
+  inline void set_work_stealing(const bool enable) {
+    detail::work_stealing_accessor() = enable;
+  }
+
+  /// \return \c true if distributed work stealing is enabled
+  inline bool work_stealing() { return detail::work_stealing_accessor(); }
+
+  /// \return The number of tile tasks this rank has stolen from other ranks
+  inline std::size_t work_stealing_count() {
+    return detail::work_stealing_count_accessor().load();
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_DIST_EVAL_WORK_STEALING_H__INCLUDED
@@ -150,6 +150,7 @@ namespace TiledArray {
       /// for the left-hand, right-hand, and result tensor.
       /// \param target_vars The target variable list for the result tensor
       void init_struct(const VariableList& target_vars) {
+        ShapeThresholdScope threshold_scope(ExprEngine_::threshold());
         left_.init_struct(ExprEngine_::vars());
         right_.init_struct(ExprEngine_::vars());
 #ifndef NDEBUG
@@ -215,6 +216,14 @@ namespace TiledArray {
         return dist_eval_type(pimpl);
       }
 
+      /// Restrict the result shape to the nonzero tiles of a mask
+
+      /// The distributed evaluators of binary expressions and contractions
+      /// do not evaluate the tiles that are zero in the result shape, so the
+      /// tiles that are zero in \c mask are not computed.
+      /// \param mask The mask shape, with the variable list of this expression
+      void mask_shape(const shape_type& mask) { shape_ = shape_.mask(mask); }
+
       /// Expression print
 
       /// \param os The output stream
@@ -72,7 +72,10 @@ namespace TiledArray {
       typedef typename policy::pmap_interface
           pmap_interface; ///< Process map interface type
 
-      static constexpr bool consumable = true;
+      // Note: shifted tiles may share the data of the array tiles, so they
+      // are consumable only if the array tiles are.
+      static constexpr bool consumable = (! Alias) ||
+          eval_trait<typename array_type::value_type>::is_consumable;
       static constexpr unsigned int leaves = 1;
     };
 
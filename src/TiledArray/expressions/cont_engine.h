@@ -359,6 +359,8 @@ namespace TiledArray {
       /// for the result tensor as well as the tile operation.
       /// \param target_vars The target variable list for the result tensor
       void init_struct(const VariableList& target_vars) {
+        ShapeThresholdScope threshold_scope(ExprEngine_::threshold());
+
         // Initialize children
         left_.init_struct(left_vars_);
         right_.init_struct(right_vars_);
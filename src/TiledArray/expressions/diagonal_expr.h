@@ -0,0 +1,286 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  diagonal_expr.h
+ *  Dec 9, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_EXPRESSIONS_DIAGONAL_EXPR_H__INCLUDED
+#define TILEDARRAY_EXPRESSIONS_DIAGONAL_EXPR_H__INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TiledArray/expressions/variable_list.h>
+#include <TiledArray/dense_shape.h>
+#include <TiledArray/sparse_shape.h>
+#include <TiledArray/tiled_range.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Scale a tile along one dimension by the elements of a diagonal
+
+    /// \tparam Tile A contiguous tensor type
+    /// \tparam T The diagonal element type
+    /// \param arg The argument tile
+    /// \param diag The diagonal elements, indexed by the element index of
+    /// dimension \c dim
+    /// \param offset The element index of the first diagonal element
+    /// \param dim The scaled dimension
+    /// \return <tt>result(..., i, ...) = diag[i] * arg(..., i, ...)</tt>
+    template <typename Tile, typename T>
+    Tile diagonal_scale_tile(const Tile& arg,
+        const std::shared_ptr<const std::vector<T> >& diag,
+        const std::size_t offset, const unsigned int dim)
+    {
+      const auto& range = arg.range();
+      const auto* MADNESS_RESTRICT const extent = range.extent_data();
+      std::size_t outer = 1ul, inner = 1ul;
+      for(unsigned int d = 0u; d < dim; ++d)
+        outer *= extent[d];
+      for(unsigned int d = dim + 1u; d < range.rank(); ++d)
+        inner *= extent[d];
+      const std::size_t n = extent[dim];
+      const T* MADNESS_RESTRICT const diag_data = diag->data() + (range.lobound_data()[dim] - offset);
+
+      Tile result(range);
+      const auto* MADNESS_RESTRICT arg_data = arg.data();
+      auto* MADNESS_RESTRICT result_data = result.data();
+      for(std::size_t o = 0ul; o < outer; ++o) {
+        for(std::size_t i = 0ul; i < n; ++i) {
+          const T d = diag_data[i];
+          for(std::size_t j = 0ul; j < inner; ++j)
+            result_data[j] = arg_data[j] * d;
+          arg_data += inner;
+          result_data += inner;
+        }
+      }
+
+      return result;
+    }
+
+  } // namespace detail
+
+  namespace expressions {
+
+    template <typename, bool> class TsrExpr;
+
+    /// Contraction of an array with an implicit diagonal matrix
+
+    /// The product is evaluated as a scaling of the argument tiles along the
+    /// contracted dimension, which costs O(size of the argument), instead of
+    /// a contraction with an explicit diagonal array. Only the diagonal
+    /// vector, which is replicated, is needed to scale the tiles.
+    /// \note This is a terminal expression, i.e. it is not an expression
+    /// engine and can only be assigned to an annotated array, e.g.
+    /// <tt>c("i,j") = e("i,k") * a("k,j")</tt> ; it cannot be an argument of
+    /// another expression. The expression holds a (shallow) copy of the
+    /// argument array, so it may outlive the argument expression.
+    /// \tparam Array The argument array type
+    /// \tparam T The diagonal element type
+    template <typename Array, typename T>
+    class DiagonalScaleExpr {
+    public:
+      typedef DiagonalScaleExpr<Array, T> DiagonalScaleExpr_; ///< This class type
+      typedef Array array_type; ///< The argument array type
+
+    private:
+      array_type array_; ///< The argument array
+      std::string vars_; ///< The variable list of the argument
+      std::shared_ptr<const std::vector<T> > diag_; ///< The diagonal elements
+      TiledRange1 trange_; ///< The tiling of the diagonal matrix
+      std::string diag_vars_; ///< The variable list of the diagonal matrix
+
+    public:
+
+      /// Constructor
+
+      /// \param array The argument array
+      /// \param vars The variable list of the argument
+      /// \param diag The diagonal elements
+      /// \param trange The tiling of the diagonal matrix
+      /// \param diag_vars The variable list of the diagonal matrix
+      DiagonalScaleExpr(const array_type& array, const std::string& vars,
+          const std::shared_ptr<const std::vector<T> >& diag,
+          const TiledRange1& trange, const std::string& diag_vars) :
+        array_(array), vars_(vars), diag_(diag), trange_(trange),
+        diag_vars_(diag_vars)
+      { }
+
+      /// Evaluate this expression and assign the result to \c tsr
+
+      /// \tparam A The result array type
+      /// \tparam Alias The aliasing flag of the result expression
+      /// \param tsr The result tensor expression
+      template <typename A, bool Alias>
+      void eval_to(TsrExpr<A, Alias>& tsr) const {
+        typedef typename array_type::value_type value_type;
+        static_assert(std::is_same<std::remove_const_t<A>, array_type>::value,
+            "DiagonalScaleExpr: the argument and result arrays must have the same type");
+
+        const VariableList vars(vars_);
+        const VariableList diag_vars(diag_vars_);
+        TA_USER_ASSERT(diag_vars.dim() == 2u,
+            "DiagonalScaleExpr: a diagonal matrix must be annotated with two indices");
+
+        // Exactly one index of the diagonal matrix is contracted; the
+        // other one replaces it in the result
+        const auto first = std::find(vars.begin(), vars.end(), diag_vars[0]);
+        const auto second = std::find(vars.begin(), vars.end(), diag_vars[1]);
+        TA_USER_ASSERT((first == vars.end()) != (second == vars.end()),
+            "DiagonalScaleExpr: exactly one index of the diagonal matrix must appear in the argument");
+        const auto contracted = (first != vars.end() ? first : second);
+        const std::string& free_var = (first != vars.end() ? diag_vars[1] : diag_vars[0]);
+        const unsigned int dim = std::distance(vars.begin(), contracted);
+        TA_USER_ASSERT(array_.trange().data()[dim] == trange_,
+            "DiagonalScaleExpr: the tiling of the diagonal matrix does not match the contracted dimension");
+
+        std::vector<std::string> scaled(vars.begin(), vars.end());
+        scaled[dim] = free_var;
+        const VariableList scaled_vars(scaled.begin(), scaled.end());
+
+        // Scale the local tiles; no data leaves the owner of the argument tile
+        World& world = array_.world();
+        array_type result(world, array_.trange(),
+            make_shape(array_.shape(), array_.trange(), dim), array_.pmap());
+        for(const auto ord : *result.pmap()) {
+          if(result.is_zero(ord)) continue;
+          result.set(ord, world.taskq.add(
+              & detail::diagonal_scale_tile<value_type, T>,
+              array_.find(ord), diag_, trange_.elements_range().first, dim));
+        }
+
+        if(VariableList(tsr.vars()) == scaled_vars)
+          tsr.array() = result;
+        else
+          tsr = result(scaled_vars.string());
+      }
+
+    private:
+
+      /// \return A dense shape
+      static DenseShape make_shape(const DenseShape&, const TiledRange&,
+          const unsigned int)
+      { return DenseShape(); }
+
+      /// Shape of the result
+
+      /// The argument tile norms are scaled by the largest magnitude of the
+      /// diagonal elements in the tile, which bounds the result tile norms.
+      /// \param arg The shape of the argument
+      /// \param trange The tiled range of the argument
+      /// \param dim The scaled dimension
+      /// \return The result shape
+      template <typename S>
+      SparseShape<S> make_shape(const SparseShape<S>& arg,
+          const TiledRange& trange, const unsigned int dim) const
+      {
+        const auto& tiling = trange.data()[dim];
+        const std::size_t ntiles = tiling.tile_extent();
+        const std::size_t offset = tiling.elements_range().first;
+        std::vector<S> tile_max(ntiles, S(0));
+        for(std::size_t t = 0ul; t < ntiles; ++t) {
+          const auto& tile = tiling.tile(t + tiling.tiles_range().first);
+          for(auto i = tile.first; i < tile.second; ++i)
+            tile_max[t] = std::max(tile_max[t], S(std::abs((*diag_)[i - offset])));
+        }
+
+        Tensor<S> norms = arg.tile_norms().clone();
+        const auto& tiles = trange.tiles_range();
+        for(std::size_t ord = 0ul; ord < norms.size(); ++ord)
+          norms[ord] *= tile_max[tiles.idx(ord)[dim] - tiling.tiles_range().first];
+        return SparseShape<S>(norms, trange);
+      }
+
+    }; // class DiagonalScaleExpr
+
+    /// Annotated implicit diagonal matrix
+
+    /// The product of a \c DiagonalExpr and a tensor expression, e.g.
+    /// <tt>e("i,k") * a("k,j")</tt>, is a \c DiagonalScaleExpr .
+    /// \tparam T The diagonal element type
+    template <typename T>
+    class DiagonalExpr {
+    public:
+      typedef DiagonalExpr<T> DiagonalExpr_; ///< This class type
+
+    private:
+      std::shared_ptr<const std::vector<T> > diag_; ///< The diagonal elements
+      TiledRange1 trange_; ///< The tiling of the diagonal matrix
+      std::string vars_; ///< The variable list
+
+    public:
+
+      /// Constructor
+
+      /// \param diag The diagonal elements
+      /// \param trange The tiling of the diagonal matrix
+      /// \param vars The variable list
+      DiagonalExpr(const std::shared_ptr<const std::vector<T> >& diag,
+          const TiledRange1& trange, const std::string& vars) :
+        diag_(diag), trange_(trange), vars_(vars)
+      { }
+
+      /// Contraction with a tensor expression
+
+      /// \tparam A The array type
+      /// \tparam Alias The aliasing flag of the tensor expression
+      /// \param tsr The tensor expression
+      /// \return The contraction expression
+      template <typename A, bool Alias>
+      DiagonalScaleExpr<std::remove_const_t<A>, T>
+      operator*(const TsrExpr<A, Alias>& tsr) const {
+        return {tsr.array(), tsr.vars(), diag_, trange_, vars_};
+      }
+
+      /// \return The diagonal elements
+      const std::shared_ptr<const std::vector<T> >& diag() const { return diag_; }
+
+      /// \return The tiling of the diagonal matrix
+      const TiledRange1& trange() const { return trange_; }
+
+      /// \return The variable list
+      const std::string& vars() const { return vars_; }
+
+    }; // class DiagonalExpr
+
+    /// Contraction of a tensor expression with an implicit diagonal matrix
+
+    /// \tparam A The array type
+    /// \tparam Alias The aliasing flag of the tensor expression
+    /// \tparam T The diagonal element type
+    /// \param tsr The tensor expression
+    /// \param diag The annotated diagonal matrix
+    /// \return The contraction expression
+    template <typename A, bool Alias, typename T>
+    inline DiagonalScaleExpr<std::remove_const_t<A>, T>
+    operator*(const TsrExpr<A, Alias>& tsr, const DiagonalExpr<T>& diag) {
+      return diag * tsr;
+    }
+
+  } // namespace expressions
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXPRESSIONS_DIAGONAL_EXPR_H__INCLUDED
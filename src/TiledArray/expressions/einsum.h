@@ -0,0 +1,447 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  einsum.h
+ *  Nov 11, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_EXPRESSIONS_EINSUM_H__INCLUDED
+#define TILEDARRAY_EXPRESSIONS_EINSUM_H__INCLUDED
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <TiledArray/expressions/tsr_expr.h>
+#include <TiledArray/expressions/variable_list.h>
+#include <TiledArray/reduce_task.h>
+#include <TiledArray/math/blas.h>
+#include <TiledArray/math/vector_op.h>
+#include <TiledArray/dense_shape.h>
+#include <TiledArray/sparse_shape.h>
+#include <TiledArray/tiled_range.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Batched contract and (sum) reduce operation
+
+    /// Tiles are laid out as <tt>left(h,a,k)</tt>, <tt>right(h,k,b)</tt> and
+    /// <tt>result(h,a,b)</tt>, where \c h, \c a, \c b, and \c k are (possibly
+    /// empty) groups of contiguous dimensions. For every element of the batch
+    /// dimensions \c h the corresponding matrices are multiplied with GEMM.
+    /// \tparam Result The result tile type
+    /// \tparam Left The left-hand tile type
+    /// \tparam Right The right-hand tile type
+    template <typename Result, typename Left, typename Right>
+    class BatchedContractReduce {
+    public:
+      typedef BatchedContractReduce<Result, Left, Right>
+          BatchedContractReduce_; ///< This class type
+      typedef const Left& first_argument_type; ///< The left tile type
+      typedef const Right& second_argument_type; ///< The right tile type
+      typedef Result result_type; ///< The result tile type
+      typedef typename Result::numeric_type numeric_type; ///< The element type
+
+    private:
+      unsigned int batch_rank_ = 0u; ///< The number of batch dimensions
+      unsigned int left_outer_rank_ = 0u; ///< The number of left outer dimensions
+      unsigned int inner_rank_ = 0u; ///< The number of contracted dimensions
+      unsigned int right_outer_rank_ = 0u; ///< The number of right outer dimensions
+
+      /// Product of range extents in <tt>[first, last)</tt>
+      template <typename Range>
+      static integer volume(const Range& range, unsigned int first,
+          unsigned int last)
+      {
+        integer result = 1;
+        for(; first < last; ++first)
+          result *= range.extent(first);
+        return result;
+      }
+
+    public:
+      BatchedContractReduce() = default;
+      BatchedContractReduce(const BatchedContractReduce_&) = default;
+      BatchedContractReduce(BatchedContractReduce_&&) = default;
+      ~BatchedContractReduce() = default;
+      BatchedContractReduce_& operator=(const BatchedContractReduce_&) = default;
+      BatchedContractReduce_& operator=(BatchedContractReduce_&&) = default;
+
+      /// Constructor
+
+      /// \param batch_rank The number of batch dimensions
+      /// \param left_outer_rank The number of outer dimensions of the left-hand tile
+      /// \param inner_rank The number of contracted dimensions
+      /// \param right_outer_rank The number of outer dimensions of the right-hand tile
+      BatchedContractReduce(const unsigned int batch_rank,
+          const unsigned int left_outer_rank, const unsigned int inner_rank,
+          const unsigned int right_outer_rank) :
+        batch_rank_(batch_rank), left_outer_rank_(left_outer_rank),
+        inner_rank_(inner_rank), right_outer_rank_(right_outer_rank)
+      { }
+
+      /// Create a result type object
+      result_type operator()() const { return result_type(); }
+
+      /// Post processing step
+      const result_type& operator()(const result_type& temp) const {
+        return temp;
+      }
+
+      /// Reduce two result objects
+      void operator()(result_type& result, const result_type& arg) const {
+        using TiledArray::add_to;
+        add_to(result, arg);
+      }
+
+      /// Contract a pair of tiles and add to a target tile
+
+      /// \param[in,out] result The result object that will be the reduction
+      /// target
+      /// \param[in] left The left-hand tile to be contracted
+      /// \param[in] right The right-hand tile to be contracted
+      void operator()(result_type& result, first_argument_type left,
+          second_argument_type right) const
+      {
+        const auto& left_range = left.range();
+        const auto& right_range = right.range();
+        TA_ASSERT(left_range.rank() == batch_rank_ + left_outer_rank_ + inner_rank_);
+        TA_ASSERT(right_range.rank() == batch_rank_ + inner_rank_ + right_outer_rank_);
+
+        // A Hadamard product has a single element per batch, so the tiles are
+        // multiplied element-wise instead of by 1x1x1 GEMMs
+        if(left_outer_rank_ + inner_rank_ + right_outer_rank_ == 0u) {
+          TA_ASSERT(left_range == right_range);
+          if(result.empty()) {
+            using TiledArray::mult;
+            result = mult(left, right);
+          } else {
+            TA_ASSERT(result.range() == left_range);
+            math::inplace_vector_op([] (numeric_type& MADNESS_RESTRICT c,
+                const numeric_type a, const numeric_type b) { c += a * b; },
+                left_range.volume(), result.data(), left.data(), right.data());
+          }
+          return;
+        }
+
+        if(result.empty()) {
+          std::vector<std::size_t> lobound, upbound;
+          for(unsigned int i = 0u; i < batch_rank_ + left_outer_rank_; ++i) {
+            lobound.push_back(left_range.lobound(i));
+            upbound.push_back(left_range.upbound(i));
+          }
+          for(unsigned int i = batch_rank_ + inner_rank_; i < right_range.rank(); ++i) {
+            lobound.push_back(right_range.lobound(i));
+            upbound.push_back(right_range.upbound(i));
+          }
+          result = result_type(typename result_type::range_type(lobound, upbound),
+              numeric_type(0));
+        }
+
+        const integer batch = volume(left_range, 0u, batch_rank_);
+        const integer m = volume(left_range, batch_rank_, batch_rank_ + left_outer_rank_);
+        const integer k = volume(left_range, batch_rank_ + left_outer_rank_, left_range.rank());
+        const integer n = volume(right_range, batch_rank_ + inner_rank_, right_range.rank());
+        TA_ASSERT(k == volume(right_range, batch_rank_, batch_rank_ + inner_rank_));
+
+        const auto* MADNESS_RESTRICT const a = left.data();
+        const auto* MADNESS_RESTRICT const b = right.data();
+        auto* MADNESS_RESTRICT const c = result.data();
+        for(integer h = 0; h < batch; ++h)
+          math::gemm(madness::cblas::NoTrans, madness::cblas::NoTrans, m, n, k,
+              numeric_type(1), a + h * m * k, k, b + h * k * n, n,
+              numeric_type(1), c + h * m * n, n);
+      }
+
+    }; // class BatchedContractReduce
+
+    /// Apply an operation to every contracted tile index
+
+    /// Without contracted indices, i.e. for a Hadamard product or a batched
+    /// outer product, the product of each pair of tiles has a single term,
+    /// so \c op is applied once to an empty index.
+    /// \tparam Op The operation type
+    /// \param k_range The range of the contracted tile indices
+    /// \param op The operation, which takes a contracted tile index
+    template <typename Op>
+    inline void for_each_inner_index(const Range& k_range, Op&& op) {
+      if(k_range.rank() == 0u) {
+        op(std::vector<std::size_t>());
+        return;
+      }
+      for(const auto& k_idx : k_range)
+        op(k_idx);
+    }
+
+    /// Shape of a batched contraction
+
+    /// \return A dense shape
+    template <typename... Args>
+    inline DenseShape batched_contraction_shape(const DenseShape&,
+        const DenseShape&, const TiledRange&, Args&&...)
+    { return DenseShape(); }
+
+    /// Shape of a batched contraction
+
+    /// The norm of each result tile is bounded by
+    /// \f$ \sum_k \|A_{hak}\| \|B_{hkb}\| \f$ .
+    /// \param left The shape of the left-hand argument, laid out as (h,a,k)
+    /// \param right The shape of the right-hand argument, laid out as (h,k,b)
+    /// \param trange The tiled range of the result, laid out as (h,a,b)
+    /// \param batch_rank The number of batch dimensions
+    /// \param left_outer_rank The number of outer dimensions of the left-hand argument
+    /// \param inner_rank The number of contracted dimensions
+    /// \return The estimated shape of the result
+    template <typename T>
+    inline SparseShape<T> batched_contraction_shape(const SparseShape<T>& left,
+        const SparseShape<T>& right, const TiledRange& trange,
+        const unsigned int batch_rank, const unsigned int left_outer_rank,
+        const unsigned int inner_rank)
+    {
+      const auto& left_norms = left.tile_norms();
+      const auto& right_norms = right.tile_norms();
+      const auto& left_range = left_norms.range();
+      const auto& right_range = right_norms.range();
+
+      // The range of the contracted tile indices
+      std::vector<std::size_t> k_lobound, k_upbound;
+      for(unsigned int i = batch_rank + left_outer_rank; i < left_range.rank(); ++i) {
+        k_lobound.push_back(left_range.lobound(i));
+        k_upbound.push_back(left_range.upbound(i));
+      }
+      const Range k_range(k_lobound, k_upbound);
+
+      Tensor<T> norms(trange.tiles_range(), T(0));
+      std::vector<std::size_t> left_idx(left_range.rank()),
+          right_idx(right_range.rank());
+      for(const auto& idx : trange.tiles_range()) {
+        std::copy(idx.begin(), idx.begin() + batch_rank + left_outer_rank,
+            left_idx.begin());
+        std::copy(idx.begin(), idx.begin() + batch_rank, right_idx.begin());
+        std::copy(idx.begin() + batch_rank + left_outer_rank, idx.end(),
+            right_idx.begin() + batch_rank + inner_rank);
+        T norm = 0;
+        for_each_inner_index(k_range, [&] (const auto& k_idx) {
+          std::copy(k_idx.begin(), k_idx.end(),
+              left_idx.begin() + batch_rank + left_outer_rank);
+          std::copy(k_idx.begin(), k_idx.end(), right_idx.begin() + batch_rank);
+          norm += left_norms[left_idx] * right_norms[right_idx];
+        });
+        norms[idx] = norm;
+      }
+
+      return SparseShape<T>(norms, trange);
+    }
+
+  } // namespace detail
+
+  namespace expressions {
+
+    /// Contraction with batch (Hadamard) indices
+
+    /// Evaluates generalized products such as
+    /// \code
+    /// c = einsum(a("i,a,k"), b("i,k,b"), "i,a,b");
+    /// \endcode
+    /// where indices that appear in both arguments and in the result
+    /// (batch indices) are neither summed over nor broadcast. The arguments
+    /// are permuted so that batch indices lead, and every result tile is
+    /// computed by its owner as a sum over contracted tile blocks of batched
+    /// GEMMs, i.e. each batch tile block is contracted in a single distributed
+    /// pass rather than one expression per slice. Each rank fetches every
+    /// argument tile it needs once: the futures of the argument tiles are
+    /// cached for the duration of the evaluation and shared by all local
+    /// result tiles that use them, which avoids the repeated remote requests
+    /// of a per-result-tile \c find() without the global synchronization of
+    /// running a SUMMA contraction per batch slice. Without contracted indices
+    /// (e.g. <tt>"b,i" x "b,j" -> "b,i,j"</tt>) each result tile is the
+    /// batched outer or Hadamard product of a single pair of tiles. Without
+    /// batch indices this is equivalent to <tt>c(result_vars) = left * right</tt>.
+    /// \tparam ArrayL The left-hand array type
+    /// \tparam ArrayR The right-hand array type
+    /// \param left The left-hand tensor expression
+    /// \param right The right-hand tensor expression
+    /// \param result_vars The variable list of the result
+    /// \return The result array, annotated with \c result_vars
+    /// \note Tiles must provide contiguous, row-major data (e.g. \c Tensor)
+    template <typename ArrayL, bool AliasL, typename ArrayR, bool AliasR>
+    inline std::remove_const_t<ArrayL>
+    einsum(const TsrExpr<ArrayL, AliasL>& left,
+        const TsrExpr<ArrayR, AliasR>& right, const std::string& result_vars)
+    {
+      typedef std::remove_const_t<ArrayL> array_type;
+      typedef typename array_type::value_type value_type;
+      typedef typename array_type::policy_type policy_type;
+
+      const VariableList left_vars(left.vars());
+      const VariableList right_vars(right.vars());
+      const VariableList target_vars(result_vars);
+
+      auto contains = [] (const VariableList& vars, const std::string& var) {
+        return std::find(vars.begin(), vars.end(), var) != vars.end();
+      };
+
+      // Classify indices
+      std::vector<std::string> h, a, k, b;
+      for(const auto& var : target_vars) {
+        TA_USER_ASSERT(contains(left_vars, var) || contains(right_vars, var),
+            "einsum(): result index does not appear in either argument");
+        if(contains(left_vars, var) && contains(right_vars, var))
+          h.push_back(var);
+      }
+      for(const auto& var : left_vars) {
+        if(contains(right_vars, var)) {
+          if(! contains(target_vars, var))
+            k.push_back(var);
+        } else {
+          TA_USER_ASSERT(contains(target_vars, var),
+              "einsum(): an index of the left-hand argument does not appear in the right-hand argument or the result");
+          a.push_back(var);
+        }
+      }
+      for(const auto& var : right_vars) {
+        if(! contains(left_vars, var)) {
+          TA_USER_ASSERT(contains(target_vars, var),
+              "einsum(): an index of the right-hand argument does not appear in the left-hand argument or the result");
+          b.push_back(var);
+        }
+      }
+
+      array_type result;
+
+      // Without batch indices this is an ordinary contraction
+      if(h.empty()) {
+        result(result_vars) = left * right;
+        return result;
+      }
+
+      auto join = [] (std::initializer_list<const std::vector<std::string>*> groups) {
+        std::vector<std::string> vars;
+        for(const auto* group : groups)
+          vars.insert(vars.end(), group->begin(), group->end());
+        return VariableList(vars.begin(), vars.end());
+      };
+      const VariableList hak = join({&h, &a, &k});
+      const VariableList hkb = join({&h, &k, &b});
+      const VariableList hab = join({&h, &a, &b});
+
+      // Permute arguments to the (h,a,k) and (h,k,b) layouts
+      array_type left_array, right_array;
+      if(left_vars == hak)
+        left_array = left.array();
+      else
+        left_array(hak.string()) = left;
+      if(right_vars == hkb)
+        right_array = right.array();
+      else
+        right_array(hkb.string()) = right;
+
+      const unsigned int h_rank = h.size(), a_rank = a.size(),
+          k_rank = k.size(), b_rank = b.size();
+
+      // Construct the result tiled range and shape
+      const auto& left_tr = left_array.trange().data();
+      const auto& right_tr = right_array.trange().data();
+      std::vector<TiledRange1> tr1;
+      tr1.insert(tr1.end(), left_tr.begin(), left_tr.begin() + h_rank + a_rank);
+      tr1.insert(tr1.end(), right_tr.begin() + h_rank + k_rank, right_tr.end());
+      for(unsigned int i = 0u; i < h_rank; ++i)
+        TA_USER_ASSERT(left_tr[i] == right_tr[i],
+            "einsum(): the tiled ranges of the batch indices do not match");
+      for(unsigned int i = 0u; i < k_rank; ++i)
+        TA_USER_ASSERT(left_tr[h_rank + a_rank + i] == right_tr[h_rank + i],
+            "einsum(): the tiled ranges of the contracted indices do not match");
+      const TiledRange trange(tr1.begin(), tr1.end());
+
+      World& world = left_array.world();
+      array_type hab_array(world, trange,
+          detail::batched_contraction_shape(left_array.shape(),
+              right_array.shape(), trange, h_rank, a_rank, k_rank),
+          policy_type::default_pmap(world, trange.tiles_range().volume()));
+
+      // The range of the contracted tile indices
+      const auto& left_tiles = left_array.trange().tiles_range();
+      std::vector<std::size_t> k_lobound, k_upbound;
+      for(unsigned int i = h_rank + a_rank; i < left_tiles.rank(); ++i) {
+        k_lobound.push_back(left_tiles.lobound(i));
+        k_upbound.push_back(left_tiles.upbound(i));
+      }
+      const Range k_range(k_lobound, k_upbound);
+
+      typedef detail::BatchedContractReduce<value_type, value_type, value_type> op_type;
+      const op_type op(h_rank, a_rank, k_rank, b_rank);
+
+      // Argument tiles that were requested by this rank
+      std::unordered_map<std::size_t, Future<value_type> > left_tiles_cache,
+          right_tiles_cache;
+      auto find_tile = [] (const array_type& array,
+          std::unordered_map<std::size_t, Future<value_type> >& cache,
+          const std::vector<std::size_t>& idx)
+      {
+        const std::size_t ord = array.trange().tiles_range().ordinal(idx);
+        auto it = cache.find(ord);
+        if(it == cache.end())
+          it = cache.emplace(ord, array.find(ord)).first;
+        return it->second;
+      };
+
+      std::vector<std::size_t> left_idx(h_rank + a_rank + k_rank),
+          right_idx(h_rank + k_rank + b_rank);
+      for(const auto ord : *hab_array.pmap()) {
+        if(hab_array.is_zero(ord)) continue;
+
+        const auto idx = trange.tiles_range().idx(ord);
+        std::copy(idx.begin(), idx.begin() + h_rank + a_rank, left_idx.begin());
+        std::copy(idx.begin(), idx.begin() + h_rank, right_idx.begin());
+        std::copy(idx.begin() + h_rank + a_rank, idx.end(),
+            right_idx.begin() + h_rank + k_rank);
+
+        detail::ReducePairTask<op_type> reduce_task(world, op);
+        std::size_t pairs = 0ul;
+        detail::for_each_inner_index(k_range, [&] (const auto& k_idx) {
+          std::copy(k_idx.begin(), k_idx.end(), left_idx.begin() + h_rank + a_rank);
+          std::copy(k_idx.begin(), k_idx.end(), right_idx.begin() + h_rank);
+          if(left_array.is_zero(left_idx) || right_array.is_zero(right_idx))
+            return;
+          reduce_task.add(find_tile(left_array, left_tiles_cache, left_idx),
+              find_tile(right_array, right_tiles_cache, right_idx));
+          ++pairs;
+        });
+
+        if(pairs)
+          hab_array.set(ord, reduce_task.submit());
+        else
+          hab_array.set(ord, value_type(trange.make_tile_range(ord),
+              typename value_type::numeric_type(0)));
+      }
+
+      if(target_vars == hab)
+        return hab_array;
+      result(result_vars) = hab_array(hab.string());
+      return result;
+    }
+
+  } // namespace expressions
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXPRESSIONS_EINSUM_H__INCLUDED
@@ -34,6 +34,7 @@
 #include "../tile_op/unary_wrapper.h"
 #include "../tile_op/unary_reduction.h"
 #include "../tile_op/binary_reduction.h"
+#include "../tile_op/tuple_reduction.h"
 #include "../tile_op/reduce_wrapper.h"
 #include <TiledArray/config.h>
 #ifdef TILEDARRAY_HAS_CUDA
@@ -53,7 +54,7 @@ namespace TiledArray {
     template <typename Engine>
     struct EngineParamOverride {
 
-      EngineParamOverride() : world(nullptr), pmap(), shape(nullptr) {}
+      EngineParamOverride() : world(nullptr), pmap(), shape(nullptr), threshold(-1.0) {}
 
       typedef typename EngineTrait<Engine>::policy policy; ///< The result policy type
       typedef typename EngineTrait<Engine>::shape_type shape_type; ///< Tensor shape type
@@ -62,8 +63,79 @@ namespace TiledArray {
        World* world;
        std::shared_ptr<pmap_interface> pmap;
        const shape_type* shape;
+       double threshold; ///< The zero threshold of sparse shapes, or a negative value for the default
     };
 
+    /// Reduction of the left-hand tiles of a pair reduction without a partner
+
+    /// The pairs in which one tile is zero do not contribute to general pair
+    /// reductions, so the left-hand tiles of such pairs are discarded.
+    /// \tparam Left The left-hand tile type
+    /// \tparam Right The right-hand tile type
+    /// \tparam Op The pair reduction operation type
+    template <typename Left, typename Right, typename Op>
+    class UnpairedReduceTask {
+    public:
+      typedef typename Op::result_type result_type; ///< The reduction result type
+
+      UnpairedReduceTask(World&, const Op&) { }
+
+      /// Add a left-hand tile whose right-hand tile is zero
+      void add(const Future<Left>&) { }
+
+      /// \param pairs The local result of the pair reduction
+      /// \return The local result of the reduction
+      Future<result_type> submit(const Future<result_type>& pairs) {
+        return pairs;
+      }
+    }; // class UnpairedReduceTask
+
+    /// Reduction of the left-hand tiles of a tuple reduction without a partner
+
+    /// The unary reductions of a tuple reduction are applied to every
+    /// non-zero left-hand tile, including those whose right-hand tile is zero.
+    /// \tparam Left The left-hand tile type
+    /// \tparam Right The right-hand tile type
+    /// \tparam Ops The reduction operation types
+    template <typename Left, typename Right, typename... Ops>
+    class UnpairedReduceTask<Left, Right, TupleReduction<Ops...> > {
+    public:
+      typedef TupleReduction<Ops...> op_type; ///< The tuple reduction type
+      typedef typename op_type::result_type result_type; ///< The reduction result type
+
+    private:
+      typedef TiledArray::math::UnaryReduceWrapper<Left,
+          UnpairedTupleReduction<typename eval_trait<Right>::type, Ops...> >
+          unpaired_op_type;
+
+      World& world_;
+      op_type op_;
+      TiledArray::detail::ReduceTask<unpaired_op_type> reduce_task_;
+
+      static result_type combine(const op_type& op, result_type pairs,
+          const result_type& unpaired)
+      {
+        op(pairs, unpaired);
+        return pairs;
+      }
+
+    public:
+      UnpairedReduceTask(World& world, const op_type& op) :
+        world_(world), op_(op), reduce_task_(world, unpaired_op_type(
+            UnpairedTupleReduction<typename eval_trait<Right>::type, Ops...>(op)))
+      { }
+
+      /// Add a left-hand tile whose right-hand tile is zero
+      void add(const Future<Left>& left) { reduce_task_.add(left); }
+
+      /// \param pairs The local result of the pair reduction
+      /// \return The local result of the reduction
+      Future<result_type> submit(const Future<result_type>& pairs) {
+        return world_.taskq.add(& UnpairedReduceTask::combine, op_, pairs,
+            reduce_task_.submit());
+      }
+    }; // class UnpairedReduceTask
+
     /// \brief type trait checks if T has array() member
     /// Useful to determine if an Expr is a TsrExpr or a related type
     template<class E>
@@ -141,6 +213,18 @@ namespace TiledArray {
         return derived();
       }
 
+      /// \param threshold the zero threshold of the sparse shapes of this
+      /// expression and its subexpressions, instead of the global
+      /// \c SparseShape threshold; the result keeps it (see
+      /// \c ShapeThresholdScope )
+      Expr<Derived>& set_threshold(const double threshold) {
+        TA_ASSERT(threshold >= 0.0);
+        if (override_ptr_ == nullptr)
+          override_ptr_ = std::make_shared<override_type>();
+        override_ptr_->threshold = threshold;
+        return derived();
+      }
+
     private:
 
       /// Task function used to evaluate a lazy tile and apply an op
@@ -549,54 +633,26 @@ namespace TiledArray {
         return default_world_helper<Derived>(this->derived()).get();
       }
 
-    public:
-
-      template <typename Op>
-      Future<typename Op::result_type>
-      reduce(const Op& op, World& world) const {
-        // Typedefs
-        typedef madness::TaggedKey<madness::uniqueidT, ExpressionReduceTag> key_type;
-        typedef TiledArray::math::UnaryReduceWrapper<typename engine_type::value_type,
-            Op> reduction_op_type;
-
-        // Construct the expression engine
-        engine_type engine(derived());
-        engine.init(world, std::shared_ptr<typename engine_type::pmap_interface>(),
-            VariableList());
-
-        // Create the distributed evaluator from this expression
-        typename engine_type::dist_eval_type dist_eval = engine.make_dist_eval();
-        dist_eval.eval();
-
-        // Create a local reduction task
-        reduction_op_type wrapped_op(op);
-        TiledArray::detail::ReduceTask<reduction_op_type> reduce_task(world, wrapped_op);
-
-        // Move the data from dist_eval into the local reduction task
-        typename engine_type::dist_eval_type::pmap_interface::const_iterator it =
-            dist_eval.pmap()->begin();
-        const typename engine_type::dist_eval_type::pmap_interface::const_iterator end =
-            dist_eval.pmap()->end();
-        for(; it != end; ++it)
-          if(! dist_eval.is_zero(*it))
-            reduce_task.add(dist_eval.get(*it));
-
-        // All reduce the result of the expression
-        auto result = world.gop.all_reduce(key_type(dist_eval.id()), reduce_task.submit(), op);
-        dist_eval.wait();
-        return result;
-      }
-
-      template <typename Op>
-      Future<typename Op::result_type>
-      reduce(const Op& op) const {
-        return reduce(op, default_world());
-      }
-
+      /// Reduce the pairs of tiles of this and another expression
+
+      /// \tparam D The right-hand expression type
+      /// \tparam Op The binary reduction operation type
+      /// \param right_expr The right-hand expression
+      /// \param op The reduction operation
+      /// \param world The world of the reduction
+      /// \param product If \c true , \c op is a reduction of the products of
+      /// the tiles, which is zero if either tile is zero. The shape of each
+      /// expression is then masked by the shape of the other before they are
+      /// evaluated, so that contractions and binary expressions, e.g. the
+      /// contraction in <tt> (t("i,j")*v("j,k")).dot(w("i,k")) </tt> , do not
+      /// compute the tiles that are multiplied by zero tiles. Both expressions
+      /// are reduced as their tiles are evaluated, without forming the
+      /// distributed result.
+      /// \return A future to the result of the reduction
       template <typename D, typename Op>
       Future<typename Op::result_type>
-      reduce(const Expr<D>& right_expr, const Op& op,
-             World& world) const
+      reduce_pairs(const Expr<D>& right_expr, const Op& op, World& world,
+          const bool product) const
       {
         static_assert(is_aliased<D>::value,
             "no_alias() expressions are not allowed on the right-hand side of "
@@ -607,21 +663,23 @@ namespace TiledArray {
         typedef TiledArray::math::BinaryReduceWrapper<typename engine_type::value_type,
             typename D::engine_type::value_type, Op> reduction_op_type;
 
-        // Evaluate this expression
+        // Initialize this expression and the right-hand expression
         engine_type left_engine(derived());
         left_engine.init(world, std::shared_ptr<typename engine_type::pmap_interface>(),
             VariableList());
+        typename D::engine_type right_engine(right_expr.derived());
+        right_engine.init(world, left_engine.pmap(), left_engine.vars());
 
-        // Create the distributed evaluator for this expression
+        // Skip the tiles that are multiplied by zero tiles
+        if(product)
+          mask_shapes(left_engine, right_engine,
+              std::is_same<typename engine_type::shape_type,
+                  typename D::engine_type::shape_type>());
+
+        // Create the distributed evaluators for both expressions
         typename engine_type::dist_eval_type left_dist_eval =
             left_engine.make_dist_eval();
         left_dist_eval.eval();
-
-        // Evaluate the right-hand expression
-        typename D::engine_type right_engine(right_expr.derived());
-        right_engine.init(world, left_engine.pmap(), left_engine.vars());
-
-        // Create the distributed evaluator for the right-hand expression
         typename D::engine_type::dist_eval_type right_dist_eval =
             right_engine.make_dist_eval();
         right_dist_eval.eval();
@@ -643,6 +701,8 @@ namespace TiledArray {
         reduction_op_type wrapped_op(op);
         TiledArray::detail::ReducePairTask<reduction_op_type>
             local_reduce_task(world, wrapped_op);
+        UnpairedReduceTask<typename engine_type::value_type,
+            typename D::engine_type::value_type, Op> unpaired_reduce_task(world, op);
 
         // Move the data from dist_eval into the local reduction task
         typename engine_type::dist_eval_type::pmap_interface::const_iterator it =
@@ -657,24 +717,146 @@ namespace TiledArray {
           if(left_not_zero && right_not_zero) {
             local_reduce_task.add(left_dist_eval.get(index), right_dist_eval.get(index));
           } else {
-            if(left_not_zero) left_dist_eval.get(index);
+            if(left_not_zero) unpaired_reduce_task.add(left_dist_eval.get(index));
             if(right_not_zero) right_dist_eval.get(index);
           }
         }
 
         auto result = world.gop.all_reduce(key_type(left_dist_eval.id()),
-            local_reduce_task.submit(), op);
+            unpaired_reduce_task.submit(local_reduce_task.submit()), op);
         left_dist_eval.wait();
         right_dist_eval.wait();
         return result;
       }
 
+      /// Mask the shapes of two engines by each other
+
+      /// \param left The left-hand engine
+      /// \param right The right-hand engine
+      template <typename L, typename R>
+      static void mask_shapes(L& left, R& right, std::true_type) {
+        const typename L::shape_type left_shape = left.shape();
+        left.mask_shape(right.shape());
+        right.mask_shape(left_shape);
+      }
+
+      /// Shapes of different types are not masked
+      template <typename L, typename R>
+      static void mask_shapes(L&, R&, std::false_type) { }
+
+    public:
+
+      template <typename Op>
+      Future<typename Op::result_type>
+      reduce(const Op& op, World& world) const {
+        // Typedefs
+        typedef madness::TaggedKey<madness::uniqueidT, ExpressionReduceTag> key_type;
+        typedef TiledArray::math::UnaryReduceWrapper<typename engine_type::value_type,
+            Op> reduction_op_type;
+
+        // Construct the expression engine
+        engine_type engine(derived());
+        engine.init(world, std::shared_ptr<typename engine_type::pmap_interface>(),
+            VariableList());
+
+        // Create the distributed evaluator from this expression
+        typename engine_type::dist_eval_type dist_eval = engine.make_dist_eval();
+        dist_eval.eval();
+
+        // Create a local reduction task
+        reduction_op_type wrapped_op(op);
+        TiledArray::detail::ReduceTask<reduction_op_type> reduce_task(world, wrapped_op);
+
+        // Move the data from dist_eval into the local reduction task
+        typename engine_type::dist_eval_type::pmap_interface::const_iterator it =
+            dist_eval.pmap()->begin();
+        const typename engine_type::dist_eval_type::pmap_interface::const_iterator end =
+            dist_eval.pmap()->end();
+        for(; it != end; ++it)
+          if(! dist_eval.is_zero(*it))
+            reduce_task.add(dist_eval.get(*it));
+
+        // All reduce the result of the expression
+        auto result = world.gop.all_reduce(key_type(dist_eval.id()), reduce_task.submit(), op);
+        dist_eval.wait();
+        return result;
+      }
+
+      template <typename Op>
+      Future<typename Op::result_type>
+      reduce(const Op& op) const {
+        return reduce(op, default_world());
+      }
+
+      template <typename D, typename Op>
+      Future<typename Op::result_type>
+      reduce(const Expr<D>& right_expr, const Op& op,
+             World& world) const
+      {
+        return reduce_pairs(right_expr, op, world, false);
+      }
+
       template <typename D, typename Op>
       Future<typename Op::result_type>
       reduce(const Expr<D>& right_expr, const Op& op) const {
         return reduce(right_expr, op, default_world());
       }
 
+      /// Evaluate several reductions of this expression in a single pass
+
+      /// Each tile is visited once and the results of all reductions are
+      /// combined with a single global reduction, e.g.
+      /// \code
+      /// auto r = x("i").reduce(std::make_tuple(SquaredNormReduction<T>(),
+      ///                                        AbsMaxReduction<T>()));
+      /// \endcode
+      /// \tparam Ops The reduction operation types
+      /// \param ops The reduction operations
+      /// \param world The world where the reduction is evaluated
+      /// \return A future to the tuple of the results of \c ops
+      template <typename... Ops>
+      Future<typename TiledArray::TupleReduction<Ops...>::result_type>
+      reduce(const std::tuple<Ops...>& ops, World& world) const {
+        return reduce(TiledArray::TupleReduction<Ops...>(ops), world);
+      }
+
+      template <typename... Ops>
+      Future<typename TiledArray::TupleReduction<Ops...>::result_type>
+      reduce(const std::tuple<Ops...>& ops) const {
+        return reduce(ops, default_world());
+      }
+
+      /// Evaluate several reductions of a pair of expressions in a single pass
+
+      /// Binary reductions (e.g. \c DotReduction ) are applied to the tile
+      /// pairs in which both tiles are non-zero, unary reductions to every
+      /// non-zero tile of this expression, e.g.
+      /// \code
+      /// auto r = x("i").reduce(y("i"), std::make_tuple(SquaredNormReduction<T>(),
+      ///                                                DotReduction<T, T>()));
+      /// \endcode
+      /// evaluates <tt>x.x</tt> and <tt>x.y</tt> .
+      /// \tparam D The right-hand expression type
+      /// \tparam Ops The reduction operation types
+      /// \param right_expr The right-hand expression
+      /// \param ops The reduction operations
+      /// \param world The world where the reduction is evaluated
+      /// \return A future to the tuple of the results of \c ops
+      template <typename D, typename... Ops>
+      Future<typename TiledArray::TupleReduction<Ops...>::result_type>
+      reduce(const Expr<D>& right_expr, const std::tuple<Ops...>& ops,
+             World& world) const
+      {
+        return reduce(right_expr, TiledArray::TupleReduction<Ops...>(ops),
+            world);
+      }
+
+      template <typename D, typename... Ops>
+      Future<typename TiledArray::TupleReduction<Ops...>::result_type>
+      reduce(const Expr<D>& right_expr, const std::tuple<Ops...>& ops) const {
+        return reduce(right_expr, ops, default_world());
+      }
+
       Future<typename TiledArray::TraceReduction<
           typename EngineTrait<engine_type>::eval_type>::result_type>
       trace(World& world) const {
@@ -832,8 +1014,8 @@ namespace TiledArray {
       dot(const Expr<D>& right_expr, World& world) const {
         typedef typename EngineTrait<engine_type>::eval_type left_value_type;
         typedef typename EngineTrait<typename D::engine_type>::eval_type right_value_type;
-        return reduce(right_expr, TiledArray::DotReduction<left_value_type,
-            right_value_type>(), world);
+        return reduce_pairs(right_expr, TiledArray::DotReduction<left_value_type,
+            right_value_type>(), world, true);
       }
 
       template <typename D>
@@ -851,8 +1033,8 @@ namespace TiledArray {
       inner_product(const Expr<D>& right_expr, World& world) const {
         typedef typename EngineTrait<engine_type>::eval_type left_value_type;
         typedef typename EngineTrait<typename D::engine_type>::eval_type right_value_type;
-        return reduce(right_expr, TiledArray::InnerProductReduction<left_value_type,
-                                                                    right_value_type>(), world);
+        return reduce_pairs(right_expr, TiledArray::InnerProductReduction<left_value_type,
+                                                                          right_value_type>(), world, true);
       }
 
       template <typename D>
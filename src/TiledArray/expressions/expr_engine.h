@@ -28,6 +28,7 @@
 
 #include <TiledArray/external/madness.h>
 #include <TiledArray/expressions/expr_trace.h>
+#include <TiledArray/sparse_shape.h>
 
 namespace TiledArray {
   namespace expressions {
@@ -128,6 +129,7 @@ namespace TiledArray {
       /// functions.
       /// \param target_vars The target variable list for the result tensor
       void init_struct(const VariableList& target_vars) {
+        ShapeThresholdScope threshold_scope(threshold());
         if(target_vars != vars_) {
           perm_ = derived().make_perm(target_vars);
           trange_ = derived().make_trange(perm_);
@@ -141,6 +143,27 @@ namespace TiledArray {
           shape_ = shape_.mask(*override_ptr_->shape);
       }
 
+      /// Restrict the result shape to the nonzero tiles of a mask
+
+      /// This is used by reductions that are products of the tiles of two
+      /// expressions, e.g. \c Expr::dot() , to skip the result tiles that
+      /// are multiplied by zero tiles. Engines whose distributed evaluators
+      /// evaluate only the nonzero tiles of the result shape, i.e. binary
+      /// expressions and contractions, override this function; the other
+      /// engines ignore the mask.
+      /// \param mask The mask shape, with the variable list of this expression
+      void mask_shape(const shape_type&) { }
+
+      /// Shape threshold accessor
+
+      /// \return The zero threshold of the shapes of this expression and its
+      /// subexpressions, or a negative value if it was not set by
+      /// \c Expr::set_threshold() ; derived classes open a
+      /// \c ShapeThresholdScope with it before initializing their arguments
+      double threshold() const {
+        return (override_ptr_ ? override_ptr_->threshold : -1.0);
+      }
+
       /// Initialize result tensor distribution
 
       /// This function will initialize the world and process map for the result
@@ -126,7 +126,8 @@ namespace TiledArray {
     /// includes Hadamard product, e.g. \code (c("i,j")=)a("i,j")*b("i,j") \endcode , and
     /// pure contractions, e.g. \code (c("i,j")=)a("i,k")*b("k,j") \endcode .
     /// \internal mixed Hadamard-contraction case, e.g. \code c("i,j,l")=a("i,l,k")*b("j,l,k") \endcode , is not supported since
-    ///   this requires that the result labels are assigned by user (currently they are computed by this engine)
+    ///   this requires that the result labels are assigned by user (currently they are computed by this engine);
+    ///   use \c einsum() instead
     /// \tparam Left The left-hand engine type
     /// \tparam Right The right-hand engine type
     /// \tparam Result The result tile type
@@ -218,6 +219,8 @@ namespace TiledArray {
         } else {
           contract_ = true;
           ContEngine_::init_vars();
+          TA_USER_ASSERT(ExprEngine_::vars_.is_permutation(target_vars),
+              "MultEngine::init_vars(): indices shared by both arguments and the result (batch indices) are not supported by the * operator, use einsum() instead");
           ContEngine_::perm_vars(target_vars);
         }
       }
@@ -434,6 +437,8 @@ namespace TiledArray {
         } else {
           contract_ = true;
           ContEngine_::init_vars();
+          TA_USER_ASSERT(ExprEngine_::vars_.is_permutation(target_vars),
+              "MultEngine::init_vars(): indices shared by both arguments and the result (batch indices) are not supported by the * operator, use einsum() instead");
           ContEngine_::perm_vars(target_vars);
         }
       }
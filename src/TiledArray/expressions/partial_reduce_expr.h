@@ -0,0 +1,403 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  partial_reduce_expr.h
+ *  Nov 18, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_EXPRESSIONS_PARTIAL_REDUCE_EXPR_H__INCLUDED
+#define TILEDARRAY_EXPRESSIONS_PARTIAL_REDUCE_EXPR_H__INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <TiledArray/expressions/variable_list.h>
+#include <TiledArray/math/partial_reduce.h>
+#include <TiledArray/reduce_task.h>
+#include <TiledArray/tensor/complex.h>
+#include <TiledArray/dense_shape.h>
+#include <TiledArray/sparse_shape.h>
+#include <TiledArray/tiled_range.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Partial sum reduction
+
+    /// Partial reduction operations define the element reduction
+    /// (\c reduce), the reduction of two partial results (\c combine), the
+    /// post-processing step (\c finalize), and an upper bound of the norm of
+    /// the reduced vector, given the Frobenius norm of the reduced slab and
+    /// the number of elements reduced into each result element (\c bound).
+    /// Only reductions for which zero tiles do not contribute are supported.
+    struct PartialSum {
+      template <typename T, typename U>
+      static void reduce(T& result, const U arg) { result += arg; }
+      template <typename T>
+      static void combine(T& result, const T arg) { result += arg; }
+      template <typename T>
+      static T finalize(const T arg) { return arg; }
+      static float bound(const float norm, const std::size_t volume) {
+        return std::sqrt(float(volume)) * norm;
+      }
+    }; // struct PartialSum
+
+    /// Partial squared norm reduction
+    struct PartialSquaredNorm {
+      template <typename T, typename U>
+      static void reduce(T& result, const U arg) { result += TiledArray::detail::norm(arg); }
+      template <typename T>
+      static void combine(T& result, const T arg) { result += arg; }
+      template <typename T>
+      static T finalize(const T arg) { return arg; }
+      static float bound(const float norm, const std::size_t) { return norm * norm; }
+    }; // struct PartialSquaredNorm
+
+    /// Partial (2-)norm reduction
+    struct PartialNorm {
+      template <typename T, typename U>
+      static void reduce(T& result, const U arg) { result += TiledArray::detail::norm(arg); }
+      template <typename T>
+      static void combine(T& result, const T arg) { result += arg; }
+      template <typename T>
+      static T finalize(const T arg) { using std::sqrt; return sqrt(arg); }
+      static float bound(const float norm, const std::size_t) { return norm; }
+    }; // struct PartialNorm
+
+    /// Partial absolute maximum reduction
+    struct PartialAbsMax {
+      template <typename T, typename U>
+      static void reduce(T& result, const U arg) {
+        using std::abs;
+        result = std::max(result, T(abs(arg)));
+      }
+      template <typename T>
+      static void combine(T& result, const T arg) { result = std::max(result, arg); }
+      template <typename T>
+      static T finalize(const T arg) { return arg; }
+      static float bound(const float norm, const std::size_t) { return norm; }
+    }; // struct PartialAbsMax
+
+    /// Reduce the trailing dimensions of a tile
+
+    /// \tparam Op The partial reduction operation
+    /// \tparam Result The result tile type
+    /// \tparam Arg The argument tile type
+    /// \param arg The argument tile
+    /// \param range The range of the result tile
+    /// \return A tile with range \c range, that holds the reduction of the
+    /// trailing dimensions of \c arg
+    template <typename Op, typename Result, typename Arg>
+    Result partial_reduce_tile(const Arg& arg,
+        const typename Result::range_type& range)
+    {
+      typedef typename Result::numeric_type numeric_type;
+      Result result(range, numeric_type(0));
+      const std::size_t m = result.size();
+      const std::size_t n = arg.size() / m;
+      math::row_reduce(m, n, arg.data(), result.data(),
+          [] (numeric_type& MADNESS_RESTRICT r, const typename Arg::numeric_type a)
+          { Op::reduce(r, a); });
+      return result;
+    }
+
+    /// Reduction task operation that combines the tile-local partial reductions
+
+    /// \tparam Op The partial reduction operation
+    /// \tparam Tile The tile type
+    template <typename Op, typename Tile>
+    class PartialReduceTileOp {
+    public:
+      typedef Tile result_type; ///< The result type
+      typedef Tile argument_type; ///< The argument type
+      typedef typename Tile::numeric_type numeric_type; ///< The element type
+
+    private:
+      typename Tile::range_type range_; ///< The range of the result tile
+
+    public:
+      PartialReduceTileOp() = default;
+      PartialReduceTileOp(const PartialReduceTileOp&) = default;
+      PartialReduceTileOp& operator=(const PartialReduceTileOp&) = default;
+
+      /// Constructor
+
+      /// \param range The range of the result tile
+      PartialReduceTileOp(const typename Tile::range_type& range) :
+        range_(range)
+      { }
+
+      // Make an empty result object
+      result_type operator()() const { return result_type(); }
+
+      // Post process the result
+      result_type operator()(const result_type& result) const {
+        return result.unary([] (const numeric_type arg)
+            { return Op::finalize(arg); });
+      }
+
+      // Reduce an argument or a result object; partial tiles differ from
+      // the result only by trailing dimensions of extent one, hence the data
+      // layout is the same
+      void operator()(result_type& result, const argument_type& arg) const {
+        if(result.empty()) {
+          result = result_type(range_, arg.data());
+          return;
+        }
+        TA_ASSERT(result.size() == arg.size());
+        auto* MADNESS_RESTRICT const r = result.data();
+        const auto* MADNESS_RESTRICT const a = arg.data();
+        for(std::size_t i = 0ul; i < result.size(); ++i)
+          Op::combine(r[i], a[i]);
+      }
+
+    }; // class PartialReduceTileOp
+
+    /// Shape of the tile-local partial reductions
+
+    /// \return A dense shape
+    inline DenseShape partial_reduce_shape(const DenseShape&, const TiledRange&)
+    { return DenseShape(); }
+
+    /// Shape of the tile-local partial reductions
+
+    /// The partial results carry the (unscaled) norms of the argument tiles
+    /// they were reduced from, which are used to bound the norms of the
+    /// result tiles.
+    /// \param arg The shape of the argument, with the reduced dimensions trailing
+    /// \param trange The tiled range of the partial reductions
+    /// \return The shape of the partial reductions
+    template <typename T>
+    inline SparseShape<T> partial_reduce_shape(const SparseShape<T>& arg,
+        const TiledRange& trange)
+    {
+      return SparseShape<T>(arg.tile_norms(), trange);
+    }
+
+  } // namespace detail
+
+  namespace expressions {
+
+    template <typename, bool> class TsrExpr;
+
+    /// Partial reduction expression
+
+    /// A partial reduction reduces a tensor over a subset of its indices, e.g.
+    /// \code
+    /// v("i") = a("i,j").sum("j");
+    /// n("j") = a("i,j").norm("i");
+    /// \endcode
+    /// Tiles are first reduced locally, by the process that owns them. The
+    /// partial results are then combined along the reduced tile dimensions
+    /// by the owner of each result tile, which fetches only the non-zero
+    /// partial results from their owners.
+    /// \tparam Array The array type
+    /// \tparam Op The partial reduction operation
+    template <typename Array, typename Op>
+    class PartialReduceExpr {
+    public:
+      typedef PartialReduceExpr<Array, Op> PartialReduceExpr_; ///< This class type
+      typedef Array array_type; ///< The array type
+
+    private:
+      array_type array_; ///< The argument array (a shallow copy)
+      std::string vars_; ///< The variable list of the argument
+      std::string reduce_vars_; ///< The variables to be reduced
+
+    public:
+
+      /// Constructor
+
+      /// \param array The argument array
+      /// \param vars The variable list of the argument
+      /// \param reduce_vars The variables to be reduced
+      PartialReduceExpr(const array_type& array, const std::string& vars,
+          const std::string& reduce_vars) :
+        array_(array), vars_(vars), reduce_vars_(reduce_vars)
+      { }
+
+      /// Evaluate this expression and assign the result to \c tsr
+
+      /// \tparam A The result array type
+      /// \tparam Alias The aliasing flag of the result expression
+      /// \param tsr The result tensor expression
+      template <typename A, bool Alias>
+      void eval_to(TsrExpr<A, Alias>& tsr) const {
+        typedef std::remove_const_t<A> result_array_type;
+        typedef typename result_array_type::value_type value_type;
+        typedef typename result_array_type::policy_type policy_type;
+        static_assert(std::is_same<policy_type,
+            typename array_type::policy_type>::value,
+            "PartialReduceExpr: the argument and result arrays must use the same policy");
+
+        const VariableList vars(vars_);
+        const VariableList reduce_vars(reduce_vars_);
+        const VariableList target_vars(tsr.vars());
+
+        // Split the argument variables into kept and reduced variables
+        std::vector<std::string> kept, reduced;
+        for(const auto& var : vars) {
+          if(std::find(reduce_vars.begin(), reduce_vars.end(), var) == reduce_vars.end())
+            kept.push_back(var);
+          else
+            reduced.push_back(var);
+        }
+        TA_USER_ASSERT(reduced.size() == reduce_vars.dim(),
+            "PartialReduceExpr: reduced indices must appear in the argument");
+        TA_USER_ASSERT(! kept.empty(),
+            "PartialReduceExpr: use the full reductions (e.g. sum()) to reduce all indices");
+        const VariableList kept_vars(kept.begin(), kept.end());
+        TA_USER_ASSERT(target_vars.is_permutation(kept_vars),
+            "PartialReduceExpr: the result indices do not match the unreduced argument indices");
+
+        // Permute the argument so that the reduced dimensions trail
+        std::vector<std::string> kept_reduced(kept);
+        kept_reduced.insert(kept_reduced.end(), reduced.begin(), reduced.end());
+        const VariableList arg_vars(kept_reduced.begin(), kept_reduced.end());
+        array_type arg;
+        if(vars == arg_vars)
+          arg = array_;
+        else
+          arg(arg_vars.string()) = array_(vars_);
+
+        World& world = arg.world();
+        const unsigned int kept_rank = kept.size();
+        const auto& arg_tr = arg.trange().data();
+
+        // The partial results are indexed by the argument tile indices; every
+        // reduced dimension is tiled with unit tiles
+        std::vector<TiledRange1> partial_tr(arg_tr.begin(), arg_tr.begin() + kept_rank);
+        std::size_t reduced_volume = 1ul;
+        for(unsigned int d = kept_rank; d < arg_tr.size(); ++d) {
+          const auto ntiles = arg_tr[d].tiles_range().second - arg_tr[d].tiles_range().first;
+          std::vector<std::size_t> bounds(ntiles + 1ul);
+          std::iota(bounds.begin(), bounds.end(), arg_tr[d].tiles_range().first);
+          partial_tr.emplace_back(bounds.begin(), bounds.end());
+          reduced_volume *= arg_tr[d].extent();
+        }
+        const TiledRange partial_trange(partial_tr.begin(), partial_tr.end());
+        TA_ASSERT(partial_trange.tiles_range() == arg.trange().tiles_range());
+
+        // Step 1: tile-local reductions
+        result_array_type partial(world, partial_trange,
+            detail::partial_reduce_shape(arg.shape(), partial_trange),
+            arg.pmap());
+        for(const auto ord : *partial.pmap()) {
+          if(partial.is_zero(ord)) continue;
+          TA_ASSERT(! arg.is_zero(ord));
+          partial.set(ord, world.taskq.add(
+              & detail::partial_reduce_tile<Op, value_type,
+                  typename array_type::value_type>,
+              arg.find(ord), partial_trange.make_tile_range(ord)));
+        }
+
+        // Step 2: combine the partial results on the owner of the result tile
+        const TiledRange result_trange(partial_tr.begin(), partial_tr.begin() + kept_rank);
+        const auto& partial_tiles = partial_trange.tiles_range();
+        std::vector<std::size_t> r_lobound, r_upbound;
+        for(unsigned int d = kept_rank; d < partial_tiles.rank(); ++d) {
+          r_lobound.push_back(partial_tiles.lobound(d));
+          r_upbound.push_back(partial_tiles.upbound(d));
+        }
+        const Range r_range(r_lobound, r_upbound);
+
+        result_array_type result(world, result_trange,
+            make_result_shape(partial.shape(), result_trange, r_range, reduced_volume),
+            policy_type::default_pmap(world, result_trange.tiles_range().volume()));
+        std::vector<std::size_t> partial_idx(partial_tiles.rank());
+        for(const auto ord : *result.pmap()) {
+          if(result.is_zero(ord)) continue;
+
+          const auto range = result_trange.make_tile_range(ord);
+          const auto idx = result_trange.tiles_range().idx(ord);
+          std::copy(idx.begin(), idx.end(), partial_idx.begin());
+
+          detail::ReduceTask<detail::PartialReduceTileOp<Op, value_type> >
+              reduce_task(world, detail::PartialReduceTileOp<Op, value_type>(range));
+          std::size_t count = 0ul;
+          for(const auto& r_idx : r_range) {
+            std::copy(r_idx.begin(), r_idx.end(), partial_idx.begin() + kept_rank);
+            if(partial.is_zero(partial_idx)) continue;
+            reduce_task.add(partial.find(partial_idx));
+            ++count;
+          }
+
+          if(count)
+            result.set(ord, reduce_task.submit());
+          else
+            result.set(ord, value_type(range, typename value_type::numeric_type(0)));
+        }
+
+        if(target_vars == kept_vars)
+          tsr.array() = result;
+        else
+          tsr = result(kept_vars.string());
+      }
+
+    private:
+
+      /// \return A dense shape
+      static DenseShape make_result_shape(const DenseShape&, const TiledRange&,
+          const Range&, const std::size_t)
+      { return DenseShape(); }
+
+      /// Shape of the result
+
+      /// \param partial The shape of the partial results
+      /// \param trange The tiled range of the result
+      /// \param r_range The range of the reduced tile indices
+      /// \param reduced_volume The number of elements reduced into each
+      /// result element
+      /// \return The result shape
+      template <typename T>
+      static SparseShape<T> make_result_shape(const SparseShape<T>& partial,
+          const TiledRange& trange, const Range& r_range,
+          const std::size_t reduced_volume)
+      {
+        // the partial results carry the argument tile norms, from which the
+        // Frobenius norm of each reduced slab of the argument is computed
+        const auto& partial_norms = partial.tile_norms();
+        const auto& partial_range = partial_norms.range();
+        Tensor<T> norms(trange.tiles_range(), T(0));
+        std::vector<std::size_t> partial_idx(partial_range.rank());
+        for(std::size_t ord = 0ul; ord < norms.size(); ++ord) {
+          const auto idx = trange.tiles_range().idx(ord);
+          std::copy(idx.begin(), idx.end(), partial_idx.begin());
+          T slab = 0;
+          for(const auto& r_idx : r_range) {
+            std::copy(r_idx.begin(), r_idx.end(), partial_idx.begin() + idx.size());
+            const T norm = partial_norms[partial_idx];
+            slab += norm * norm;
+          }
+          norms[ord] = Op::bound(std::sqrt(slab), reduced_volume);
+        }
+        return SparseShape<T>(norms, trange);
+      }
+
+    }; // class PartialReduceExpr
+
+  } // namespace expressions
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXPRESSIONS_PARTIAL_REDUCE_EXPR_H__INCLUDED
@@ -32,6 +32,8 @@
 #include <TiledArray/expressions/tsr_engine.h>
 #include <TiledArray/expressions/blk_tsr_expr.h>
 #include <TiledArray/expressions/scal_tsr_expr.h>
+#include <TiledArray/expressions/partial_reduce_expr.h>
+#include <TiledArray/expressions/diagonal_expr.h>
 
 namespace TiledArray {
   namespace expressions {
@@ -131,6 +133,28 @@ namespace TiledArray {
         return array_;
       }
 
+      /// Partial reduction assignment operator
+
+      /// \tparam A The argument array type
+      /// \tparam Op The partial reduction operation
+      /// \param other The partial reduction that will be assigned to this array
+      template <typename A, typename Op>
+      array_type& operator=(const PartialReduceExpr<A, Op>& other) {
+        other.eval_to(*this);
+        return array_;
+      }
+
+      /// Contraction with an implicit diagonal matrix assignment operator
+
+      /// \tparam A The argument array type
+      /// \tparam T The diagonal element type
+      /// \param other The scaling that will be assigned to this array
+      template <typename A, typename T>
+      array_type& operator=(const DiagonalScaleExpr<A, T>& other) {
+        other.eval_to(*this);
+        return array_;
+      }
+
       /// Expression plus-assignment operator
 
       /// \tparam D The derived expression type
@@ -233,6 +257,48 @@ namespace TiledArray {
         return ConjTsrExpr<Array>(array_, vars_, conj_op());
       }
 
+      using Expr_::sum;
+      using Expr_::squared_norm;
+      using Expr_::norm;
+      using Expr_::abs_max;
+
+      /// Partial sum expression
+
+      /// \param reduce_vars The variables to be summed over, e.g. \c "j" in
+      /// \c a("i,j").sum("j")
+      /// \return A partial reduction expression
+      PartialReduceExpr<std::remove_const_t<array_type>, TiledArray::detail::PartialSum>
+      sum(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial squared-norm expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<std::remove_const_t<array_type>, TiledArray::detail::PartialSquaredNorm>
+      squared_norm(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial (2-)norm expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<std::remove_const_t<array_type>, TiledArray::detail::PartialNorm>
+      norm(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial absolute-maximum expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<std::remove_const_t<array_type>, TiledArray::detail::PartialAbsMax>
+      abs_max(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
       /// Tensor variable string accessor
 
       /// \return A const reference to the variable string for this tensor
@@ -317,6 +383,48 @@ namespace TiledArray {
       }
 
 
+      using Expr_::sum;
+      using Expr_::squared_norm;
+      using Expr_::norm;
+      using Expr_::abs_max;
+
+      /// Partial sum expression
+
+      /// \param reduce_vars The variables to be summed over, e.g. \c "j" in
+      /// \c a("i,j").sum("j")
+      /// \return A partial reduction expression
+      PartialReduceExpr<array_type, TiledArray::detail::PartialSum>
+      sum(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial squared-norm expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<array_type, TiledArray::detail::PartialSquaredNorm>
+      squared_norm(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial (2-)norm expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<array_type, TiledArray::detail::PartialNorm>
+      norm(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
+      /// Partial absolute-maximum expression
+
+      /// \param reduce_vars The variables to be reduced
+      /// \return A partial reduction expression
+      PartialReduceExpr<array_type, TiledArray::detail::PartialAbsMax>
+      abs_max(const std::string& reduce_vars) const {
+        return {array_, vars_, reduce_vars};
+      }
+
       /// Tensor variable string accessor
 
       /// \return A const reference to the variable string for this tensor
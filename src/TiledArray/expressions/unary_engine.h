@@ -127,6 +127,7 @@ namespace TiledArray {
       /// for the left-hand, right-hand, and result tensor.
       /// \param target_vars The target variable list for the result tensor
       void init_struct(const VariableList& target_vars) {
+        ShapeThresholdScope threshold_scope(ExprEngine_::threshold());
         arg_.init_struct(ExprEngine_::vars());
         ExprEngine_::init_struct(target_vars);
       }
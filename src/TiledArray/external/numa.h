@@ -0,0 +1,183 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  numa.h
+ *  Dec 10, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_EXTERNAL_NUMA_H__INCLUDED
+#define TILEDARRAY_EXTERNAL_NUMA_H__INCLUDED
+
+#include <TiledArray/config.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef TILEDARRAY_HAS_NUMA
+#include <numa.h>
+#include <numaif.h>
+#include <sched.h>
+#include <unistd.h>
+#endif  // TILEDARRAY_HAS_NUMA
+
+namespace TiledArray {
+
+  /// Placement policy of tile data on the NUMA nodes of a rank
+
+  /// The policy is applied to the pages of a tile when its data is
+  /// allocated, i.e. before any element is written. It has effect only if
+  /// TiledArray was configured with \c ENABLE_NUMA=ON and libnuma reports a
+  /// NUMA system; otherwise all policies are equivalent to \c first_touch .
+  enum class NumaPolicy {
+    first_touch, ///< Pages are placed on the node of the thread that first writes them (the OS default)
+    interleave,  ///< Pages are interleaved round-robin across all nodes
+    local        ///< Pages are placed on the node of the allocating thread, if it has free memory
+  };
+
+  namespace detail {
+
+    /// Read the initial NUMA policy from the \c TA_NUMA_POLICY environment variable
+
+    /// \return The policy named by \c TA_NUMA_POLICY (\c first_touch ,
+    /// \c interleave , or \c local ), or \c NumaPolicy::first_touch if the
+    /// variable is not set or not recognized
+    inline NumaPolicy numa_policy_from_env() {
+      const char* value = std::getenv("TA_NUMA_POLICY");
+      if(value) {
+        if(std::strcmp(value, "interleave") == 0)
+          return NumaPolicy::interleave;
+        if(std::strcmp(value, "local") == 0)
+          return NumaPolicy::local;
+      }
+      return NumaPolicy::first_touch;
+    }
+
+    // the policy is read by every thread that allocates tile data, hence
+    // it is atomic
+    inline std::atomic<NumaPolicy>& numa_policy_accessor() {
+      static std::atomic<NumaPolicy> policy{numa_policy_from_env()};
+      return policy;
+    }
+
+    inline std::atomic<std::size_t>& numa_min_bytes_accessor() {
+      // smaller allocations share pages with other data and are left to the
+      // first-touch placement
+      static std::atomic<std::size_t> min_bytes{1ul << 16};
+      return min_bytes;
+    }
+
+    /// Apply the NUMA placement policy to newly allocated memory
+
+    /// Only the pages that lie entirely within <tt>[ptr, ptr + bytes)</tt>
+    /// are placed; pages that are shared with other allocations are left
+    /// alone. The memory must not have been written since it was allocated,
+    /// otherwise pages that are already resident stay where they are.
+    /// \param ptr A pointer to the first byte of the allocation
+    /// \param bytes The size of the allocation in bytes
+    inline void numa_place(void* ptr, const std::size_t bytes) {
+#ifdef TILEDARRAY_HAS_NUMA
+      const NumaPolicy policy = numa_policy_accessor().load(std::memory_order_relaxed);
+      if((policy == NumaPolicy::first_touch) ||
+          (bytes < numa_min_bytes_accessor().load(std::memory_order_relaxed)))
+        return;
+      static const bool numa = (numa_available() != -1) && (numa_max_node() > 0);
+      if(! numa)
+        return;
+
+      static const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+      const std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(ptr) + page_size - 1u) & ~(page_size - 1u);
+      const std::uintptr_t last = (reinterpret_cast<std::uintptr_t>(ptr) + bytes) & ~(page_size - 1u);
+      if(last <= first)
+        return;
+
+      if(policy == NumaPolicy::interleave) {
+        mbind(reinterpret_cast<void*>(first), last - first, MPOL_INTERLEAVE,
+            numa_all_nodes_ptr->maskp, numa_all_nodes_ptr->size + 1u, 0u);
+      } else {
+        const int cpu = sched_getcpu();
+        const int node = (cpu < 0 ? -1 : numa_node_of_cpu(cpu));
+        if(node < 0)
+          return;
+        struct bitmask* nodes = numa_allocate_nodemask();
+        numa_bitmask_setbit(nodes, node);
+        // Prefer, rather than bind to, the local node so that allocations
+        // fall back to other nodes instead of failing when it is full
+        mbind(reinterpret_cast<void*>(first), last - first, MPOL_PREFERRED,
+            nodes->maskp, nodes->size + 1u, 0u);
+        numa_free_nodemask(nodes);
+      }
+#endif  // TILEDARRAY_HAS_NUMA
+    }
+
+    /// Query the NUMA node of a page
+
+    /// \param ptr A pointer into a page that has been written
+    /// \return The NUMA node on which the page that contains \c ptr
+    /// resides, or -1 if it cannot be determined
+    inline int numa_node_of(const void* ptr) {
+#ifdef TILEDARRAY_HAS_NUMA
+      int node = -1;
+      if(get_mempolicy(&node, nullptr, 0ul, const_cast<void*>(ptr),
+          MPOL_F_NODE | MPOL_F_ADDR) != 0)
+        return -1;
+      return node;
+#else
+      return -1;
+#endif  // TILEDARRAY_HAS_NUMA
+    }
+
+  } // namespace detail
+
+  /// Set the NUMA placement policy of tile data
+
+  /// The policy applies to tiles allocated after this call; tiles that are
+  /// allocated concurrently by running tasks see either the old or the new
+  /// policy. The initial policy is read from the \c TA_NUMA_POLICY
+  /// environment variable. With \c NumaPolicy::local pages are preferably,
+  /// not strictly, placed on the local node (\c MPOL_PREFERRED ).
+  /// \param policy The placement policy
+  /// \param min_bytes Allocations smaller than this are always placed by
+  /// first touch
+  inline void set_numa_policy(const NumaPolicy policy,
+      const std::size_t min_bytes = 1ul << 16)
+  {
+    detail::numa_min_bytes_accessor() = min_bytes;
+    detail::numa_policy_accessor() = policy;
+  }
+
+  /// \return The NUMA placement policy of tile data
+  inline NumaPolicy numa_policy() { return detail::numa_policy_accessor().load(); }
+
+  /// \return \c true if NUMA placement policies take effect on this system
+  inline bool numa_enabled() {
+#ifdef TILEDARRAY_HAS_NUMA
+    return (numa_available() != -1) && (numa_max_node() > 0);
+#else
+    return false;
+#endif  // TILEDARRAY_HAS_NUMA
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXTERNAL_NUMA_H__INCLUDED
@@ -9,6 +9,7 @@
 #include <TiledArray/config.h>
 
 #include <TiledArray/external/madness.h>
+#include <TiledArray/topology.h>
 #ifdef TILEDARRAY_HAS_CUDA
 #include <TiledArray/external/cuda.h>
 #include <TiledArray/math/cublas.h>
@@ -86,6 +87,7 @@ inline World& initialize(int& argc, char**& argv, const SafeMPI::Intracomm& comm
             ? madness::initialize(argc, argv, comm, quiet)
             : *madness::World::find_instance(comm);
     TiledArray::set_default_world(default_world);
+    detail::init_topology(default_world);
 #ifdef TILEDARRAY_HAS_CUDA
     TiledArray::cuda_initialize();
 #endif
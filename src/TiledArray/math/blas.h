@@ -30,13 +30,104 @@
 #include <TiledArray/type_traits.h>
 #include <TiledArray/math/eigen.h>
 
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+#include <memory>
+
 namespace TiledArray {
+  namespace detail {
+
+    inline bool& gemm3m_accessor() {
+      static bool enabled = [] () {
+        const char* value = std::getenv("TA_GEMM_3M");
+        return (value != nullptr) && (std::atoi(value) != 0);
+      }();
+      return enabled;
+    }
+
+    /// Real element types with a BLAS implementation
+    template <typename T>
+    struct is_blas_real : public std::integral_constant<bool,
+        std::is_same<T, float>::value || std::is_same<T, double>::value> { };
+
+    /// Element types with a BLAS implementation
+    template <typename T>
+    struct is_blas_numeric : public is_blas_real<T> { };
+
+    template <typename T>
+    struct is_blas_numeric<std::complex<T> > : public is_blas_real<T> { };
+
+    /// Split a complex matrix into real and imaginary parts
+
+    /// \tparam T The real type
+    /// \param rows The number of rows of the matrix
+    /// \param cols The number of columns of the matrix
+    /// \param x The row-major matrix
+    /// \param ldx The leading dimension of \c x
+    /// \param conj If \c true , the parts of the complex conjugate of \c x
+    /// are stored
+    /// \param[out] re The real part, a <tt>rows x cols</tt> row-major matrix
+    /// \param[out] im The imaginary part, a <tt>rows x cols</tt> row-major matrix
+    /// \param[out] sum <tt>re + im</tt>, if not null
+    template <typename T>
+    inline void split_complex(const integer rows, const integer cols,
+        const std::complex<T>* x, const integer ldx, const bool conj,
+        T* MADNESS_RESTRICT re, T* MADNESS_RESTRICT im, T* MADNESS_RESTRICT sum)
+    {
+      const T sign = (conj ? T(-1) : T(1));
+      for(integer i = 0; i < rows; ++i, x += ldx) {
+        for(integer j = 0; j < cols; ++j, ++re, ++im) {
+          *re = x[j].real();
+          *im = sign * x[j].imag();
+        }
+        if(sum) {
+          for(integer j = cols; j > 0; --j, ++sum)
+            *sum = re[-j] + im[-j];
+        }
+      }
+    }
+
+    /// Scale and accumulate a complex matrix stored as real and imaginary parts
+
+    /// Evaluates <tt>C = alpha * (re + i * im) + beta * C</tt> ; \c C is not
+    /// read if \c beta is zero.
+    /// \tparam T The real type
+    /// \param m The number of rows of \c C
+    /// \param n The number of columns of \c C
+    /// \param alpha The scaling factor
+    /// \param re The real part, a <tt>m x n</tt> row-major matrix
+    /// \param im The imaginary part, a <tt>m x n</tt> row-major matrix
+    /// \param beta The scaling factor of \c C
+    /// \param c The row-major result matrix
+    /// \param ldc The leading dimension of \c c
+    template <typename T>
+    inline void combine_complex(const integer m, const integer n,
+        const std::complex<T> alpha, const T* re, const T* im,
+        const std::complex<T> beta, std::complex<T>* c, const integer ldc)
+    {
+      const bool beta_is_nonzero = (beta != std::complex<T>(0));
+      for(integer i = 0; i < m; ++i, c += ldc) {
+        for(integer j = 0; j < n; ++j, ++re, ++im) {
+          const std::complex<T> value = alpha * std::complex<T>(*re, *im);
+          c[j] = (beta_is_nonzero ? value + beta * c[j] : value);
+        }
+      }
+    }
+
+  }  // namespace detail
+
   namespace math {
 
     // BLAS _GEMM wrapper functions
 
+    /// GEMM with Eigen
+
+    /// Evaluates <tt>C = alpha * op(A) * op(B) + beta * C</tt> for any
+    /// combination of element types, e.g. integers or mixed types that have
+    /// no BLAS implementation.
     template <typename S1, typename T1, typename T2, typename S2, typename T3>
-    inline void gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
+    inline void gemm_eigen(madness::cblas::CBLAS_TRANSPOSE op_a,
         madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
         const integer k, const S1 alpha, const T1* a, const integer lda,
         const T2* b, const integer ldb, const S2 beta, T3* c, const integer ldc)
@@ -145,13 +236,106 @@ namespace TiledArray {
       madness::cblas::gemm(op_b, op_a, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
     }
 
+    /// The smallest matrix dimension of a complex GEMM evaluated with \c gemm3m()
+    constexpr integer gemm3m_min_size = 128;
+
+    /// Enable or disable the 3M algorithm for complex GEMM
+
+    /// The 3M algorithm trades accuracy of the imaginary part for speed, so it
+    /// is opt-in: the initial value is read from the \c TA_GEMM_3M
+    /// environment variable [ default = 0 ].
+    /// \param enable \c true to evaluate large complex GEMMs with \c gemm3m()
+    inline void set_gemm3m(const bool enable) {
+      detail::gemm3m_accessor() = enable;
+    }
+
+    /// \return \c true if large complex GEMMs are evaluated with \c gemm3m()
+    inline bool gemm3m_enabled() { return detail::gemm3m_accessor(); }
+
+    /// \param m The number of rows of the result
+    /// \param n The number of columns of the result
+    /// \param k The number of contracted elements
+    /// \return \c true if a complex GEMM of this size is evaluated with
+    /// \c gemm3m()
+    inline bool gemm3m_profitable(const integer m, const integer n, const integer k) {
+      return gemm3m_enabled() && (std::min(std::min(m, n), k) >= gemm3m_min_size);
+    }
+
+    /// Complex GEMM with three real GEMMs
+
+    /// Evaluates <tt>C = alpha * op(A) * op(B) + beta * C</tt> with the 3M
+    /// algorithm: with <tt>A = Ar + i Ai</tt> and <tt>B = Br + i Bi</tt> ,
+    /// \code
+    /// T1 = Ar * Br, T2 = Ai * Bi, T3 = (Ar + Ai) * (Br + Bi)
+    /// A * B = (T1 - T2) + i (T3 - T1 - T2)
+    /// \endcode
+    /// which needs 25% fewer floating-point operations than a complex GEMM,
+    /// at the cost of splitting the arguments and slightly larger rounding
+    /// errors in the imaginary part. \c ConjTrans is applied while splitting
+    /// the arguments, and \c alpha and \c beta while combining the result.
+    /// \tparam T The real type
+    template <typename T>
+    inline void gemm3m(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const std::complex<T> alpha, const std::complex<T>* a,
+        const integer lda, const std::complex<T>* b, const integer ldb,
+        const std::complex<T> beta, std::complex<T>* c, const integer ldc)
+    {
+      static_assert(detail::is_blas_real<T>::value,
+          "gemm3m<T>: T must be float or double");
+
+      const integer rows_a = (op_a == madness::cblas::NoTrans ? m : k);
+      const integer cols_a = (op_a == madness::cblas::NoTrans ? k : m);
+      const integer rows_b = (op_b == madness::cblas::NoTrans ? k : n);
+      const integer cols_b = (op_b == madness::cblas::NoTrans ? n : k);
+      const std::size_t mk = std::size_t(m) * std::size_t(k);
+      const std::size_t kn = std::size_t(k) * std::size_t(n);
+      const std::size_t mn = std::size_t(m) * std::size_t(n);
+
+      std::unique_ptr<T[]> a_parts(new T[3ul * mk]);
+      std::unique_ptr<T[]> b_parts(new T[3ul * kn]);
+      std::unique_ptr<T[]> t(new T[3ul * mn]);
+      T* const ar = a_parts.get();
+      T* const ai = ar + mk;
+      T* const as = ai + mk;
+      T* const br = b_parts.get();
+      T* const bi = br + kn;
+      T* const bs = bi + kn;
+      T* const t1 = t.get();
+      T* const t2 = t1 + mn;
+      T* const t3 = t2 + mn;
+
+      detail::split_complex(rows_a, cols_a, a, lda,
+          op_a == madness::cblas::ConjTrans, ar, ai, as);
+      detail::split_complex(rows_b, cols_b, b, ldb,
+          op_b == madness::cblas::ConjTrans, br, bi, bs);
+
+      const madness::cblas::CBLAS_TRANSPOSE real_op_a =
+          (op_a == madness::cblas::NoTrans ? madness::cblas::NoTrans : madness::cblas::Trans);
+      const madness::cblas::CBLAS_TRANSPOSE real_op_b =
+          (op_b == madness::cblas::NoTrans ? madness::cblas::NoTrans : madness::cblas::Trans);
+      gemm(real_op_a, real_op_b, m, n, k, T(1), ar, cols_a, br, cols_b, T(0), t1, n);
+      gemm(real_op_a, real_op_b, m, n, k, T(1), ai, cols_a, bi, cols_b, T(0), t2, n);
+      gemm(real_op_a, real_op_b, m, n, k, T(1), as, cols_a, bs, cols_b, T(0), t3, n);
+
+      // t1 = real part, t3 = imaginary part
+      for(std::size_t i = 0ul; i < mn; ++i) {
+        t3[i] -= t1[i] + t2[i];
+        t1[i] -= t2[i];
+      }
+      detail::combine_complex(m, n, alpha, t1, t3, beta, c, ldc);
+    }
+
     inline void gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
         madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
         const integer k, const std::complex<float> alpha, const std::complex<float>* a,
         const integer lda, const std::complex<float>* b, const integer ldb,
         const std::complex<float> beta, std::complex<float>* c, const integer ldc)
     {
-      madness::cblas::gemm(op_b, op_a, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
+      if(gemm3m_profitable(m, n, k))
+        gemm3m(op_a, op_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+      else
+        madness::cblas::gemm(op_b, op_a, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
     }
 
     inline void gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
@@ -160,9 +344,158 @@ namespace TiledArray {
         const integer lda, const std::complex<double>* b, const integer ldb,
         const std::complex<double> beta, std::complex<double>* c, const integer ldc)
     {
-      madness::cblas::gemm(op_b, op_a, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
+      if(gemm3m_profitable(m, n, k))
+        gemm3m(op_a, op_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+      else
+        madness::cblas::gemm(op_b, op_a, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
     }
 
+  }  // namespace math
+
+  namespace detail {
+
+    /// GEMM of a real and a complex matrix with real GEMMs
+
+    /// If \c B is not transposed and the scaling factors are real, the
+    /// interleaved real and imaginary parts of \c B and \c C are treated as
+    /// a real matrix with twice as many columns, and one real GEMM is used.
+    /// Otherwise \c B is split, and the real and imaginary parts of the
+    /// product are computed with two real GEMMs.
+    /// \tparam T The real type
+    template <typename T>
+    inline void gemm_real_complex(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const std::complex<T> alpha, const T* a, const integer lda,
+        const std::complex<T>* b, const integer ldb, const std::complex<T> beta,
+        std::complex<T>* c, const integer ldc)
+    {
+      if((op_b == madness::cblas::NoTrans) && (alpha.imag() == T(0)) && (beta.imag() == T(0))) {
+        math::gemm(op_a, op_b, m, 2 * n, k, alpha.real(), a, lda,
+            reinterpret_cast<const T*>(b), 2 * ldb, beta.real(),
+            reinterpret_cast<T*>(c), 2 * ldc);
+        return;
+      }
+
+      const integer rows_b = (op_b == madness::cblas::NoTrans ? k : n);
+      const integer cols_b = (op_b == madness::cblas::NoTrans ? n : k);
+      const std::size_t kn = std::size_t(k) * std::size_t(n);
+      const std::size_t mn = std::size_t(m) * std::size_t(n);
+      std::unique_ptr<T[]> b_parts(new T[2ul * kn]);
+      std::unique_ptr<T[]> result(new T[2ul * mn]);
+      split_complex(rows_b, cols_b, b, ldb, op_b == madness::cblas::ConjTrans,
+          b_parts.get(), b_parts.get() + kn, static_cast<T*>(nullptr));
+
+      const madness::cblas::CBLAS_TRANSPOSE real_op_b =
+          (op_b == madness::cblas::NoTrans ? madness::cblas::NoTrans : madness::cblas::Trans);
+      math::gemm(op_a, real_op_b, m, n, k, T(1), a, lda, b_parts.get(), cols_b,
+          T(0), result.get(), n);
+      math::gemm(op_a, real_op_b, m, n, k, T(1), a, lda, b_parts.get() + kn, cols_b,
+          T(0), result.get() + mn, n);
+      combine_complex(m, n, alpha, result.get(), result.get() + mn, beta, c, ldc);
+    }
+
+    /// GEMM of a complex and a real matrix with two real GEMMs
+
+    /// \tparam T The real type
+    template <typename T>
+    inline void gemm_complex_real(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const std::complex<T> alpha, const std::complex<T>* a,
+        const integer lda, const T* b, const integer ldb, const std::complex<T> beta,
+        std::complex<T>* c, const integer ldc)
+    {
+      const integer rows_a = (op_a == madness::cblas::NoTrans ? m : k);
+      const integer cols_a = (op_a == madness::cblas::NoTrans ? k : m);
+      const std::size_t mk = std::size_t(m) * std::size_t(k);
+      const std::size_t mn = std::size_t(m) * std::size_t(n);
+      std::unique_ptr<T[]> a_parts(new T[2ul * mk]);
+      std::unique_ptr<T[]> result(new T[2ul * mn]);
+      split_complex(rows_a, cols_a, a, lda, op_a == madness::cblas::ConjTrans,
+          a_parts.get(), a_parts.get() + mk, static_cast<T*>(nullptr));
+
+      const madness::cblas::CBLAS_TRANSPOSE real_op_a =
+          (op_a == madness::cblas::NoTrans ? madness::cblas::NoTrans : madness::cblas::Trans);
+      math::gemm(real_op_a, op_b, m, n, k, T(1), a_parts.get(), cols_a, b, ldb,
+          T(0), result.get(), n);
+      math::gemm(real_op_a, op_b, m, n, k, T(1), a_parts.get() + mk, cols_a, b, ldb,
+          T(0), result.get() + mn, n);
+      combine_complex(m, n, alpha, result.get(), result.get() + mn, beta, c, ldc);
+    }
+
+    /// The implementations of GEMM
+    enum class GemmPath { eigen, blas, real_complex, complex_real };
+
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void gemm(std::integral_constant<GemmPath, GemmPath::eigen>,
+        madness::cblas::CBLAS_TRANSPOSE op_a, madness::cblas::CBLAS_TRANSPOSE op_b,
+        const integer m, const integer n, const integer k, const S1 alpha,
+        const T1* a, const integer lda, const T2* b, const integer ldb,
+        const S2 beta, T3* c, const integer ldc)
+    {
+      math::gemm_eigen(op_a, op_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void gemm(std::integral_constant<GemmPath, GemmPath::blas>,
+        madness::cblas::CBLAS_TRANSPOSE op_a, madness::cblas::CBLAS_TRANSPOSE op_b,
+        const integer m, const integer n, const integer k, const S1 alpha,
+        const T1* a, const integer lda, const T2* b, const integer ldb,
+        const S2 beta, T3* c, const integer ldc)
+    {
+      math::gemm(op_a, op_b, m, n, k, T3(alpha), a, lda, b, ldb, T3(beta), c, ldc);
+    }
+
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void gemm(std::integral_constant<GemmPath, GemmPath::real_complex>,
+        madness::cblas::CBLAS_TRANSPOSE op_a, madness::cblas::CBLAS_TRANSPOSE op_b,
+        const integer m, const integer n, const integer k, const S1 alpha,
+        const T1* a, const integer lda, const T2* b, const integer ldb,
+        const S2 beta, T3* c, const integer ldc)
+    {
+      gemm_real_complex(op_a, op_b, m, n, k, T3(alpha), a, lda, b, ldb, T3(beta), c, ldc);
+    }
+
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void gemm(std::integral_constant<GemmPath, GemmPath::complex_real>,
+        madness::cblas::CBLAS_TRANSPOSE op_a, madness::cblas::CBLAS_TRANSPOSE op_b,
+        const integer m, const integer n, const integer k, const S1 alpha,
+        const T1* a, const integer lda, const T2* b, const integer ldb,
+        const S2 beta, T3* c, const integer ldc)
+    {
+      gemm_complex_real(op_a, op_b, m, n, k, T3(alpha), a, lda, b, ldb, T3(beta), c, ldc);
+    }
+
+  }  // namespace detail
+
+  namespace math {
+
+    /// GEMM of any element types
+
+    /// Evaluates <tt>C = alpha * op(A) * op(B) + beta * C</tt> for row-major
+    /// matrices. If all matrices have the same BLAS element type the scaling
+    /// factors are converted to it and BLAS is used; if one argument is real
+    /// and the other one and the result are complex, real BLAS GEMMs are used;
+    /// otherwise the product is evaluated with Eigen.
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const S1 alpha, const T1* a, const integer lda,
+        const T2* b, const integer ldb, const S2 beta, T3* c, const integer ldc)
+    {
+      constexpr bool scalars = std::is_convertible<S1, T3>::value &&
+          std::is_convertible<S2, T3>::value;
+      constexpr detail::GemmPath path = (! scalars ? detail::GemmPath::eigen :
+          (std::is_same<T1, T3>::value && std::is_same<T2, T3>::value &&
+              detail::is_blas_numeric<T3>::value ? detail::GemmPath::blas :
+          (std::is_same<std::complex<T1>, T3>::value && std::is_same<T2, T3>::value &&
+              detail::is_blas_real<T1>::value ? detail::GemmPath::real_complex :
+          (std::is_same<T1, T3>::value && std::is_same<std::complex<T2>, T3>::value &&
+              detail::is_blas_real<T2>::value ? detail::GemmPath::complex_real :
+              detail::GemmPath::eigen))));
+
+      detail::gemm(std::integral_constant<detail::GemmPath, path>(), op_a, op_b,
+          m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
 
     // BLAS _SCAL wrapper functions
 
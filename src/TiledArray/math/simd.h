@@ -0,0 +1,666 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  simd.h
+ *  Dec 13, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_MATH_SIMD_H__INCLUDED
+#define TILEDARRAY_MATH_SIMD_H__INCLUDED
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// Explicit SIMD kernels are compiled for x86 with GCC-compatible compilers,
+// which can generate code for an instruction set that is not enabled for the
+// translation unit and detect the instruction sets of the CPU at run time.
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__)) && ! defined(__INTEL_COMPILER)
+#define TILEDARRAY_HAS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace TiledArray {
+  namespace math {
+    namespace simd {
+
+      /// Instruction sets of the SIMD kernels
+      enum class Isa {
+        scalar, ///< Portable C++ loops
+        sse2,   ///< 128-bit SSE2
+        avx2,   ///< 256-bit AVX2 with FMA
+        avx512  ///< 512-bit AVX-512F
+      };
+
+      /// Element-wise binary operations of the SIMD kernels
+      enum class BinaryOp {
+        add,  ///< <tt>result[i] += arg[i]</tt>
+        subt, ///< <tt>result[i] -= arg[i]</tt>
+        mult  ///< <tt>result[i] *= arg[i]</tt>
+      };
+
+      /// Element types of the SIMD kernels
+
+      /// \tparam T The element type
+      template <typename T>
+      struct is_simd_type : public std::integral_constant<bool,
+          std::is_same<T, float>::value || std::is_same<T, double>::value> { };
+
+      /// The kernels of one instruction set
+
+      /// \tparam T The element type
+      template <typename T>
+      struct Kernels {
+        typedef void (*scale_fn)(std::size_t, T, T*);
+        typedef void (*binary_fn)(std::size_t, T, const T*, T*);
+        typedef T (*sum_fn)(std::size_t, const T*);
+        typedef T (*dot_fn)(std::size_t, const T*, const T*);
+
+        scale_fn scale; ///< <tt>x[i] *= factor</tt>
+        binary_fn binary[3][2]; ///< <tt>y[i] = (y[i] op x[i]) [* factor]</tt>, indexed by [op][scaled]
+        sum_fn sum; ///< Sum of <tt>x[i]</tt>
+        dot_fn dot; ///< Sum of <tt>x[i] * y[i]</tt>
+      }; // struct Kernels
+
+      namespace detail {
+
+        template <BinaryOp Op, typename T>
+        inline T apply(const T left, const T right) {
+          return (Op == BinaryOp::add ? left + right :
+              (Op == BinaryOp::subt ? left - right : left * right));
+        }
+
+        namespace scalar {
+
+          template <typename T>
+          void scale(const std::size_t n, const T factor, T* const x) {
+            for(std::size_t i = 0ul; i < n; ++i)
+              x[i] *= factor;
+          }
+
+          template <BinaryOp Op, bool Scaled, typename T>
+          void binary(const std::size_t n, const T factor, const T* const x, T* const y) {
+            for(std::size_t i = 0ul; i < n; ++i) {
+              y[i] = apply<Op>(y[i], x[i]);
+              if(Scaled) y[i] *= factor;
+            }
+          }
+
+          template <typename T>
+          T sum(const std::size_t n, const T* const x) {
+            T result = 0;
+            for(std::size_t i = 0ul; i < n; ++i)
+              result += x[i];
+            return result;
+          }
+
+          template <typename T>
+          T dot(const std::size_t n, const T* const x, const T* const y) {
+            T result = 0;
+            for(std::size_t i = 0ul; i < n; ++i)
+              result += x[i] * y[i];
+            return result;
+          }
+
+        } // namespace scalar
+
+#ifdef TILEDARRAY_HAS_X86_SIMD
+
+        // The kernels of each instruction set are written with overloaded
+        // vector primitives. Every function that uses the intrinsics of an
+        // instruction set carries its target attribute, so that the code is
+        // generated for it independently of the compiler flags.
+
+        namespace sse2 {
+
+#define TILEDARRAY_SIMD_TARGET __attribute__((target("sse2")))
+
+          TILEDARRAY_SIMD_TARGET inline __m128d load(const double* p) { return _mm_loadu_pd(p); }
+          TILEDARRAY_SIMD_TARGET inline __m128 load(const float* p) { return _mm_loadu_ps(p); }
+          TILEDARRAY_SIMD_TARGET inline void store(double* p, const __m128d v) { _mm_storeu_pd(p, v); }
+          TILEDARRAY_SIMD_TARGET inline void store(float* p, const __m128 v) { _mm_storeu_ps(p, v); }
+          TILEDARRAY_SIMD_TARGET inline __m128d set1(const double a) { return _mm_set1_pd(a); }
+          TILEDARRAY_SIMD_TARGET inline __m128 set1(const float a) { return _mm_set1_ps(a); }
+          TILEDARRAY_SIMD_TARGET inline __m128d add(const __m128d a, const __m128d b) { return _mm_add_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128 add(const __m128 a, const __m128 b) { return _mm_add_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128d sub(const __m128d a, const __m128d b) { return _mm_sub_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128 sub(const __m128 a, const __m128 b) { return _mm_sub_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128d mul(const __m128d a, const __m128d b) { return _mm_mul_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128 mul(const __m128 a, const __m128 b) { return _mm_mul_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m128d madd(const __m128d a, const __m128d b, const __m128d c)
+          { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+          TILEDARRAY_SIMD_TARGET inline __m128 madd(const __m128 a, const __m128 b, const __m128 c)
+          { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+          TILEDARRAY_SIMD_TARGET inline double hsum(const __m128d v)
+          { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+          TILEDARRAY_SIMD_TARGET inline float hsum(const __m128 v) {
+            const __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 sums = _mm_add_ps(v, shuf);
+            return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuf, sums)));
+          }
+
+          template <typename T>
+          using vec = decltype(load(static_cast<const T*>(nullptr)));
+
+          template <BinaryOp Op, typename V>
+          TILEDARRAY_SIMD_TARGET inline V apply(const V left, const V right) {
+            return (Op == BinaryOp::add ? add(left, right) :
+                (Op == BinaryOp::subt ? sub(left, right) : mul(left, right)));
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET void scale(const std::size_t n, const T factor, T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width)
+              store(x + i, mul(load(x + i), f));
+            for(; i < n; ++i)
+              x[i] *= factor;
+          }
+
+          template <BinaryOp Op, bool Scaled, typename T>
+          TILEDARRAY_SIMD_TARGET void binary(const std::size_t n, const T factor,
+              const T* const x, T* const y)
+          {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width) {
+              vec<T> result = apply<Op>(load(y + i), load(x + i));
+              if(Scaled) result = mul(result, f);
+              store(y + i, result);
+            }
+            for(; i < n; ++i) {
+              y[i] = detail::apply<Op>(y[i], x[i]);
+              if(Scaled) y[i] *= factor;
+            }
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T sum(const std::size_t n, const T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = add(s0, load(x + i));
+              s1 = add(s1, load(x + i + width));
+              s2 = add(s2, load(x + i + 2ul * width));
+              s3 = add(s3, load(x + i + 3ul * width));
+            }
+            for(; i + width <= n; i += width)
+              s0 = add(s0, load(x + i));
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i];
+            return result;
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T dot(const std::size_t n, const T* const x, const T* const y) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = madd(load(x + i), load(y + i), s0);
+              s1 = madd(load(x + i + width), load(y + i + width), s1);
+              s2 = madd(load(x + i + 2ul * width), load(y + i + 2ul * width), s2);
+              s3 = madd(load(x + i + 3ul * width), load(y + i + 3ul * width), s3);
+            }
+            for(; i + width <= n; i += width)
+              s0 = madd(load(x + i), load(y + i), s0);
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i] * y[i];
+            return result;
+          }
+
+#undef TILEDARRAY_SIMD_TARGET
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#define TILEDARRAY_SIMD_TARGET __attribute__((target("avx2,fma")))
+
+          TILEDARRAY_SIMD_TARGET inline __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+          TILEDARRAY_SIMD_TARGET inline __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+          TILEDARRAY_SIMD_TARGET inline void store(double* p, const __m256d v) { _mm256_storeu_pd(p, v); }
+          TILEDARRAY_SIMD_TARGET inline void store(float* p, const __m256 v) { _mm256_storeu_ps(p, v); }
+          TILEDARRAY_SIMD_TARGET inline __m256d set1(const double a) { return _mm256_set1_pd(a); }
+          TILEDARRAY_SIMD_TARGET inline __m256 set1(const float a) { return _mm256_set1_ps(a); }
+          TILEDARRAY_SIMD_TARGET inline __m256d add(const __m256d a, const __m256d b) { return _mm256_add_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256 add(const __m256 a, const __m256 b) { return _mm256_add_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256d sub(const __m256d a, const __m256d b) { return _mm256_sub_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256 sub(const __m256 a, const __m256 b) { return _mm256_sub_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256d mul(const __m256d a, const __m256d b) { return _mm256_mul_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256 mul(const __m256 a, const __m256 b) { return _mm256_mul_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m256d madd(const __m256d a, const __m256d b, const __m256d c)
+          { return _mm256_fmadd_pd(a, b, c); }
+          TILEDARRAY_SIMD_TARGET inline __m256 madd(const __m256 a, const __m256 b, const __m256 c)
+          { return _mm256_fmadd_ps(a, b, c); }
+          TILEDARRAY_SIMD_TARGET inline double hsum(const __m256d v) {
+            const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+          }
+          TILEDARRAY_SIMD_TARGET inline float hsum(const __m256 v) {
+            const __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            const __m128 shuf = _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 sums = _mm_add_ps(s, shuf);
+            return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuf, sums)));
+          }
+
+          template <typename T>
+          using vec = decltype(load(static_cast<const T*>(nullptr)));
+
+          template <BinaryOp Op, typename V>
+          TILEDARRAY_SIMD_TARGET inline V apply(const V left, const V right) {
+            return (Op == BinaryOp::add ? add(left, right) :
+                (Op == BinaryOp::subt ? sub(left, right) : mul(left, right)));
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET void scale(const std::size_t n, const T factor, T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width)
+              store(x + i, mul(load(x + i), f));
+            for(; i < n; ++i)
+              x[i] *= factor;
+          }
+
+          template <BinaryOp Op, bool Scaled, typename T>
+          TILEDARRAY_SIMD_TARGET void binary(const std::size_t n, const T factor,
+              const T* const x, T* const y)
+          {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width) {
+              vec<T> result = apply<Op>(load(y + i), load(x + i));
+              if(Scaled) result = mul(result, f);
+              store(y + i, result);
+            }
+            for(; i < n; ++i) {
+              y[i] = detail::apply<Op>(y[i], x[i]);
+              if(Scaled) y[i] *= factor;
+            }
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T sum(const std::size_t n, const T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = add(s0, load(x + i));
+              s1 = add(s1, load(x + i + width));
+              s2 = add(s2, load(x + i + 2ul * width));
+              s3 = add(s3, load(x + i + 3ul * width));
+            }
+            for(; i + width <= n; i += width)
+              s0 = add(s0, load(x + i));
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i];
+            return result;
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T dot(const std::size_t n, const T* const x, const T* const y) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = madd(load(x + i), load(y + i), s0);
+              s1 = madd(load(x + i + width), load(y + i + width), s1);
+              s2 = madd(load(x + i + 2ul * width), load(y + i + 2ul * width), s2);
+              s3 = madd(load(x + i + 3ul * width), load(y + i + 3ul * width), s3);
+            }
+            for(; i + width <= n; i += width)
+              s0 = madd(load(x + i), load(y + i), s0);
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i] * y[i];
+            return result;
+          }
+
+#undef TILEDARRAY_SIMD_TARGET
+
+        } // namespace avx2
+
+        namespace avx512 {
+
+#define TILEDARRAY_SIMD_TARGET __attribute__((target("avx512f")))
+
+          TILEDARRAY_SIMD_TARGET inline __m512d load(const double* p) { return _mm512_loadu_pd(p); }
+          TILEDARRAY_SIMD_TARGET inline __m512 load(const float* p) { return _mm512_loadu_ps(p); }
+          TILEDARRAY_SIMD_TARGET inline void store(double* p, const __m512d v) { _mm512_storeu_pd(p, v); }
+          TILEDARRAY_SIMD_TARGET inline void store(float* p, const __m512 v) { _mm512_storeu_ps(p, v); }
+          TILEDARRAY_SIMD_TARGET inline __m512d set1(const double a) { return _mm512_set1_pd(a); }
+          TILEDARRAY_SIMD_TARGET inline __m512 set1(const float a) { return _mm512_set1_ps(a); }
+          TILEDARRAY_SIMD_TARGET inline __m512d add(const __m512d a, const __m512d b) { return _mm512_add_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512 add(const __m512 a, const __m512 b) { return _mm512_add_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512d sub(const __m512d a, const __m512d b) { return _mm512_sub_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512 sub(const __m512 a, const __m512 b) { return _mm512_sub_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512d mul(const __m512d a, const __m512d b) { return _mm512_mul_pd(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512 mul(const __m512 a, const __m512 b) { return _mm512_mul_ps(a, b); }
+          TILEDARRAY_SIMD_TARGET inline __m512d madd(const __m512d a, const __m512d b, const __m512d c)
+          { return _mm512_fmadd_pd(a, b, c); }
+          TILEDARRAY_SIMD_TARGET inline __m512 madd(const __m512 a, const __m512 b, const __m512 c)
+          { return _mm512_fmadd_ps(a, b, c); }
+          // The 512-bit reductions are spilled, since the shuffle intrinsics
+          // of some GCC versions warn about uninitialized variables
+          TILEDARRAY_SIMD_TARGET inline double hsum(const __m512d v) {
+            double a[8];
+            _mm512_storeu_pd(a, v);
+            return ((a[0] + a[4]) + (a[1] + a[5])) + ((a[2] + a[6]) + (a[3] + a[7]));
+          }
+          TILEDARRAY_SIMD_TARGET inline float hsum(const __m512 v) {
+            float a[16];
+            _mm512_storeu_ps(a, v);
+            float result = 0.0f;
+            for(int i = 0; i < 8; ++i)
+              result += a[i] + a[i + 8];
+            return result;
+          }
+
+          template <typename T>
+          using vec = decltype(load(static_cast<const T*>(nullptr)));
+
+          template <BinaryOp Op, typename V>
+          TILEDARRAY_SIMD_TARGET inline V apply(const V left, const V right) {
+            return (Op == BinaryOp::add ? add(left, right) :
+                (Op == BinaryOp::subt ? sub(left, right) : mul(left, right)));
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET void scale(const std::size_t n, const T factor, T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width)
+              store(x + i, mul(load(x + i), f));
+            for(; i < n; ++i)
+              x[i] *= factor;
+          }
+
+          template <BinaryOp Op, bool Scaled, typename T>
+          TILEDARRAY_SIMD_TARGET void binary(const std::size_t n, const T factor,
+              const T* const x, T* const y)
+          {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            const vec<T> f = set1(factor);
+            std::size_t i = 0ul;
+            for(; i + width <= n; i += width) {
+              vec<T> result = apply<Op>(load(y + i), load(x + i));
+              if(Scaled) result = mul(result, f);
+              store(y + i, result);
+            }
+            for(; i < n; ++i) {
+              y[i] = detail::apply<Op>(y[i], x[i]);
+              if(Scaled) y[i] *= factor;
+            }
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T sum(const std::size_t n, const T* const x) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = add(s0, load(x + i));
+              s1 = add(s1, load(x + i + width));
+              s2 = add(s2, load(x + i + 2ul * width));
+              s3 = add(s3, load(x + i + 3ul * width));
+            }
+            for(; i + width <= n; i += width)
+              s0 = add(s0, load(x + i));
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i];
+            return result;
+          }
+
+          template <typename T>
+          TILEDARRAY_SIMD_TARGET T dot(const std::size_t n, const T* const x, const T* const y) {
+            constexpr std::size_t width = sizeof(vec<T>) / sizeof(T);
+            vec<T> s0 = set1(T(0)), s1 = s0, s2 = s0, s3 = s0;
+            std::size_t i = 0ul;
+            for(; i + 4ul * width <= n; i += 4ul * width) {
+              s0 = madd(load(x + i), load(y + i), s0);
+              s1 = madd(load(x + i + width), load(y + i + width), s1);
+              s2 = madd(load(x + i + 2ul * width), load(y + i + 2ul * width), s2);
+              s3 = madd(load(x + i + 3ul * width), load(y + i + 3ul * width), s3);
+            }
+            for(; i + width <= n; i += width)
+              s0 = madd(load(x + i), load(y + i), s0);
+            T result = hsum(add(add(s0, s1), add(s2, s3)));
+            for(; i < n; ++i)
+              result += x[i] * y[i];
+            return result;
+          }
+
+#undef TILEDARRAY_SIMD_TARGET
+
+        } // namespace avx512
+
+#endif // TILEDARRAY_HAS_X86_SIMD
+
+// Fill the kernel table of one instruction set
+#define TILEDARRAY_SIMD_KERNELS( ISA ) \
+          kernels.scale = & ISA::scale<T>; \
+          kernels.binary[0][0] = & ISA::binary<BinaryOp::add, false, T>; \
+          kernels.binary[0][1] = & ISA::binary<BinaryOp::add, true, T>; \
+          kernels.binary[1][0] = & ISA::binary<BinaryOp::subt, false, T>; \
+          kernels.binary[1][1] = & ISA::binary<BinaryOp::subt, true, T>; \
+          kernels.binary[2][0] = & ISA::binary<BinaryOp::mult, false, T>; \
+          kernels.binary[2][1] = & ISA::binary<BinaryOp::mult, true, T>; \
+          kernels.sum = & ISA::sum<T>; \
+          kernels.dot = & ISA::dot<T>
+
+        /// Construct the kernel table of an instruction set
+
+        /// \tparam T The element type
+        /// \param isa The instruction set, which must be supported by this CPU
+        /// \return The kernels of \c isa
+        template <typename T>
+        Kernels<T> make_kernels(const Isa isa) {
+          Kernels<T> kernels;
+          switch(isa) {
+#ifdef TILEDARRAY_HAS_X86_SIMD
+            case Isa::avx512:
+              TILEDARRAY_SIMD_KERNELS(avx512);
+              break;
+            case Isa::avx2:
+              TILEDARRAY_SIMD_KERNELS(avx2);
+              break;
+            case Isa::sse2:
+              TILEDARRAY_SIMD_KERNELS(sse2);
+              break;
+#endif // TILEDARRAY_HAS_X86_SIMD
+            default:
+              TILEDARRAY_SIMD_KERNELS(scalar);
+          }
+          return kernels;
+        }
+
+#undef TILEDARRAY_SIMD_KERNELS
+
+        /// Detect the widest instruction set of this CPU
+
+        /// The result may be limited with the \c TA_SIMD environment variable,
+        /// which is one of \c scalar , \c sse2 , \c avx2 , or \c avx512 .
+        /// \return The instruction set of the SIMD kernels
+        inline Isa detect_isa() {
+          Isa isa = Isa::scalar;
+#ifdef TILEDARRAY_HAS_X86_SIMD
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx512f"))
+            isa = Isa::avx512;
+          else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            isa = Isa::avx2;
+          else if(__builtin_cpu_supports("sse2"))
+            isa = Isa::sse2;
+#endif // TILEDARRAY_HAS_X86_SIMD
+
+          const char* limit = std::getenv("TA_SIMD");
+          if(limit) {
+            Isa max_isa = isa;
+            if(std::strcmp(limit, "scalar") == 0)
+              max_isa = Isa::scalar;
+            else if(std::strcmp(limit, "sse2") == 0)
+              max_isa = Isa::sse2;
+            else if(std::strcmp(limit, "avx2") == 0)
+              max_isa = Isa::avx2;
+            if(max_isa < isa)
+              isa = max_isa;
+          }
+
+          return isa;
+        }
+
+      } // namespace detail
+
+      /// The instruction set of the SIMD kernels
+
+      /// This is the widest instruction set supported by the CPU that runs the
+      /// program, unless it is limited by the \c TA_SIMD environment variable.
+      /// It is detected once, on first use.
+      /// \return The instruction set used by the kernels
+      inline Isa isa() {
+        static const Isa isa = detail::detect_isa();
+        return isa;
+      }
+
+      namespace detail {
+
+        /// The kernels of the detected instruction set
+
+        /// \tparam T The element type
+        /// \return The kernel table, which is constructed on first use
+        template <typename T>
+        inline const Kernels<T>& kernels() {
+          static const Kernels<T> kernels = make_kernels<T>(isa());
+          return kernels;
+        }
+
+      } // namespace detail
+
+      /// \param isa An instruction set
+      /// \return The name of \c isa
+      inline const char* isa_name(const Isa isa) {
+        switch(isa) {
+          case Isa::sse2: return "sse2";
+          case Isa::avx2: return "avx2";
+          case Isa::avx512: return "avx512";
+          default: return "scalar";
+        }
+      }
+
+      /// Scale a vector
+
+      /// \tparam T The element type
+      /// \param n The size of the vector
+      /// \param factor The scaling factor
+      /// \param x The vector, which is set to <tt>x[i] * factor</tt>
+      template <typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline void scale_to(const std::size_t n, const T factor, T* const x) {
+        detail::kernels<T>().scale(n, factor, x);
+      }
+
+      /// Element-wise, in-place binary operation
+
+      /// \tparam Op The binary operation
+      /// \tparam T The element type
+      /// \param n The size of the vectors
+      /// \param arg The right-hand argument
+      /// \param result The left-hand argument, which is set to
+      /// <tt>result[i] op arg[i]</tt>
+      template <BinaryOp Op, typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline void inplace_binary(const std::size_t n, const T* const arg, T* const result) {
+        detail::kernels<T>().binary[static_cast<int>(Op)][0](n, T(1), arg, result);
+      }
+
+      /// Element-wise, in-place binary operation followed by scaling
+
+      /// \tparam Op The binary operation
+      /// \tparam T The element type
+      /// \param n The size of the vectors
+      /// \param arg The right-hand argument
+      /// \param result The left-hand argument, which is set to
+      /// <tt>(result[i] op arg[i]) * factor</tt>
+      /// \param factor The scaling factor
+      template <BinaryOp Op, typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline void inplace_binary(const std::size_t n, const T* const arg, T* const result,
+          const T factor)
+      {
+        detail::kernels<T>().binary[static_cast<int>(Op)][1](n, factor, arg, result);
+      }
+
+      /// Sum of the elements of a vector
+
+      /// \tparam T The element type
+      /// \param n The size of the vector
+      /// \param x The vector
+      /// \return The sum of <tt>x[i]</tt>
+      template <typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline T sum(const std::size_t n, const T* const x) {
+        return detail::kernels<T>().sum(n, x);
+      }
+
+      /// Dot product of two vectors
+
+      /// \tparam T The element type
+      /// \param n The size of the vectors
+      /// \param x The left-hand vector
+      /// \param y The right-hand vector
+      /// \return The sum of <tt>x[i] * y[i]</tt>
+      template <typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline T dot(const std::size_t n, const T* const x, const T* const y) {
+        return detail::kernels<T>().dot(n, x, y);
+      }
+
+      /// Square of the 2-norm of a vector
+
+      /// \tparam T The element type
+      /// \param n The size of the vector
+      /// \param x The vector
+      /// \return The sum of <tt>x[i] * x[i]</tt>
+      template <typename T,
+          typename std::enable_if<is_simd_type<T>::value>::type* = nullptr>
+      inline T squared_norm(const std::size_t n, const T* const x) {
+        return detail::kernels<T>().dot(n, x, x);
+      }
+
+    } // namespace simd
+  } // namespace math
+} // namespace TiledArray
+
+#endif // TILEDARRAY_MATH_SIMD_H__INCLUDED
@@ -0,0 +1,231 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  memory_usage.h
+ *  Dec 11, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_MEMORY_USAGE_H__INCLUDED
+#define TILEDARRAY_MEMORY_USAGE_H__INCLUDED
+
+#include <TiledArray/external/madness.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace TiledArray {
+
+  /// Categories of the tile memory that is accounted by TiledArray
+  enum class MemoryCategory {
+    tiles,         ///< Tile data allocated by any other code, e.g. array tiles and element-wise results
+    communication, ///< Tile data deserialized from archives, e.g. tiles received from other ranks and SUMMA broadcasts
+    reduce         ///< Tile data allocated by reduction tasks, e.g. partial sums of contractions
+  };
+
+  /// Current and peak memory use
+  struct MemoryUsage {
+    std::size_t current = 0ul; ///< The number of bytes in use
+    std::size_t peak = 0ul;    ///< The largest number of bytes in use since the last reset
+  }; // struct MemoryUsage
+
+  namespace detail {
+
+    /// The number of memory categories
+    constexpr std::size_t memory_categories = 3ul;
+
+    /// Memory counters of one category
+    struct MemoryCounter {
+      std::atomic<std::size_t> current{0ul}; ///< The number of bytes in use
+      std::atomic<std::size_t> peak{0ul};    ///< The peak number of bytes in use
+    }; // struct MemoryCounter
+
+    inline std::array<MemoryCounter, memory_categories>& memory_counters() {
+      static std::array<MemoryCounter, memory_categories> counters;
+      return counters;
+    }
+
+    inline MemoryCategory& memory_category_accessor() {
+      static thread_local MemoryCategory category = MemoryCategory::tiles;
+      return category;
+    }
+
+    /// \return The category of the memory allocated by this thread
+    inline MemoryCategory memory_category() { return memory_category_accessor(); }
+
+    /// Sets the category of the memory allocated by this thread in a scope
+    class MemoryCategoryScope {
+      MemoryCategory previous_; ///< The category of the enclosing scope
+
+    public:
+      MemoryCategoryScope(const MemoryCategoryScope&) = delete;
+      MemoryCategoryScope& operator=(const MemoryCategoryScope&) = delete;
+
+      /// Constructor
+
+      /// \param category The category of the memory allocated in this scope
+      explicit MemoryCategoryScope(const MemoryCategory category) :
+        previous_(memory_category_accessor())
+      { memory_category_accessor() = category; }
+
+      ~MemoryCategoryScope() { memory_category_accessor() = previous_; }
+    }; // class MemoryCategoryScope
+
+    /// Record an allocation
+
+    /// \param category The memory category
+    /// \param bytes The size of the allocation
+    inline void memory_allocated(const MemoryCategory category, const std::size_t bytes) {
+      MemoryCounter& counter = memory_counters()[static_cast<std::size_t>(category)];
+      const std::size_t current = (counter.current += bytes);
+      std::size_t peak = counter.peak.load(std::memory_order_relaxed);
+      while((current > peak) && ! counter.peak.compare_exchange_weak(peak, current,
+          std::memory_order_relaxed));
+    }
+
+    /// Record a deallocation
+
+    /// \param category The memory category of the allocation
+    /// \param bytes The size of the allocation
+    inline void memory_deallocated(const MemoryCategory category, const std::size_t bytes) {
+      memory_counters()[static_cast<std::size_t>(category)].current -= bytes;
+    }
+
+    /// Convert a memory size string to bytes
+
+    /// The size is a number followed by an optional unit: \c kB , \c KB ,
+    /// \c kiB , \c KiB , \c MB , \c MiB , \c GB , or \c GiB ; without a unit
+    /// the number is in bytes.
+    /// \param size The memory size string
+    /// \return The size in bytes, or 0 if \c size is not a positive number
+    inline double parse_memory_size(const char* size) {
+      std::stringstream ss(size);
+      double memory = 0.0;
+      if(ss >> memory) {
+        if(memory > 0.0) {
+          std::string unit;
+          if(ss >> unit) { // Failure == assume bytes
+            if(unit == "KB" || unit == "kB") {
+              memory *= 1000.0;
+            } else if(unit == "KiB" || unit == "kiB") {
+              memory *= 1024.0;
+            } else if(unit == "MB") {
+              memory *= 1000000.0;
+            } else if(unit == "MiB") {
+              memory *= 1048576.0;
+            } else if(unit == "GB") {
+              memory *= 1000000000.0;
+            } else if(unit == "GiB") {
+              memory *= 1073741824.0;
+            }
+          }
+        }
+      }
+      return std::max(memory, 0.0);
+    }
+
+    inline std::size_t& memory_budget_accessor() {
+      static std::size_t budget = [] () {
+        const char* budget = std::getenv("TA_MEMORY_BUDGET");
+        return (budget ? std::size_t(parse_memory_size(budget)) : 0ul);
+      }();
+      return budget;
+    }
+
+  } // namespace detail
+
+  /// Memory use of this rank in one category
+
+  /// \param category The memory category
+  /// \return The current and peak memory use of \c category
+  inline MemoryUsage memory_usage(const MemoryCategory category) {
+    const detail::MemoryCounter& counter =
+        detail::memory_counters()[static_cast<std::size_t>(category)];
+    MemoryUsage usage;
+    usage.current = counter.current.load();
+    usage.peak = counter.peak.load();
+    return usage;
+  }
+
+  /// Memory use of this rank in all categories
+
+  /// \return The current memory use, and the sum of the peaks of the
+  /// categories, which bounds the peak of the total
+  inline MemoryUsage memory_usage() {
+    MemoryUsage usage;
+    for(std::size_t c = 0ul; c < detail::memory_categories; ++c) {
+      const MemoryUsage category = memory_usage(static_cast<MemoryCategory>(c));
+      usage.current += category.current;
+      usage.peak += category.peak;
+    }
+    return usage;
+  }
+
+  /// Memory use of all ranks in one category
+
+  /// \note This is a collective operation.
+  /// \param world The world of the ranks
+  /// \param category The memory category
+  /// \return The sum of the current memory use, and the largest peak
+  /// memory use of any rank
+  inline MemoryUsage memory_usage(World& world, const MemoryCategory category) {
+    MemoryUsage usage = memory_usage(category);
+    world.gop.sum(usage.current);
+    world.gop.max(usage.peak);
+    return usage;
+  }
+
+  /// Reset the peak memory use of all categories to the current use
+  inline void reset_memory_peak() {
+    for(detail::MemoryCounter& counter : detail::memory_counters())
+      counter.peak = counter.current.load();
+  }
+
+  /// Set the memory budget of this rank
+
+  /// The budget bounds the tile memory that the engines plan for; e.g. the
+  /// SUMMA contraction reduces the number of concurrent iterations so that
+  /// the broadcast tiles fit in the part of the budget that is not in use.
+  /// It is not a hard limit on allocations. The initial budget is read from
+  /// the \c TA_MEMORY_BUDGET environment variable, e.g. \c "8 GiB" .
+  /// \param bytes The budget in bytes; 0 means no budget
+  inline void set_memory_budget(const std::size_t bytes) {
+    detail::memory_budget_accessor() = bytes;
+  }
+
+  /// \return The memory budget of this rank in bytes, or 0 if there is none
+  inline std::size_t memory_budget() { return detail::memory_budget_accessor(); }
+
+  /// \return The part of the memory budget of this rank that is not in use,
+  /// or 0 if there is no budget
+  inline std::size_t memory_available() {
+    const std::size_t budget = memory_budget();
+    const std::size_t current = memory_usage().current;
+    return (budget > current ? budget - current : 0ul);
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_MEMORY_USAGE_H__INCLUDED
@@ -28,6 +28,10 @@
 
 #include <TiledArray/pmap/pmap.h>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace TiledArray {
   namespace detail {
 
@@ -61,6 +65,8 @@ namespace TiledArray {
       size_type rank_col_ = 0;  ///< This rank's column in the process grid
       size_type local_rows_ = 0;  ///< The number of rows that belong to this rank
       size_type local_cols_ = 0;  ///< The number of columns that belong to this rank
+      std::shared_ptr<const std::vector<ProcessID> > ranks_; ///< The rank at
+                                  ///< each process grid position, if not the identity
 
     public:
       typedef Pmap::size_type size_type; ///< Size type
@@ -72,38 +78,46 @@ namespace TiledArray {
       /// \param cols The number of tile columns to be mapped
       /// \param proc_rows The number of process rows in the map
       /// \param proc_cols The number of process columns in the map
+      /// \param ranks The rank at each row-major process grid position; if
+      /// null, the process at position \c p is rank \c p
       /// \throw TiledArray::Exception When <tt>proc_rows > rows</tt>
       /// \throw TiledArray::Exception When <tt>proc_cols > cols</tt>
       /// \throw TiledArray::Exception When <tt>proc_rows * proc_cols > world.size()</tt>
       CyclicPmap(World& world, size_type rows, size_type cols,
-          size_type proc_rows, size_type proc_cols) :
+          size_type proc_rows, size_type proc_cols,
+          const std::shared_ptr<const std::vector<ProcessID> >& ranks =
+              std::shared_ptr<const std::vector<ProcessID> >()) :
         Pmap(world, rows * cols), rows_(rows), cols_(cols),
-        proc_cols_(proc_cols), proc_rows_(proc_rows)
+        proc_cols_(proc_cols), proc_rows_(proc_rows), ranks_(ranks)
       {
-        // Check that the size is non-zero
-        TA_ASSERT(rows_ >= 1ul);
-        TA_ASSERT(cols_ >= 1ul);
-
-        // Check limits of process rows and columns
-        TA_ASSERT(proc_rows_ >= 1ul);
-        TA_ASSERT(proc_cols_ >= 1ul);
-        TA_ASSERT((proc_rows_ * proc_cols_) <= procs_);
+        init();
+      }
 
-        // Compute local size_, if have any
-        if(rank_ < (proc_rows_ * proc_cols_)) {
-          // Compute rank coordinates
-          rank_row_ = rank_ / proc_cols_;
-          rank_col_ = rank_ % proc_cols_;
+#ifdef TILEDARRAY_ENABLE_TEST_PROC_GRID
+      // Note: The following function is here for testing purposes only. It
+      // has the same functionality as the constructor above, except the
+      // rank and number of processes can be specified.
 
-          local_rows_ =
-              (rows_ / proc_rows_) + ((rows_ % proc_rows_) > rank_row_ ? 1ul : 0ul);
-          local_cols_ =
-              (cols_ / proc_cols_) + ((cols_ % proc_cols_) > rank_col_ ? 1ul : 0ul);
+      /// Construct process map
 
-          // Allocate memory for the local tile list
-          this->local_size_ = local_rows_ * local_cols_;
-        }
+      /// \param test_rank Test rank
+      /// \param test_nprocs Test number of procs
+      /// \param rows The number of tile rows to be mapped
+      /// \param cols The number of tile columns to be mapped
+      /// \param proc_rows The number of process rows in the map
+      /// \param proc_cols The number of process columns in the map
+      /// \param ranks The rank at each row-major process grid position; if
+      /// null, the process at position \c p is rank \c p
+      CyclicPmap(size_type test_rank, size_type test_nprocs,
+          size_type rows, size_type cols, size_type proc_rows, size_type proc_cols,
+          const std::shared_ptr<const std::vector<ProcessID> >& ranks =
+              std::shared_ptr<const std::vector<ProcessID> >()) :
+        Pmap(test_rank, test_nprocs, rows * cols), rows_(rows), cols_(cols),
+        proc_cols_(proc_cols), proc_rows_(proc_rows), ranks_(ranks)
+      {
+        init();
       }
+#endif // TILEDARRAY_ENABLE_TEST_PROC_GRID
 
       virtual ~CyclicPmap() { }
 
@@ -133,7 +147,7 @@ namespace TiledArray {
 
         TA_ASSERT(proc < procs_);
 
-        return proc;
+        return (ranks_ ? size_type((*ranks_)[proc]) : proc);
       }
 
       /// Check that the tile is owned by this process
@@ -146,6 +160,41 @@ namespace TiledArray {
 
      private:
 
+      /// Check the process grid and compute the local tiles of this rank
+      void init() {
+        // Check that the size is non-zero
+        TA_ASSERT(rows_ >= 1ul);
+        TA_ASSERT(cols_ >= 1ul);
+
+        // Check limits of process rows and columns
+        TA_ASSERT(proc_rows_ >= 1ul);
+        TA_ASSERT(proc_cols_ >= 1ul);
+        TA_ASSERT((proc_rows_ * proc_cols_) <= procs_);
+
+        // Find the position of this rank in the process grid
+        size_type position = rank_;
+        if(ranks_) {
+          TA_ASSERT(ranks_->size() == (proc_rows_ * proc_cols_));
+          position = std::distance(ranks_->begin(),
+              std::find(ranks_->begin(), ranks_->end(), ProcessID(rank_)));
+        }
+
+        // Compute local size_, if have any
+        if(position < (proc_rows_ * proc_cols_)) {
+          // Compute rank coordinates
+          rank_row_ = position / proc_cols_;
+          rank_col_ = position % proc_cols_;
+
+          local_rows_ =
+              (rows_ / proc_rows_) + ((rows_ % proc_rows_) > rank_row_ ? 1ul : 0ul);
+          local_cols_ =
+              (cols_ / proc_cols_) + ((cols_ % proc_cols_) > rank_col_ ? 1ul : 0ul);
+
+          // Allocate memory for the local tile list
+          this->local_size_ = local_rows_ * local_cols_;
+        }
+      }
+
       virtual void advance(size_type& value, bool increment) const {
         if (increment) {
           auto row = value / cols_;
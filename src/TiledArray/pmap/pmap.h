@@ -68,6 +68,20 @@ namespace TiledArray {
     Pmap(World& world, const size_type size) :
       rank_(world.rank()), procs_(world.size()), size_(size), local_(), local_size_(0) {}
 
+#ifdef TILEDARRAY_ENABLE_TEST_PROC_GRID
+    // Note: The following function is here for testing purposes only. It
+    // has the same functionality as the constructor above, except the
+    // rank and number of processes can be specified.
+
+    /// Process map constructor
+
+    /// \param test_rank Test rank
+    /// \param test_nprocs Test number of procs
+    /// \param size The number of tiles to be mapped
+    Pmap(const size_type test_rank, const size_type test_nprocs, const size_type size) :
+      rank_(test_rank), procs_(test_nprocs), size_(size), local_(), local_size_(0) {}
+#endif // TILEDARRAY_ENABLE_TEST_PROC_GRID
+
     virtual ~Pmap() { }
 
     /// Maps \c tile to the processor that owns it
@@ -0,0 +1,99 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  table_pmap.h
+ *  Dec 11, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_PMAP_TABLE_PMAP_H__INCLUDED
+#define TILEDARRAY_PMAP_TABLE_PMAP_H__INCLUDED
+
+#include <TiledArray/pmap/pmap.h>
+
+#include <memory>
+#include <vector>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Table process map
+
+    /// Defines a process map with an explicit owner for each tile, e.g. one
+    /// computed from the tile weights by \c rebalance() . The table is
+    /// replicated and must be the same on all processes.
+    class TablePmap : public Pmap {
+    protected:
+
+      // Import Pmap protected variables
+      using Pmap::rank_; ///< The rank of this process
+      using Pmap::procs_; ///< The number of processes
+      using Pmap::size_; ///< The number of tiles mapped among all processes
+      using Pmap::local_; ///< A list of local tiles
+
+    private:
+
+      std::shared_ptr<const std::vector<size_type> > owners_; ///< The owner of each tile
+
+    public:
+      typedef Pmap::size_type size_type; ///< Size type
+
+      /// Construct a table process map
+
+      /// \param world The world where the tiles are mapped
+      /// \param owners The owner of each tile
+      TablePmap(World& world, std::vector<size_type> owners) :
+        Pmap(world, owners.size()),
+        owners_(std::make_shared<const std::vector<size_type> >(std::move(owners)))
+      {
+        for(size_type tile = 0ul; tile < size_; ++tile) {
+          TA_ASSERT((*owners_)[tile] < procs_);
+          if((*owners_)[tile] == rank_)
+            local_.push_back(tile);
+        }
+        this->local_size_ = local_.size();
+      }
+
+      virtual ~TablePmap() { }
+
+      /// Maps \c tile to the processor that owns it
+
+      /// \param tile The tile to be queried
+      /// \return Processor that logically owns \c tile
+      virtual size_type owner(const size_type tile) const {
+        TA_ASSERT(tile < size_);
+        return (*owners_)[tile];
+      }
+
+      /// Check that the tile is owned by this process
+
+      /// \param tile The tile to be checked
+      /// \return \c true if \c tile is owned by this process, otherwise \c false .
+      virtual bool is_local(const size_type tile) const {
+        return TablePmap::owner(tile) == rank_;
+      }
+
+    }; // class TablePmap
+
+  } // namespace detail
+}  // namespace TiledArray
+
+
+#endif // TILEDARRAY_PMAP_TABLE_PMAP_H__INCLUDED
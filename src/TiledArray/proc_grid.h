@@ -28,6 +28,11 @@
 
 #include <TiledArray/pmap/cyclic_pmap.h>
 #include <TiledArray/math/eigen.h>
+#include <TiledArray/topology.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace TiledArray {
   namespace detail {
@@ -74,6 +79,8 @@ namespace TiledArray {
       size_type local_rows_; ///< The number of local element rows
       size_type local_cols_; ///< The number of local element columns
       size_type local_size_; ///< Number of local elements
+      std::shared_ptr<const std::vector<ProcessID> > ranks_; ///< The rank at
+                         ///< each process grid position, if not the identity
 
 
       /// Compute the number of process rows that minimizes communication
@@ -246,6 +253,69 @@ namespace TiledArray {
         }
       }
 
+      /// Place the rows or columns of the process grid within nodes
+
+      /// The ranks are ordered by node, and the process grid is filled with
+      /// them in row-major order if the row broadcasts of SUMMA (the
+      /// left-hand tiles) carry more data than the column broadcasts,
+      /// otherwise in column-major order. Either way, the larger broadcast is
+      /// confined to as few nodes as possible. The placement is skipped if
+      /// every rank is on a separate node, or all ranks are on one node.
+      /// \param rank The rank of this process
+      /// \param node_ids The node of each rank
+      /// \param row_size The number of element rows
+      /// \param col_size The number of element columns
+      void place_ranks(const size_type rank, const std::vector<ProcessID>& node_ids,
+          const std::size_t row_size, const std::size_t col_size)
+      {
+        const size_type nprocs = node_ids.size();
+        const ProcessID nnodes = *std::max_element(node_ids.begin(), node_ids.end()) + 1;
+        if((nnodes == 1) || (size_type(nnodes) == nprocs) || (proc_size_ == 1u))
+          return;
+
+        std::vector<ProcessID> by_node(nprocs);
+        for(size_type p = 0u; p < nprocs; ++p)
+          by_node[p] = p;
+        std::stable_sort(by_node.begin(), by_node.end(),
+            [&] (const ProcessID l, const ProcessID r)
+            { return node_ids[l] < node_ids[r]; });
+
+        const bool row_major = (double(row_size) * double(proc_cols_ - 1u)) >=
+            (double(col_size) * double(proc_rows_ - 1u));
+        std::vector<ProcessID> ranks(proc_size_);
+        for(size_type row = 0u; row < proc_rows_; ++row)
+          for(size_type col = 0u; col < proc_cols_; ++col)
+            ranks[row * proc_cols_ + col] =
+                by_node[row_major ? (row * proc_cols_ + col) : (col * proc_rows_ + row)];
+
+        bool identity = true;
+        for(size_type p = 0u; p < proc_size_; ++p)
+          identity = identity && (ranks[p] == ProcessID(p));
+        if(identity)
+          return;
+
+        // Set this process rank
+        const auto it = std::find(ranks.begin(), ranks.end(), ProcessID(rank));
+        if(it != ranks.end()) {
+          const size_type position = std::distance(ranks.begin(), it);
+          rank_row_ = position / proc_cols_;
+          rank_col_ = position % proc_cols_;
+
+          // Set local counts
+          local_rows_ = (rows_ / proc_rows_) + (size_type(rank_row_) < (rows_ % proc_rows_) ? 1u : 0u);
+          local_cols_ = (cols_ / proc_cols_) + (size_type(rank_col_) < (cols_ % proc_cols_) ? 1u : 0u);
+          local_size_ = local_rows_ * local_cols_;
+        } else {
+          rank_row_ = -1;
+          rank_col_ = -1;
+          local_rows_ = 0u;
+          local_cols_ = 0u;
+          local_size_ = 0u;
+        }
+
+        ranks_ = std::make_shared<const std::vector<ProcessID> >(std::move(ranks));
+      }
+
     public:
       /// Default constructor
 
@@ -253,7 +323,7 @@ namespace TiledArray {
       ProcGrid() :
         world_(NULL), rows_(0u), cols_(0u), size_(0u), proc_rows_(0u),
         proc_cols_(0u), proc_size_(0u), rank_row_(0), rank_col_(0),
-        local_rows_(0u), local_cols_(0u), local_size_(0u)
+        local_rows_(0u), local_cols_(0u), local_size_(0u), ranks_()
       { }
 
       /// Construct a process grid
@@ -271,7 +341,7 @@ namespace TiledArray {
         world_(&world), rows_(rows), cols_(cols), size_(rows_ * cols_),
         proc_rows_(0ul), proc_cols_(0ul), proc_size_(0ul),
         rank_row_(-1), rank_col_(-1),
-        local_rows_(0ul), local_cols_(0ul), local_size_(0ul)
+        local_rows_(0ul), local_cols_(0ul), local_size_(0ul), ranks_()
       {
         // Check for non-zero sizes
         TA_ASSERT(rows_ >= 1u);
@@ -280,6 +350,11 @@ namespace TiledArray {
         TA_ASSERT(col_size >= 1ul);
 
         init(world_->rank(), world_->size(), row_size, col_size);
+
+        // The node of each rank is known for the default world
+        if(topology_aware_placement() && (node_ids().size() == size_type(world_->size()))
+            && (world_ == default_world::query()))
+          place_ranks(world_->rank(), node_ids(), row_size, col_size);
       }
 
 #ifdef TILEDARRAY_ENABLE_TEST_PROC_GRID
@@ -305,7 +380,8 @@ namespace TiledArray {
           const std::size_t row_size, const std::size_t col_size) :
         world_(&world), rows_(rows), cols_(cols), size_(rows_ * cols_),
         proc_rows_(0u), proc_cols_(0u), proc_size_(0u), rank_row_(-1),
-        rank_col_(-1), local_rows_(0u), local_cols_(0u), local_size_(0u)
+        rank_col_(-1), local_rows_(0u), local_cols_(0u), local_size_(0u),
+        ranks_()
       {
         // Check for non-zero sizes
         TA_ASSERT(rows >= 1u);
@@ -316,6 +392,30 @@ namespace TiledArray {
 
         init(test_rank, test_nprocs, row_size, col_size);
       }
+
+      /// Construct a process grid with ranks placed within nodes
+
+      // This constructor is the same as the one above, except the node of each
+      // process is specified, instead of being read from the host names of
+      // the default world.
+      /// \param world The world where the process grid will live
+      /// \param test_rank Test rank
+      /// \param test_nprocs Test number of procs
+      /// \param rows The number of tile rows
+      /// \param cols The number of tile columns
+      /// \param row_size The number of element rows
+      /// \param col_size The number of element columns
+      /// \param test_node_ids The node of each test process
+      ProcGrid(World& world, const size_type test_rank, size_type test_nprocs,
+          const size_type rows, const size_type cols,
+          const std::size_t row_size, const std::size_t col_size,
+          const std::vector<ProcessID>& test_node_ids) :
+        ProcGrid(world, test_rank, test_nprocs, rows, cols, row_size, col_size)
+      {
+        TA_ASSERT(test_node_ids.size() == test_nprocs);
+
+        place_ranks(test_rank, test_node_ids, row_size, col_size);
+      }
 #endif // TILEDARRAY_ENABLE_TEST_PROC_GRID
 
       /// Copy constructor
@@ -330,7 +430,7 @@ namespace TiledArray {
         proc_cols_(other.proc_cols_), proc_size_(other.proc_size_),
         rank_row_(other.rank_row_), rank_col_(other.rank_col_),
         local_rows_(other.local_rows_), local_cols_(other.local_cols_),
-        local_size_(other.local_size_)
+        local_size_(other.local_size_), ranks_(other.ranks_)
       { }
 
       /// Copy assignment operator
@@ -349,6 +449,7 @@ namespace TiledArray {
         local_rows_ = other.local_rows_;
         local_cols_ = other.local_cols_;
         local_size_ = other.local_size_;
+        ranks_ = other.ranks_;
 
         return *this;
       }
@@ -428,7 +529,7 @@ namespace TiledArray {
           size_type p = rank_row_ * proc_cols_;
           const size_type row_end = p + proc_cols_;
           for(; p < row_end; ++p)
-            proc_list.push_back(p);
+            proc_list.push_back(map_proc(p));
 
           // Construct the group
           group = madness::Group(*world_, proc_list, did);
@@ -453,7 +554,7 @@ namespace TiledArray {
 
           // Populate the column process list
           for(size_type p = rank_col_; p < proc_size_; p += proc_cols_)
-            proc_list.push_back(p);
+            proc_list.push_back(map_proc(p));
 
           // Construct the group
           if(proc_list.size() != 0)
@@ -469,7 +570,7 @@ namespace TiledArray {
       /// \return The process the corresponds to the process coordinate \c (row,rank_col)
       ProcessID map_row(const size_type row) const {
         TA_ASSERT(row < proc_rows_);
-        return rank_col_ + row * proc_cols_;
+        return map_proc(rank_col_ + row * proc_cols_);
       }
 
       /// Map a column to the process in this process's row
@@ -478,9 +579,34 @@ namespace TiledArray {
       /// \return The process the corresponds to the process coordinate \c (rank_row,col)
       ProcessID map_col(const size_type col) const {
         TA_ASSERT(col < proc_cols_);
-        return rank_row_ * proc_cols_ + col;
+        return map_proc(rank_row_ * proc_cols_ + col);
       }
 
+      /// Map a process grid position to a process
+
+      /// \param position The row-major position in the process grid
+      /// \return The process at \c position
+      ProcessID map_proc(const size_type position) const {
+        TA_ASSERT(position < proc_size_);
+        return (ranks_ ? (*ranks_)[position] : ProcessID(position));
+      }
+
+      /// Map a process coordinate to a process
+
+      /// \param row The process row
+      /// \param col The process column
+      /// \return The process the corresponds to the process coordinate \c (row,col)
+      ProcessID map_proc(const size_type row, const size_type col) const {
+        TA_ASSERT(row < proc_rows_);
+        TA_ASSERT(col < proc_cols_);
+        return map_proc(row * proc_cols_ + col);
+      }
+
+      /// Process placement accessor
+
+      /// \return \c true if processes are not placed in the grid in rank order
+      bool is_reordered() const { return bool(ranks_); }
+
       /// Construct a cyclic process
 
       /// Construct a cyclic process map with the same phase as the process grid.
@@ -488,7 +614,7 @@ namespace TiledArray {
       std::shared_ptr<Pmap> make_pmap() const {
         TA_ASSERT(world_);
 
-        return std::make_shared<CyclicPmap>(*world_, rows_, cols_, proc_rows_, proc_cols_);
+        return std::make_shared<CyclicPmap>(*world_, rows_, cols_, proc_rows_, proc_cols_, ranks_);
       }
 
       /// Construct column phased a cyclic process
@@ -500,7 +626,7 @@ namespace TiledArray {
       std::shared_ptr<Pmap> make_col_phase_pmap(const size_type rows) const {
         TA_ASSERT(world_);
 
-        return std::make_shared<CyclicPmap>(*world_, rows, cols_, proc_rows_, proc_cols_);
+        return std::make_shared<CyclicPmap>(*world_, rows, cols_, proc_rows_, proc_cols_, ranks_);
       }
 
       /// Construct row phased a cyclic process
@@ -512,7 +638,7 @@ namespace TiledArray {
       std::shared_ptr<Pmap> make_row_phase_pmap(const size_type cols) const {
         TA_ASSERT(world_);
 
-        return std::make_shared<CyclicPmap>(*world_, rows_, cols, proc_rows_, proc_cols_);
+        return std::make_shared<CyclicPmap>(*world_, rows_, cols, proc_rows_, proc_cols_, ranks_);
       }
     }; // class Grid
 
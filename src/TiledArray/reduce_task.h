@@ -23,6 +23,8 @@
 #include <TiledArray/config.h>
 #include <TiledArray/error.h>
 #include <TiledArray/external/madness.h>
+#include <TiledArray/memory_usage.h>
+#include <atomic>
 
 #ifdef TILEDARRAY_HAS_CUDA
 #include <TiledArray/external/cuda.h>
@@ -196,6 +198,15 @@ namespace TiledArray {
     ///     }
     /// }; // struct VectorProduct
     /// \endcode
+    ///
+    /// By default, arguments that become ready at the same time are reduced
+    /// concurrently into separate partial results, which are combined later.
+    /// In the in-place mode, all arguments are reduced into a single result
+    /// object, one at a time: ready arguments are pushed onto a lock-free
+    /// stack, and the task that owns the result drains the stack. This trades
+    /// concurrency within one reduction for a single live result object, which
+    /// is preferable when the result is large (e.g. a tile of a contraction)
+    /// and many reductions run concurrently.
     /// \note There is no need to add this object to the MADNESS task queue. It
     /// will be handled internally by the object. Simply call \c submit() to add
     /// this task to the task queue.
@@ -227,6 +238,11 @@ namespace TiledArray {
           madness::CallbackInterface* callback_; ///< Reduction callback
           madness::AtomicInt count_; ///< Dependency counter
 
+        public:
+          ReduceObject* next_; ///< The next object in the stack of ready objects (in-place mode only)
+
+        private:
+
           /// Register a future as a dependency
 
           /// \tparam T The type of the future
@@ -267,7 +283,7 @@ namespace TiledArray {
           /// \param callback The callback to invoke when this argument has been reduced
           template <typename Arg>
           ReduceObject(ReduceTaskImpl* parent, const Arg& arg, madness::CallbackInterface* callback) :
-          parent_(parent), arg_(arg), callback_(callback)
+          parent_(parent), arg_(arg), callback_(callback), next_(nullptr)
           {
             TA_ASSERT(parent_);
             register_callbacks(arg_);
@@ -513,6 +529,8 @@ namespace TiledArray {
         /// \param result The target of the reduction
         /// \param object The reduction argument to be reduced
         void reduce_result_object(std::shared_ptr<result_type> result, const ReduceObject* object) {
+          MemoryCategoryScope scope(MemoryCategory::reduce);
+
           // Reduce the argument
           op_(*result, object->arg());
 
@@ -561,6 +579,8 @@ namespace TiledArray {
 
         /// Reduce two reduction arguments
         void reduce_object_object(const ReduceObject* object1, const ReduceObject* object2) {
+          MemoryCategoryScope scope(MemoryCategory::reduce);
+
           // Construct an empty result object
           auto result = std::make_shared<result_type>(op_());
 
@@ -619,6 +639,34 @@ namespace TiledArray {
 #endif
         }
 
+        /// Reduce the ready arguments into the result in place
+
+        /// The calling task owns \c ready_result_ ; it reduces the arguments
+        /// on the stack of ready objects until the stack is empty and no
+        /// other task has claimed the result.
+        void reduce_in_place() {
+          MemoryCategoryScope scope(MemoryCategory::reduce);
+          std::size_t n = 0ul;
+          do {
+            ReduceObject* object = ready_stack_.exchange(nullptr, std::memory_order_acquire);
+            while(object) {
+              ReduceObject* next = object->next_;
+              op_(*ready_result_, object->arg());
+              ReduceObject::destroy(object);
+              object = next;
+              ++n;
+            }
+            reducing_.store(false, std::memory_order_release);
+          } while(ready_stack_.load(std::memory_order_acquire)
+              && ! reducing_.exchange(true, std::memory_order_acquire));
+
+          // Decrement the dependency counter for the reduced arguments only
+          // after the result has been released, since this task may run (and
+          // be deleted) as soon as the counter reaches zero.
+          for(; n != 0ul; --n)
+            this->dec();
+        }
+
 #ifdef TILEDARRAY_HAS_CUDA
         template <typename Result = result_type>
         std::enable_if_t<detail::is_cuda_tile<Result>::value, void>
@@ -655,6 +703,9 @@ namespace TiledArray {
         Future<result_type> result_; ///< The result of the reduction task
         madness::Spinlock lock_; ///< Task lock
         madness::CallbackInterface* callback_; ///< The completion callback
+        const bool in_place_; ///< Reduce all arguments into \c ready_result_
+        std::atomic<ReduceObject*> ready_stack_; ///< Arguments that are ready to be reduced in place
+        std::atomic<bool> reducing_; ///< True while a task owns \c ready_result_ (in-place mode only)
 
       public:
 
@@ -664,10 +715,20 @@ namespace TiledArray {
         /// \param op The reduction operation
         /// \param callback The callback that will be invoked when this task
         /// has completed
-        ReduceTaskImpl(World& world, opT op, madness::CallbackInterface* callback) :
+        /// \param in_place Reduce all arguments into a single result object
+        ReduceTaskImpl(World& world, opT op, madness::CallbackInterface* callback,
+            const bool in_place) :
           madness::TaskInterface(1, TaskAttributes::hipri()),
           world_(world), op_(op), ready_result_(std::make_shared<result_type>(op())),
-          ready_object_(nullptr), result_(), lock_(), callback_(callback)
+          ready_object_(nullptr), result_(), lock_(), callback_(callback),
+#ifdef TILEDARRAY_HAS_CUDA
+          // CUDA reductions complete asynchronously, so the arguments cannot
+          // be released as they are reduced
+          in_place_(in_place && ! detail::is_cuda_tile<result_type>::value),
+#else
+          in_place_(in_place),
+#endif
+          ready_stack_(nullptr), reducing_(false)
         { }
 
         virtual ~ReduceTaskImpl() { }
@@ -685,6 +746,20 @@ namespace TiledArray {
         /// \param object The reduction object that is ready to be reduced
         void ready(ReduceObject* object) {
           TA_ASSERT(object);
+          if(in_place_) {
+            // Push object onto the ready stack, and claim the result if no
+            // other task is reducing into it
+            ReduceObject* head = ready_stack_.load(std::memory_order_relaxed);
+            do {
+              object->next_ = head;
+            } while(! ready_stack_.compare_exchange_weak(head, object,
+                std::memory_order_release, std::memory_order_relaxed));
+            if(! reducing_.exchange(true, std::memory_order_acquire))
+              world_.taskq.add(this, & ReduceTaskImpl::reduce_in_place,
+                  TaskAttributes::hipri());
+            return;
+          }
+
           lock_.lock(); // <<< Begin critical section
           if(ready_result_) {
             std::shared_ptr<result_type> ready_result = ready_result_;
@@ -734,9 +809,12 @@ namespace TiledArray {
       /// \param op The reduction operation [ default = opT() ]
       /// \param callback The callback that will be invoked when this task is
       /// complete
+      /// \param in_place Reduce all arguments into a single result object,
+      /// one at a time [ default = false ]
       ReduceTask(World& world, const opT& op = opT(),
-          madness::CallbackInterface* callback = nullptr) :
-        pimpl_(new ReduceTaskImpl(world, op, callback)), count_(0ul)
+          madness::CallbackInterface* callback = nullptr,
+          const bool in_place = false) :
+        pimpl_(new ReduceTaskImpl(world, op, callback, in_place)), count_(0ul)
       { }
 
       /// Move constructor
@@ -925,8 +1003,12 @@ namespace TiledArray {
       /// \param op The pair reduction operation [ default = opT() ]
       /// \param callback The callback that will be invoked when this task is
       /// complete
-      ReducePairTask(World& world, const opT& op = opT(), madness::CallbackInterface* callback = nullptr) :
-        ReduceTask_(world, op_type(op), callback)
+      /// \param in_place Reduce all argument pairs into a single result
+      /// object, one at a time [ default = false ]
+      ReducePairTask(World& world, const opT& op = opT(),
+          madness::CallbackInterface* callback = nullptr,
+          const bool in_place = false) :
+        ReduceTask_(world, op_type(op), callback, in_place)
       { }
 
       /// Move constructor
@@ -29,12 +29,52 @@
 #include <TiledArray/tensor.h>
 #include <TiledArray/tiled_range.h>
 #include <TiledArray/val_array.h>
+#include <TiledArray/subtile_norms.h>
 #include <TiledArray/tensor/shift_wrapper.h>
 #include <TiledArray/tensor/tensor_interface.h>
 #include <typeinfo>
 
 namespace TiledArray {
 
+  namespace detail {
+
+    inline double& shape_threshold_accessor() {
+      static thread_local double threshold = -1.0;
+      return threshold;
+    }
+
+  } // namespace detail
+
+  /// Sets the zero threshold of the sparse shapes computed by this thread in a scope
+
+  /// Shapes constructed, and shapes computed by shape arithmetic, in the
+  /// scope are screened with \c threshold and keep it, i.e. \c is_zero() and
+  /// the sparse contraction engine use it. Outside of the scope, combining
+  /// such a shape with a shape that uses the global threshold yields the
+  /// smaller of the two thresholds. Scopes are thread-local, so
+  /// expressions evaluated concurrently by different threads can use
+  /// different thresholds.
+  class ShapeThresholdScope {
+    double previous_; ///< The threshold of the enclosing scope
+
+  public:
+    ShapeThresholdScope(const ShapeThresholdScope&) = delete;
+    ShapeThresholdScope& operator=(const ShapeThresholdScope&) = delete;
+
+    /// Constructor
+
+    /// \param threshold The zero threshold of the shapes computed in this
+    /// scope; if negative, the threshold of the enclosing scope is kept
+    explicit ShapeThresholdScope(const double threshold) :
+      previous_(detail::shape_threshold_accessor())
+    {
+      if(threshold >= 0.0)
+        detail::shape_threshold_accessor() = threshold;
+    }
+
+    ~ShapeThresholdScope() { detail::shape_threshold_accessor() = previous_; }
+  }; // class ShapeThresholdScope
+
   /// Frobenius-norm-based sparse shape
 
   /// Sparse shape uses a \c Tensor of Frobenius norms to describe the magnitude
@@ -51,10 +91,14 @@ namespace TiledArray {
   /// of the Frobenius norms such as the submiltiplicativity.
   ///
   /// All constructors will zero out tiles whose scaled norms are below the
-  /// threshold. The screening threshold is accessed via
+  /// threshold. The global screening threshold is accessed via
   /// SparseShape:::threshold() ; it is the global, but not immutable.
   /// Thus it is possible to screen each operation separately, by changing the
-  /// screening threshold between each operation.
+  /// screening threshold between each operation. A shape can also have its
+  /// own threshold, see SparseShape::screen() and ShapeThresholdScope ; it
+  /// is used instead of the global one by the shape and by the shapes
+  /// computed from it; a shape computed from two shapes uses the smaller of
+  /// their thresholds.
   /// \warning If tile's scaled norm is below threshold, its scaled norm is set to
   ///          to zero and thus lost forever. E.g.
   ///          \c shape.scale(1e-10).scale(1e10) does not in general
@@ -90,7 +134,9 @@ namespace TiledArray {
     mutable std::unique_ptr<Tensor<value_type>> tile_norms_unscaled_ = nullptr; ///< unscaled Tile norms (memoized)
     std::shared_ptr<vector_type> size_vectors_; ///< Tile size information; size_vectors_.get()[d][i] reports the size of i-th tile in dimension d
     size_type zero_tile_count_; ///< Number of zero tiles
-    static value_type threshold_; ///< The zero threshold
+    std::shared_ptr<const detail::SubtileNorms<value_type> > subtile_norms_; ///< Optional slice norms of tiles, used to screen contractions
+    value_type local_threshold_; ///< The zero threshold of this shape, or a negative value if the global threshold is used
+    static value_type threshold_; ///< The global zero threshold
 
     template <typename Op>
     static vector_type
@@ -124,6 +170,7 @@ namespace TiledArray {
 
     /// \tparam ScaleBy_ defines the scaling factor: tile's volume, if ScaleBy::Volume, or tile's inverse volume, if ScaleBy::InverseVolume .
     /// \tparam Screen if true, will Screen the resulting contents of tile_norms
+    /// \param threshold The zero threshold used if \c Screen is true
     /// \return the number of zero tiles if \c Screen is true, 0 otherwise.
     /// \note \c Screen=true can be useful even in ScaleBy_==ScaleBy::Volume ,
     ///       e.g. in SparseShape::mult()
@@ -133,10 +180,10 @@ namespace TiledArray {
     ///       to be screened.
     template <ScaleBy ScaleBy_, bool Screen = true>
     static size_type scale_tile_norms(Tensor<T>& tile_norms,
-                                      const vector_type* MADNESS_RESTRICT const size_vectors)
+                                      const vector_type* MADNESS_RESTRICT const size_vectors,
+                                      const value_type threshold = threshold_)
     {
       const unsigned int dim = tile_norms.range().rank();
-      const value_type threshold = threshold_;
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
 
@@ -235,10 +282,70 @@ namespace TiledArray {
       return result_size_vectors;
     }
 
+    /// \return The threshold of the \c ShapeThresholdScope of this thread, or
+    /// a negative value if there is none
+    static value_type scoped_threshold() {
+      return value_type(detail::shape_threshold_accessor());
+    }
+
+    /// \param local_threshold The zero threshold of a shape, or a negative
+    /// value for the global threshold
+    /// \return The zero threshold used by the shape
+    static value_type effective_threshold(const value_type local_threshold) {
+      return (local_threshold >= value_type(0) ? local_threshold : threshold_);
+    }
+
+    /// \return The local threshold of a shape computed from this shape
+    value_type result_threshold() const {
+      const value_type scoped = scoped_threshold();
+      return (scoped >= value_type(0) ? scoped : local_threshold_);
+    }
+
+    /// \return The local threshold of a shape computed from this shape and
+    /// \c other ; the smaller of their zero thresholds, where a shape without
+    /// a threshold of its own contributes the global threshold, so that a
+    /// looser threshold does not spread to results of shapes that used the
+    /// global one
+    value_type result_threshold(const SparseShape_& other) const {
+      const value_type scoped = scoped_threshold();
+      if(scoped >= value_type(0))
+        return scoped;
+      if(local_threshold_ < value_type(0) && other.local_threshold_ < value_type(0))
+        return value_type(-1);
+      return std::min(effective_threshold(local_threshold_),
+          effective_threshold(other.local_threshold_));
+    }
+
+    std::shared_ptr<const detail::SubtileNorms<value_type> >
+    perm_subtile_norms(const Permutation& perm) const {
+      if(! subtile_norms_)
+        return nullptr;
+      return std::make_shared<const detail::SubtileNorms<value_type> >(
+          subtile_norms_->perm(perm));
+    }
+
+    std::shared_ptr<const detail::SubtileNorms<value_type> >
+    scale_subtile_norms(const value_type abs_factor) const {
+      if(! subtile_norms_)
+        return nullptr;
+      return std::make_shared<const detail::SubtileNorms<value_type> >(
+          subtile_norms_->scale(abs_factor));
+    }
+
+    std::shared_ptr<const detail::SubtileNorms<value_type> >
+    scale_subtile_norms(const value_type abs_factor, const Permutation& perm) const {
+      if(! subtile_norms_)
+        return nullptr;
+      return std::make_shared<const detail::SubtileNorms<value_type> >(
+          subtile_norms_->scale(abs_factor).perm(perm));
+    }
+
     SparseShape(const Tensor<T>& tile_norms, const std::shared_ptr<vector_type>& size_vectors,
-        const size_type zero_tile_count) :
+        const size_type zero_tile_count, const value_type local_threshold,
+        std::shared_ptr<const detail::SubtileNorms<value_type> > subtile_norms = nullptr) :
       tile_norms_(tile_norms), size_vectors_(size_vectors),
-      zero_tile_count_(zero_tile_count)
+      zero_tile_count_(zero_tile_count), subtile_norms_(std::move(subtile_norms)),
+      local_threshold_(local_threshold)
     { }
 
   public:
@@ -246,7 +353,10 @@ namespace TiledArray {
     /// Default constructor
 
     /// Construct a shape with no data.
-    SparseShape() : tile_norms_(), size_vectors_(), zero_tile_count_(0ul) { }
+    SparseShape() :
+      tile_norms_(), size_vectors_(), zero_tile_count_(0ul), subtile_norms_(),
+      local_threshold_(-1)
+    { }
 
     /// "Dense" Constructor
 
@@ -256,8 +366,12 @@ namespace TiledArray {
     /// \note this ctor *does not* scale tile norms
     /// \note if @c tile_norm is less than the threshold then all tile norms are set to zero
     SparseShape(const value_type& tile_norm, const TiledRange& trange) :
-        tile_norms_(trange.tiles_range(), (tile_norm < threshold_ ? 0 : tile_norm)), size_vectors_(initialize_size_vectors(trange)),
-        zero_tile_count_(tile_norm < threshold_ ? trange.tiles_range().area() : 0ul)
+        tile_norms_(trange.tiles_range(),
+            (tile_norm < effective_threshold(scoped_threshold()) ? 0 : tile_norm)),
+        size_vectors_(initialize_size_vectors(trange)),
+        zero_tile_count_(tile_norm < effective_threshold(scoped_threshold()) ?
+            trange.tiles_range().area() : 0ul),
+        subtile_norms_(), local_threshold_(scoped_threshold())
     {
     }
 
@@ -271,13 +385,14 @@ namespace TiledArray {
     SparseShape(const Tensor<value_type>& tile_norms, const TiledRange& trange,
         bool do_not_scale = false) :
       tile_norms_(tile_norms.clone()), size_vectors_(initialize_size_vectors(trange)),
-      zero_tile_count_(0ul)
+      zero_tile_count_(0ul), subtile_norms_(), local_threshold_(scoped_threshold())
     {
       TA_ASSERT(! tile_norms_.empty());
       TA_ASSERT(tile_norms_.range() == trange.tiles_range());
 
       if(!do_not_scale) {
-        zero_tile_count_ = scale_tile_norms<ScaleBy::InverseVolume>(tile_norms_, size_vectors_.get());
+        zero_tile_count_ = scale_tile_norms<ScaleBy::InverseVolume>(tile_norms_,
+            size_vectors_.get(), effective_threshold(local_threshold_));
       }
     }
 
@@ -299,7 +414,8 @@ namespace TiledArray {
     SparseShape(const SparseNormSequence& tile_norms, const TiledRange& trange)
         : tile_norms_(trange.tiles_range(), value_type(0)),
           size_vectors_(initialize_size_vectors(trange)),
-          zero_tile_count_(trange.tiles_range().volume()) {
+          zero_tile_count_(trange.tiles_range().volume()),
+          subtile_norms_(), local_threshold_(scoped_threshold()) {
       const auto dim = tile_norms_.range().rank();
       for (const auto& pair_idx_norm : tile_norms) {
         auto compute_tile_volume = [dim, this, pair_idx_norm]() -> uint64_t {
@@ -309,7 +425,7 @@ namespace TiledArray {
           return tile_volume;
         };
         auto norm_per_element = pair_idx_norm.second / compute_tile_volume();
-        if (norm_per_element >= threshold()) {
+        if (norm_per_element >= effective_threshold(local_threshold_)) {
           tile_norms_[pair_idx_norm.first] = norm_per_element;
           --zero_tile_count_;
         }
@@ -330,7 +446,7 @@ namespace TiledArray {
     SparseShape(World& world, const Tensor<value_type>& tile_norms,
                 const TiledRange& trange, bool do_not_scale = false) :
       tile_norms_(tile_norms.clone()), size_vectors_(initialize_size_vectors(trange)),
-      zero_tile_count_(0ul)
+      zero_tile_count_(0ul), subtile_norms_(), local_threshold_(scoped_threshold())
     {
       TA_ASSERT(! tile_norms_.empty());
       TA_ASSERT(tile_norms_.range() == trange.tiles_range());
@@ -339,7 +455,8 @@ namespace TiledArray {
       world.gop.max(tile_norms_.data(), tile_norms_.size());
 
       if(!do_not_scale){
-        zero_tile_count_ = scale_tile_norms<ScaleBy::InverseVolume>(tile_norms_, size_vectors_.get());;
+        zero_tile_count_ = scale_tile_norms<ScaleBy::InverseVolume>(tile_norms_,
+            size_vectors_.get(), effective_threshold(local_threshold_));
       }
     }
 
@@ -372,7 +489,9 @@ namespace TiledArray {
       tile_norms_(other.tile_norms_),
       tile_norms_unscaled_(other.tile_norms_unscaled_ ? std::make_unique<decltype(tile_norms_)>(other.tile_norms_unscaled_.get()->clone()) : nullptr),
       size_vectors_(other.size_vectors_),
-      zero_tile_count_(other.zero_tile_count_)
+      zero_tile_count_(other.zero_tile_count_),
+      subtile_norms_(other.subtile_norms_),
+      local_threshold_(other.local_threshold_)
     { }
 
     /// Copy assignment operator
@@ -388,6 +507,8 @@ namespace TiledArray {
                                  : nullptr;
       size_vectors_ = other.size_vectors_;
       zero_tile_count_ = other.zero_tile_count_;
+      subtile_norms_ = other.subtile_norms_;
+      local_threshold_ = other.local_threshold_;
       return *this;
     }
 
@@ -407,7 +528,7 @@ namespace TiledArray {
     template <typename Index>
     bool is_zero(const Index& i) const {
       TA_ASSERT(! tile_norms_.empty());
-      return tile_norms_[i] < threshold_;
+      return tile_norms_[i] < effective_threshold(local_threshold_);
     }
 
     /// Check density
@@ -433,6 +554,36 @@ namespace TiledArray {
     /// \param thresh The new threshold
     static void threshold(const value_type thresh) { threshold_ = thresh; }
 
+    /// Threshold of this shape
+
+    /// \return The zero threshold of this shape: its own threshold, or the
+    /// global threshold if it has none
+    value_type screening_threshold() const {
+      return effective_threshold(local_threshold_);
+    }
+
+    /// Screen with a threshold
+
+    /// \param thresh The zero threshold of the result
+    /// \return A copy of this shape whose tiles with norms below \c thresh
+    /// are zero, and which keeps \c thresh as its own threshold
+    SparseShape_ screen(const value_type thresh) const {
+      TA_ASSERT(! tile_norms_.empty());
+      TA_ASSERT(thresh >= value_type(0));
+      madness::AtomicInt zero_tile_count;
+      zero_tile_count = 0;
+      auto op = [thresh, &zero_tile_count] (value_type value) {
+        if(value < thresh) {
+          value = value_type(0);
+          ++zero_tile_count;
+        }
+        return value;
+      };
+
+      return SparseShape_(tile_norms_.unary(op), size_vectors_,
+          zero_tile_count, thresh, subtile_norms_);
+    }
+
     /// Tile norm accessor
 
     /// \tparam Index The index type
@@ -460,7 +611,8 @@ namespace TiledArray {
         madness::AtomicInt zero_tile_count;
         zero_tile_count = 0;
 
-        const value_type threshold = threshold_;
+        const value_type local_threshold = result_threshold();
+        const value_type threshold = effective_threshold(local_threshold);
         auto apply_threshold = [threshold, &zero_tile_count](value_type &norm){
             TA_ASSERT(norm >= value_type(0));
             if(norm < threshold){
@@ -473,7 +625,7 @@ namespace TiledArray {
                 new_norms.data());
 
         return SparseShape_(std::move(new_norms), size_vectors_,
-                            zero_tile_count);
+                            zero_tile_count, local_threshold);
     }
 
     /// Data accessor
@@ -498,6 +650,30 @@ namespace TiledArray {
     /// \return \c true when this shape has been initialized.
     bool empty() const { return tile_norms_.empty(); }
 
+    /// Attach slice norms of the tiles
+
+    /// Contractions of shapes that both have slice norms with the same
+    /// number of segments bound the result tile norms by sums of products of
+    /// slice norms along a contracted mode, which are tighter than products
+    /// of tile norms. The slice norms are kept by \c perm() and \c scale() ;
+    /// other operations, and serialization, drop them.
+    /// \param subtile_norms The unscaled slice norms of the tiles of this
+    /// shape
+    /// \return A copy of this shape with \c subtile_norms
+    SparseShape_ subtile(std::shared_ptr<const detail::SubtileNorms<value_type> > subtile_norms) const {
+      TA_ASSERT(! tile_norms_.empty());
+      TA_ASSERT(! subtile_norms || (subtile_norms->range() == tile_norms_.range()));
+      return SparseShape_(tile_norms_, size_vectors_, zero_tile_count_,
+          local_threshold_, std::move(subtile_norms));
+    }
+
+    /// Slice norms accessor
+
+    /// \return The slice norms of the tiles, or a null pointer if this shape
+    /// has none
+    const std::shared_ptr<const detail::SubtileNorms<value_type> >&
+    subtile_norms() const { return subtile_norms_; }
+
     /// Compute union of two shapes
 
     /// \param mask The input shape, hard zeros are used to mask the output.
@@ -507,7 +683,8 @@ namespace TiledArray {
       TA_ASSERT(!mask_shape.empty());
       TA_ASSERT(tile_norms_.range() == mask_shape.tile_norms_.range());
 
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = zero_tile_count_;
       auto op = [threshold, &zero_tile_count] (value_type left,
@@ -524,7 +701,7 @@ namespace TiledArray {
       Tensor<value_type> result_tile_norms =
           tile_norms_.binary(mask_shape.tile_norms_, op);
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     /// Update sub-block of shape
@@ -543,7 +720,8 @@ namespace TiledArray {
       Tensor<value_type> result_tile_norms = tile_norms_.clone();
 
       auto result_tile_norms_blk = result_tile_norms.block(lower_bound, upper_bound);
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = zero_tile_count_;
       result_tile_norms_blk.inplace_binary(other.tile_norms_,
@@ -558,7 +736,7 @@ namespace TiledArray {
             l = r;
           });
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     /// Bitwise comparison
@@ -630,7 +808,8 @@ namespace TiledArray {
           block_range(lower_bound, upper_bound);
 
       // Copy the data from arg to result
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
       auto copy_op = [threshold,&zero_tile_count] (value_type& MADNESS_RESTRICT result,
@@ -648,7 +827,7 @@ namespace TiledArray {
       Tensor<value_type> result_norms((Range(block_view.range().extent())));
       result_norms.inplace_binary(shift(block_view), copy_op);
 
-      return SparseShape(result_norms, size_vectors, zero_tile_count);
+      return SparseShape(result_norms, size_vectors, zero_tile_count, local_threshold);
     }
 
 
@@ -668,7 +847,8 @@ namespace TiledArray {
           block_range(lower_bound, upper_bound);
 
       // Copy the data from arg to result
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
       auto copy_op = [abs_factor,threshold,&zero_tile_count] (value_type& MADNESS_RESTRICT result,
@@ -687,7 +867,7 @@ namespace TiledArray {
       Tensor<value_type> result_norms((Range(block_view.range().extent())));
       result_norms.inplace_binary(shift(block_view), copy_op);
 
-      return SparseShape(result_norms, size_vectors, zero_tile_count);
+      return SparseShape(result_norms, size_vectors, zero_tile_count, local_threshold);
     }
 
     /// Create a copy of a sub-block of the shape
@@ -721,7 +901,7 @@ namespace TiledArray {
     /// \return A new, permuted shape
     SparseShape_ perm(const Permutation& perm) const {
       return SparseShape_(tile_norms_.permute(perm), perm_size_vectors(perm),
-          zero_tile_count_);
+          zero_tile_count_, local_threshold_, perm_subtile_norms(perm));
     }
 
     /// Scale shape
@@ -737,7 +917,8 @@ namespace TiledArray {
     template <typename Factor>
     SparseShape_ scale(const Factor factor) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       const value_type abs_factor = to_abs_factor(factor);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
@@ -752,7 +933,8 @@ namespace TiledArray {
 
       Tensor<value_type> result_tile_norms = tile_norms_.unary(op);
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count,
+          local_threshold, scale_subtile_norms(abs_factor));
     }
 
     /// Scale and permute shape
@@ -769,7 +951,8 @@ namespace TiledArray {
     template <typename Factor>
     SparseShape_ scale(const Factor factor, const Permutation& perm) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       const value_type abs_factor = to_abs_factor(factor);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
@@ -785,7 +968,7 @@ namespace TiledArray {
       Tensor<value_type> result_tile_norms = tile_norms_.unary(op, perm);
 
       return SparseShape_(result_tile_norms, perm_size_vectors(perm),
-          zero_tile_count);
+          zero_tile_count, local_threshold, scale_subtile_norms(abs_factor, perm));
     }
 
     /// Add shapes
@@ -798,7 +981,8 @@ namespace TiledArray {
     /// \return A sum of shapes
     SparseShape_ add(const SparseShape_& other) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold(other);
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
       auto op = [threshold, &zero_tile_count] (value_type left,
@@ -815,7 +999,7 @@ namespace TiledArray {
       Tensor<value_type> result_tile_norms =
           tile_norms_.binary(other.tile_norms_, op);
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     /// Add and permute shapes
@@ -829,7 +1013,8 @@ namespace TiledArray {
     /// \return the new shape, equals \c this + \c other
     SparseShape_ add(const SparseShape_& other, const Permutation& perm) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold(other);
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
       auto op = [threshold, &zero_tile_count] (value_type left,
@@ -847,7 +1032,7 @@ namespace TiledArray {
           tile_norms_.binary(other.tile_norms_, op, perm);
 
       return SparseShape_(result_tile_norms, perm_size_vectors(perm),
-          zero_tile_count);
+          zero_tile_count, local_threshold);
     }
 
     /// Add and scale shapes
@@ -864,7 +1049,8 @@ namespace TiledArray {
     template <typename Factor>
     SparseShape_ add(const SparseShape_& other, const Factor factor) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold(other);
+      const value_type threshold = effective_threshold(local_threshold);
       const value_type abs_factor = to_abs_factor(factor);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
@@ -883,7 +1069,7 @@ namespace TiledArray {
       Tensor<value_type> result_tile_norms =
           tile_norms_.binary(other.tile_norms_, op);
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     /// Add, scale, and permute shapes
@@ -903,7 +1089,8 @@ namespace TiledArray {
         const Permutation& perm) const
     {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold(other);
+      const value_type threshold = effective_threshold(local_threshold);
       const value_type abs_factor = to_abs_factor(factor);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
@@ -923,12 +1110,13 @@ namespace TiledArray {
           tile_norms_.binary(other.tile_norms_, op, perm);
 
       return SparseShape_(result_tile_norms, perm_size_vectors(perm),
-          zero_tile_count);
+          zero_tile_count, local_threshold);
     }
 
     SparseShape_ add(value_type value) const {
       TA_ASSERT(! tile_norms_.empty());
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold();
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
 
@@ -983,7 +1171,7 @@ namespace TiledArray {
             });
       }
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     SparseShape_ add(const value_type value, const Permutation& perm) const {
@@ -1025,11 +1213,13 @@ namespace TiledArray {
       // scale_tile_norms operations are performed in one step instead of two.
 
       TA_ASSERT(! tile_norms_.empty());
+      const value_type local_threshold = result_threshold(other);
       Tensor<T> result_tile_norms = tile_norms_.mult(other.tile_norms_);
       const size_type zero_tile_count =
-          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, size_vectors_.get());
+          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, size_vectors_.get(),
+              effective_threshold(local_threshold));
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     SparseShape_ mult(const SparseShape_& other, const Permutation& perm) const {
@@ -1037,12 +1227,14 @@ namespace TiledArray {
       // scale_tile_norms operations are performed in one step instead of two.
 
       TA_ASSERT(! tile_norms_.empty());
+      const value_type local_threshold = result_threshold(other);
       Tensor<T> result_tile_norms = tile_norms_.mult(other.tile_norms_, perm);
       std::shared_ptr<vector_type> result_size_vector = perm_size_vectors(perm);
       const size_type zero_tile_count =
-          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, result_size_vector.get());
+          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, result_size_vector.get(),
+              effective_threshold(local_threshold));
 
-      return SparseShape_(result_tile_norms, result_size_vector, zero_tile_count);
+      return SparseShape_(result_tile_norms, result_size_vector, zero_tile_count, local_threshold);
     }
 
     /// \tparam Factor The scaling factor type
@@ -1054,11 +1246,13 @@ namespace TiledArray {
 
       TA_ASSERT(! tile_norms_.empty());
       const value_type abs_factor = to_abs_factor(factor);
+      const value_type local_threshold = result_threshold(other);
       Tensor<T> result_tile_norms = tile_norms_.mult(other.tile_norms_, abs_factor);
       const size_type zero_tile_count =
-          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, size_vectors_.get());
+          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, size_vectors_.get(),
+              effective_threshold(local_threshold));
 
-      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count);
+      return SparseShape_(result_tile_norms, size_vectors_, zero_tile_count, local_threshold);
     }
 
     /// \tparam Factor The scaling factor type
@@ -1072,12 +1266,14 @@ namespace TiledArray {
 
       TA_ASSERT(! tile_norms_.empty());
       const value_type abs_factor = to_abs_factor(factor);
+      const value_type local_threshold = result_threshold(other);
       Tensor<T> result_tile_norms = tile_norms_.mult(other.tile_norms_, abs_factor, perm);
       std::shared_ptr<vector_type> result_size_vector = perm_size_vectors(perm);
       const size_type zero_tile_count =
-          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, result_size_vector.get());
+          scale_tile_norms<ScaleBy::Volume>(result_tile_norms, result_size_vector.get(),
+              effective_threshold(local_threshold));
 
-      return SparseShape_(result_tile_norms, result_size_vector, zero_tile_count);
+      return SparseShape_(result_tile_norms, result_size_vector, zero_tile_count, local_threshold);
     }
 
     /// \tparam Factor The scaling factor type
@@ -1089,7 +1285,8 @@ namespace TiledArray {
       TA_ASSERT(! tile_norms_.empty());
 
       const value_type abs_factor = to_abs_factor(factor);
-      const value_type threshold = threshold_;
+      const value_type local_threshold = result_threshold(other);
+      const value_type threshold = effective_threshold(local_threshold);
       madness::AtomicInt zero_tile_count;
       zero_tile_count = 0;
       integer M = 0, N = 0, K = 0;
@@ -1113,7 +1310,35 @@ namespace TiledArray {
       Tensor<value_type> result_norms(gemm_helper.make_result_range<typename Tensor<T>::range_type>(
           tile_norms_.range(), other.tile_norms_.range()), 0);
 
-      if(k_rank > 0u) {
+      if((k_rank > 0u) && subtile_norms_ && other.subtile_norms_ &&
+          (subtile_norms_->segments() == other.subtile_norms_->segments())) {
+
+        // Bound the result norms with the slice norms of the first contracted
+        // mode: ||C_ij|| <= sum_k sum_s ||A_ik,s|| ||B_kj,s|| . The left slice
+        // norms are an M x (K * S) matrix, the right ones are reordered into
+        // a (K * S) x N matrix.
+        const integer S = subtile_norms_->segments();
+        const integer KS = K * S;
+        const value_type* MADNESS_RESTRICT const left_slices =
+            subtile_norms_->data(gemm_helper.left_inner_begin());
+        const value_type* MADNESS_RESTRICT const right_slices =
+            other.subtile_norms_->data(gemm_helper.right_inner_begin());
+
+        std::vector<value_type> right(KS * N);
+        for(integer k = 0; k < K; ++k)
+          for(integer j = 0; j < N; ++j)
+            for(integer s = 0; s < S; ++s)
+              right[(k * S + s) * N + j] = right_slices[(k * N + j) * S + s];
+
+        math::gemm(madness::cblas::NoTrans, madness::cblas::NoTrans, M, N, KS,
+            abs_factor, left_slices, KS, right.data(), N, value_type(0),
+            result_norms.data(), N);
+
+        // Scale the norms and hard zero tiles that are below the zero threshold.
+        zero_tile_count = scale_tile_norms<ScaleBy::InverseVolume>(result_norms,
+            result_size_vectors.get(), threshold);
+
+      } else if(k_rank > 0u) {
 
         // Compute size vector
         const vector_type k_sizes =
@@ -1166,7 +1391,7 @@ namespace TiledArray {
             });
       }
 
-      return SparseShape_(result_norms, result_size_vectors, zero_tile_count);
+      return SparseShape_(result_norms, result_size_vectors, zero_tile_count, local_threshold);
     }
 
     /// \tparam Factor The scaling factor type
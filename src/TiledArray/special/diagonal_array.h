@@ -27,10 +27,12 @@
 #define TILEDARRAY_SPECIALARRAYS_DIAGONAL_ARRAY_H__INCLUDED
 
 #include <TiledArray/dist_array.h>
+#include <TiledArray/expressions/diagonal_expr.h>
 #include <TiledArray/range.h>
 #include <TiledArray/tensor.h>
 #include <TiledArray/tiled_range.h>
 
+#include <memory>
 #include <vector>
 
 namespace TiledArray {
@@ -185,6 +187,89 @@ diagonal_array(World &world, TiledRange const &trange, T val = 1) {
   return sparse_diagonal_array<T>(world, trange, val);
 }
 
+/// An implicit diagonal matrix
+
+/// Unlike the arrays made by \c diagonal_array() , a \c DiagonalMatrix stores
+/// only its (replicated) diagonal. Contracting it with a tensor expression,
+/// e.g. scaling by orbital energies,
+/// \code
+/// DiagonalMatrix<double> e(trange1, energies);
+/// b("i,j") = e("i,k") * a("k,j");
+/// \endcode
+/// scales the tiles of \c a along the contracted dimension in O(n^2) work,
+/// without a SUMMA broadcast or GEMM.
+/// \tparam T The element type
+template <typename T>
+class DiagonalMatrix {
+  TiledRange1 trange_; ///< The tiling of both dimensions
+  std::shared_ptr<const std::vector<T>> diag_; ///< The diagonal elements
+
+ public:
+  /// Construct a diagonal matrix from its diagonal
+
+  /// \param trange The tiling of both dimensions
+  /// \param diag The diagonal elements
+  DiagonalMatrix(const TiledRange1& trange, std::vector<T> diag) :
+    trange_(trange), diag_(std::make_shared<const std::vector<T>>(std::move(diag)))
+  {
+    TA_USER_ASSERT(diag_->size() == trange_.extent(),
+        "DiagonalMatrix: the number of diagonal elements does not match the tiling");
+  }
+
+  /// Construct a constant diagonal matrix, e.g. the identity
+
+  /// \param trange The tiling of both dimensions
+  /// \param val The value of the diagonal elements
+  explicit DiagonalMatrix(const TiledRange1& trange, const T val = T(1)) :
+    DiagonalMatrix(trange, std::vector<T>(trange.extent(), val))
+  { }
+
+  /// Construct a diagonal matrix from a vector
+
+  /// The diagonal is gathered on every rank; unless \c vector is replicated
+  /// this is a collective operation.
+  /// \tparam Policy The array policy type
+  /// \param vector A vector with the diagonal elements
+  template <typename Policy>
+  explicit DiagonalMatrix(const DistArray<Tensor<T>, Policy>& vector) :
+    trange_(vector.trange().data()[0])
+  {
+    TA_USER_ASSERT(vector.trange().rank() == 1u,
+        "DiagonalMatrix: the diagonal must be a vector");
+    const auto offset = trange_.elements_range().first;
+    const auto& pmap = *vector.pmap();
+    const auto rank = pmap.rank();
+    std::vector<T> diag(trange_.extent(), T(0));
+    for (const auto ord : pmap) {
+      // A replicated vector is stored on every rank, so each tile must be
+      // summed only by its owner
+      if (vector.is_zero(ord) || (!pmap.is_replicated() && pmap.owner(ord) != rank))
+        continue;
+      const auto tile = vector.find(ord).get();
+      for (const auto& idx : tile.range())
+        diag[idx[0] - offset] = tile[idx];
+    }
+    // Every rank already holds the full diagonal of a replicated vector
+    if (!pmap.is_replicated())
+      vector.world().gop.sum(diag.data(), diag.size());
+    diag_ = std::make_shared<const std::vector<T>>(std::move(diag));
+  }
+
+  /// Annotate this matrix for use in a contraction
+
+  /// \param vars The variable list, e.g. \c "i,k"
+  /// \return An annotated diagonal matrix
+  expressions::DiagonalExpr<T> operator()(const std::string& vars) const {
+    return {diag_, trange_, vars};
+  }
+
+  /// \return The tiling of both dimensions
+  const TiledRange1& trange() const { return trange_; }
+
+  /// \return The diagonal elements
+  const std::vector<T>& diagonal() const { return *diag_; }
+};
+
 }  // namespace TiledArray
 
 #endif  // TILEDARRAY_SPECIALARRAYS_DIAGONAL_ARRAY_H__INCLUDED
@@ -20,8 +20,11 @@
 #ifndef TILEDARRAY_SPECIAL_KRONECKER_DELTA_H__INCLUDED
 #define TILEDARRAY_SPECIAL_KRONECKER_DELTA_H__INCLUDED
 
-#include <tuple>
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include <tiledarray_fwd.h>
 
@@ -93,11 +96,13 @@ template<unsigned _N = 1>
       bool empty() const { return empty_; }
 
       /// MADNESS compliant serialization
+
+      /// A delta tile is defined by its range, so it is cheap to send and
+      /// delta arrays may be distributed like any other array
       template<typename Archive>
       void
       serialize(Archive& ar) {
-        std::cout << "KroneckerDelta::serialize not implemented by design!" << std::endl;
-        abort(); // should never travel
+        ar & range_ & empty_;
       }
 
     private:
@@ -107,8 +112,9 @@ template<unsigned _N = 1>
         TA_ASSERT(range.rank() == 2*N);
         auto lobound = range.lobound_data();
         auto upbound = range.upbound_data();
+        // the tile is empty if any ordinary delta has no diagonal elements in it
         for(auto i=0; i!=2*N && not empty; i+=2)
-          empty = (upbound[i] > lobound[i+1] && upbound[i+1] > lobound[i]) ? true : false; // assumes extents > 0
+          empty = (upbound[i] > lobound[i+1] && upbound[i+1] > lobound[i]) ? false : true; // assumes extents > 0
         return empty;
       }
 
@@ -185,6 +191,180 @@ template<typename T, unsigned N>
 
 // Contraction operation
 
+namespace TiledArray {
+  namespace detail {
+
+    /// Contract a generalized Kronecker delta tile with a tensor tile
+
+    /// Depending on how many of its indices are contracted, each ordinary
+    /// Kronecker delta in \c delta either relabels an index of \c arg (one
+    /// index contracted), restricts \c arg to a diagonal (both indices
+    /// contracted), or spreads \c arg along a diagonal of the result (no
+    /// index contracted). The contraction is therefore a scaled, strided copy
+    /// of \c arg into \c result whose cost is proportional to the number of
+    /// nonzero result elements: only the elements of \c arg that lie on the
+    /// traced diagonals and within the bounds of the relabeled indices are
+    /// visited, and no dense delta tile is generated.
+    /// \tparam T The element type of the tensor tiles
+    /// \tparam N The number of ordinary Kronecker deltas in \c delta
+    /// \param[in,out] result The result tile, to which the contraction is added
+    /// \param delta The Kronecker delta tile
+    /// \param arg The tensor tile
+    /// \param factor The scaling factor
+    /// \param gemm_config The contraction configuration
+    /// \param delta_is_left \c true if \c delta is the left-hand argument of
+    /// the contraction
+    template <typename T, unsigned N>
+    void kronecker_delta_gemm(Tensor<T>& result,
+        const KroneckerDeltaTile<N>& delta, const Tensor<T>& arg,
+        const typename Tensor<T>::numeric_type factor,
+        const math::GemmHelper& gemm_config, const bool delta_is_left)
+    {
+      if(delta.empty())
+        return;
+
+      const auto delta_range = delta.range();
+      const auto& arg_range = arg.range();
+      const auto* MADNESS_RESTRICT const delta_lower = delta_range.lobound_data();
+      const auto* MADNESS_RESTRICT const delta_upper = delta_range.upbound_data();
+      const auto* MADNESS_RESTRICT const result_lower = result.range().lobound_data();
+      const auto* MADNESS_RESTRICT const result_stride = result.range().stride_data();
+
+      // Outer and inner dimensions of delta and arg
+      const unsigned int delta_outer_begin = (delta_is_left ?
+          gemm_config.left_outer_begin() : gemm_config.right_outer_begin());
+      const unsigned int delta_outer_end = (delta_is_left ?
+          gemm_config.left_outer_end() : gemm_config.right_outer_end());
+      const unsigned int delta_inner_begin = (delta_is_left ?
+          gemm_config.left_inner_begin() : gemm_config.right_inner_begin());
+      const unsigned int arg_outer_begin = (delta_is_left ?
+          gemm_config.right_outer_begin() : gemm_config.left_outer_begin());
+      const unsigned int arg_outer_end = (delta_is_left ?
+          gemm_config.right_outer_end() : gemm_config.left_outer_end());
+      const unsigned int arg_inner_begin = (delta_is_left ?
+          gemm_config.right_inner_begin() : gemm_config.left_inner_begin());
+      const unsigned int left_outer_rank =
+          gemm_config.left_outer_end() - gemm_config.left_outer_begin();
+
+      // The first result dimension of the outer dimensions of delta and arg
+      const unsigned int delta_result_begin = (delta_is_left ? 0u : left_outer_rank);
+      const unsigned int arg_result_begin = (delta_is_left ? left_outer_rank : 0u);
+
+      auto is_outer = [=] (const unsigned int d) {
+        return (d >= delta_outer_begin) && (d < delta_outer_end);
+      };
+      // The result dimension of an outer dimension of delta
+      auto result_dim = [=] (const unsigned int d) {
+        return d - delta_outer_begin + delta_result_begin;
+      };
+      // The dimension of arg contracted with an inner dimension of delta
+      auto arg_dim = [=] (const unsigned int d) {
+        return d - delta_inner_begin + arg_inner_begin;
+      };
+
+      // Classify the ordinary Kronecker deltas
+      std::vector<std::array<unsigned int, 2> > traces;
+      std::vector<std::tuple<unsigned int, unsigned int, std::size_t, std::size_t> > relabels;
+      std::vector<std::size_t> spread_offsets(1u, 0ul);
+      for(unsigned int i = 0u; i < 2u * N; i += 2u) {
+        const bool outer0 = is_outer(i), outer1 = is_outer(i + 1u);
+        if(outer0 && outer1) {
+          // result(..., x, ..., x, ...) for every x on the diagonal of the tile
+          const std::size_t r0 = result_dim(i), r1 = result_dim(i + 1u);
+          const std::size_t lower = std::max(delta_lower[i], delta_lower[i + 1u]);
+          const std::size_t upper = std::min(delta_upper[i], delta_upper[i + 1u]);
+          const std::size_t step = result_stride[r0] + result_stride[r1];
+          const std::size_t first = (lower - result_lower[r0]) * result_stride[r0]
+              + (lower - result_lower[r1]) * result_stride[r1];
+          std::vector<std::size_t> offsets;
+          offsets.reserve(spread_offsets.size() * (upper - lower));
+          for(const auto offset : spread_offsets)
+            for(std::size_t x = 0ul; x < upper - lower; ++x)
+              offsets.push_back(offset + first + x * step);
+          spread_offsets = std::move(offsets);
+        } else if(outer0 || outer1) {
+          // the inner index of arg becomes the outer index of the result
+          const unsigned int outer = (outer0 ? i : i + 1u);
+          const unsigned int inner = (outer0 ? i + 1u : i);
+          relabels.emplace_back(arg_dim(inner), result_dim(outer),
+              delta_lower[outer], delta_upper[outer]);
+        } else {
+          // only the diagonal of arg contributes
+          traces.push_back({{arg_dim(i), arg_dim(i + 1u)}});
+        }
+      }
+
+      // Restrict the iteration over arg to the elements that contribute:
+      // a traced pair of dimensions is iterated as a single dimension over
+      // the intersection of their bounds, and a relabeled dimension over the
+      // bounds of the outer index of its delta
+      const unsigned int arg_rank = arg_range.rank();
+      const auto* MADNESS_RESTRICT const arg_lower = arg_range.lobound_data();
+      const auto* MADNESS_RESTRICT const arg_stride = arg_range.stride_data();
+      std::vector<std::size_t> lower(arg_range.lobound_data(),
+          arg_range.lobound_data() + arg_rank);
+      std::vector<std::size_t> upper(arg_range.upbound_data(),
+          arg_range.upbound_data() + arg_rank);
+      std::vector<unsigned int> tied(arg_rank);
+      for(unsigned int d = 0u; d < arg_rank; ++d)
+        tied[d] = d;
+      for(const auto& trace : traces) {
+        lower[trace[0]] = std::max(lower[trace[0]], lower[trace[1]]);
+        upper[trace[0]] = std::min(upper[trace[0]], upper[trace[1]]);
+        tied[trace[1]] = trace[0];
+      }
+      for(const auto& relabel : relabels) {
+        const unsigned int d = std::get<0>(relabel);
+        lower[d] = std::max(lower[d], std::get<2>(relabel));
+        upper[d] = std::min(upper[d], std::get<3>(relabel));
+      }
+      std::vector<unsigned int> free_dims;
+      for(unsigned int d = 0u; d < arg_rank; ++d) {
+        if(tied[d] != d) continue;
+        if(lower[d] >= upper[d])
+          return;
+        free_dims.push_back(d);
+      }
+
+      const T* MADNESS_RESTRICT const arg_data = arg.data();
+      T* MADNESS_RESTRICT const result_data = result.data();
+      std::vector<std::size_t> idx(lower);
+      for(;;) {
+        for(unsigned int d = 0u; d < arg_rank; ++d)
+          idx[d] = idx[tied[d]];
+
+        std::size_t arg_offset = 0ul;
+        for(unsigned int d = 0u; d < arg_rank; ++d)
+          arg_offset += (idx[d] - arg_lower[d]) * arg_stride[d];
+        std::size_t offset = 0ul;
+        for(unsigned int d = arg_outer_begin; d < arg_outer_end; ++d) {
+          const unsigned int r = d - arg_outer_begin + arg_result_begin;
+          offset += (idx[d] - result_lower[r]) * result_stride[r];
+        }
+        for(const auto& relabel : relabels) {
+          const unsigned int r = std::get<1>(relabel);
+          offset += (idx[std::get<0>(relabel)] - result_lower[r]) * result_stride[r];
+        }
+
+        const T scaled_value = arg_data[arg_offset] * factor;
+        for(const auto spread_offset : spread_offsets)
+          result_data[offset + spread_offset] += scaled_value;
+
+        // Advance to the next contributing element
+        auto it = free_dims.rbegin();
+        for(; it != free_dims.rend(); ++it) {
+          if(++idx[*it] < upper[*it])
+            break;
+          idx[*it] = lower[*it];
+        }
+        if(it == free_dims.rend())
+          break;
+      }
+    }
+
+  } // namespace detail
+} // namespace TiledArray
+
 // GEMM operation with fused indices as defined by gemm_config:
 // dense_result[i,j] = dense_arg1[i,k] * sparse_arg2[k,j]
 template<typename T, unsigned N>
@@ -194,54 +374,11 @@ template<typename T, unsigned N>
       const TiledArray::Tensor<T>& arg2,
       const typename TiledArray::Tensor<T>::numeric_type factor,
       const TiledArray::math::GemmHelper& gemm_config) {
-
-  // preconditions:
-  // 1. implemented only outer product
-  assert(gemm_config.result_rank() == gemm_config.left_rank() + gemm_config.right_rank());
-
-  auto arg1_range = arg1.range();
-  auto arg2_range = arg2.range();
   auto result_range = gemm_config.make_result_range<TiledArray::Range> (
-      arg1_range, arg2_range);
-  TiledArray::Tensor<T> result (result_range, 0);
-
-  auto result_data = result.data();
-  auto arg1_extents = arg1_range.extent_data();
-  auto arg2_data = arg2.data();
-  auto arg2_volume = arg2_range.volume();
-
-  if (not arg1.empty ()) {
-    switch (N) {
-      case 1: {
-        auto i0_range = std::min (arg1_extents[0], arg1_extents[1]);
-        for (decltype(i0_range) i0 = 0; i0 != i0_range; ++i0) {
-          auto result_i0i0_ptr = result_data
-              + (i0 * arg1_extents[1] + i0) * arg2_volume;
-          std::copy (arg2_data, arg2_data + arg2_volume, result_i0i0_ptr);
-        }
-      }
-        break;
-      case 2: {
-        auto i0_range = std::min (arg1_extents[0], arg1_extents[1]);
-        auto i1_range = std::min (arg1_extents[2], arg1_extents[3]);
-        auto ndim23 = arg1_extents[2] * arg1_extents[3];
-        for (decltype(i0_range) i0 = 0; i0 != i0_range; ++i0) {
-          auto result_i0i0i1i1_ptr_offset = result_data
-              + (i0 * arg1_extents[1] + i0) * ndim23 * arg2_volume;
-          for (decltype(i1_range) i1 = 0; i1 != i1_range; ++i1) {
-            auto result_i0i0i1i1_ptr = result_i0i0i1i1_ptr_offset
-                + (i1 * arg1_extents[3] + i1) * arg2_volume;
-            std::copy (arg2_data, arg2_data + arg2_volume, result_i0i0i1i1_ptr);
-          }
-        }
-      }
-        break;
-
-      default:
-        abort (); // not implemented
-    }
-  }
-
+      arg1.range(), arg2.range());
+  TiledArray::Tensor<T> result (result_range, T(0));
+  TiledArray::detail::kronecker_delta_gemm(result, arg1, arg2, factor,
+                                           gemm_config, true);
   return result;
 }
 // GEMM operation with fused indices as defined by gemm_config:
@@ -254,7 +391,43 @@ template<typename T, unsigned N>
       const TiledArray::Tensor<T>& arg2,
       const typename TiledArray::Tensor<T>::numeric_type factor,
       const TiledArray::math::GemmHelper& gemm_config) {
-  abort();
-  }
+  TA_ASSERT(! result.empty());
+  TA_ASSERT(result.range() == gemm_config.make_result_range<TiledArray::Range> (
+      arg1.range(), arg2.range()));
+  TiledArray::detail::kronecker_delta_gemm(result, arg1, arg2, factor,
+                                           gemm_config, true);
+}
+// GEMM operation with fused indices as defined by gemm_config:
+// dense_result[i,j] = dense_arg1[i,k] * sparse_arg2[k,j]
+template<typename T, unsigned N>
+  TiledArray::Tensor<T>
+  gemm (
+      const TiledArray::Tensor<T>& arg1,
+      const KroneckerDeltaTile<N>& arg2,
+      const typename TiledArray::Tensor<T>::numeric_type factor,
+      const TiledArray::math::GemmHelper& gemm_config) {
+  auto result_range = gemm_config.make_result_range<TiledArray::Range> (
+      arg1.range(), arg2.range());
+  TiledArray::Tensor<T> result (result_range, T(0));
+  TiledArray::detail::kronecker_delta_gemm(result, arg2, arg1, factor,
+                                           gemm_config, false);
+  return result;
+}
+// GEMM operation with fused indices as defined by gemm_config:
+// dense_result[i,j] += dense_arg1[i,k] * sparse_arg2[k,j]
+template<typename T, unsigned N>
+  void
+  gemm (
+      TiledArray::Tensor<T>& result,
+      const TiledArray::Tensor<T>& arg1,
+      const KroneckerDeltaTile<N>& arg2,
+      const typename TiledArray::Tensor<T>::numeric_type factor,
+      const TiledArray::math::GemmHelper& gemm_config) {
+  TA_ASSERT(! result.empty());
+  TA_ASSERT(result.range() == gemm_config.make_result_range<TiledArray::Range> (
+      arg1.range(), arg2.range()));
+  TiledArray::detail::kronecker_delta_gemm(result, arg2, arg1, factor,
+                                           gemm_config, false);
+}
 
 #endif // TILEDARRAY_TEST_SPARSE_TILE_H__INCLUDED
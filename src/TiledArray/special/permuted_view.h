@@ -0,0 +1,155 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  permuted_view.h
+ *  Dec 14, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_SPECIAL_PERMUTED_VIEW_H__INCLUDED
+#define TILEDARRAY_SPECIAL_PERMUTED_VIEW_H__INCLUDED
+
+#include <TiledArray/dist_array.h>
+#include <TiledArray/expressions/tsr_expr.h>
+#include <TiledArray/expressions/variable_list.h>
+#include <TiledArray/permutation.h>
+
+#include <string>
+
+namespace TiledArray {
+
+  /// Lazy permuted view of an array
+
+  /// The view is the array <tt>perm * array</tt> without its data; it holds
+  /// a shallow copy of \c array and the permutation, so constructing,
+  /// copying, and assigning views are cheap, local operations. Annotating
+  /// the view creates an expression of \c array with the permuted variable
+  /// list, e.g. for matrices
+  /// \code
+  /// auto at = permuted_view(a, Permutation{1, 0});
+  /// c("i,k") = at("i,j") * b("j,k"); // evaluated as a("j,i") * b("j,k")
+  /// \endcode
+  /// so the expression engines apply the permutation while they evaluate
+  /// the expression, e.g. with the GEMM transposition of a contraction or
+  /// the variable list of the result, and the permuted array is never
+  /// formed.
+  /// \note The bounds of block expressions of the view, e.g.
+  /// <tt>at("i,j").block(lower, upper)</tt> , refer to the modes of \c array .
+  /// \tparam Array The array type
+  template <typename Array>
+  class PermutedView {
+  public:
+    typedef PermutedView<Array> PermutedView_; ///< This class type
+    typedef Array array_type; ///< The array type
+    typedef typename array_type::trange_type trange_type; ///< Tiled range type
+
+  private:
+
+    array_type array_; ///< The array
+    Permutation perm_; ///< The permutation of the modes of the array
+
+    /// Convert a variable list of the view to one of the array
+
+    /// \param vars A string with a comma-separated list of variables
+    /// \return The variables of the modes of the array
+    std::string array_vars(const std::string& vars) const {
+      const expressions::VariableList view_vars(vars);
+      TA_USER_ASSERT(view_vars.dim() == perm_.dim(),
+          "PermutedView: the number of annotation variables is not equal to the array dimension");
+      return (perm_.inv() * view_vars).string();
+    }
+
+  public:
+
+    // Compiler generated functions
+    PermutedView() = default;
+    PermutedView(const PermutedView_&) = default;
+    PermutedView(PermutedView_&&) = default;
+    ~PermutedView() = default;
+    PermutedView_& operator=(const PermutedView_&) = default;
+    PermutedView_& operator=(PermutedView_&&) = default;
+
+    /// Constructor
+
+    /// \param array The array
+    /// \param perm The permutation of the modes of \c array
+    PermutedView(const array_type& array, const Permutation& perm) :
+      array_(array), perm_(perm)
+    {
+      TA_ASSERT(perm_.dim() == array_.trange().rank());
+    }
+
+    /// Array accessor
+
+    /// \return A const reference to the array
+    const array_type& array() const { return array_; }
+
+    /// Permutation accessor
+
+    /// \return A const reference to the permutation of the modes of the array
+    const Permutation& permutation() const { return perm_; }
+
+    /// World accessor
+
+    /// \return A reference to the world of the array
+    World& world() const { return array_.world(); }
+
+    /// Tiled range accessor
+
+    /// \return The tiled range of the view
+    trange_type trange() const { return perm_ * array_.trange(); }
+
+    /// Permute the view
+
+    /// \param perm The permutation of the modes of the view
+    /// \return The view <tt>perm * (*this)</tt> of the same array
+    PermutedView_ permute(const Permutation& perm) const {
+      TA_ASSERT(perm.dim() == perm_.dim());
+      return PermutedView_(array_, perm_ * perm);
+    }
+
+    /// Create a tensor expression
+
+    /// \param vars A string with a comma-separated list of the variables of
+    /// the modes of the view
+    /// \return A const tensor expression of the array
+    expressions::TsrExpr<const array_type, true>
+    operator()(const std::string& vars) const {
+      return array_(array_vars(vars));
+    }
+
+  }; // class PermutedView
+
+  /// Create a lazy permuted view of an array
+
+  /// \tparam Tile The tile type of the array
+  /// \tparam Policy The policy type of the array
+  /// \param array The array
+  /// \param perm The permutation of the modes of \c array
+  /// \return The view <tt>perm * array</tt>
+  template <typename Tile, typename Policy>
+  inline PermutedView<DistArray<Tile, Policy> >
+  permuted_view(const DistArray<Tile, Policy>& array, const Permutation& perm) {
+    return PermutedView<DistArray<Tile, Policy> >(array, perm);
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_SPECIAL_PERMUTED_VIEW_H__INCLUDED
@@ -0,0 +1,190 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  subtile_norms.h
+ *  Dec 13, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_SUBTILE_NORMS_H__INCLUDED
+#define TILEDARRAY_SUBTILE_NORMS_H__INCLUDED
+
+#include <TiledArray/external/madness.h>
+#include <TiledArray/range.h>
+#include <TiledArray/permutation.h>
+#include <TiledArray/perm_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Norms of the slices of tiles
+
+    /// For each mode \c d of a tensor, the elements of every tile are split
+    /// into at most \c segments slices along \c d , i.e. contiguous ranges of
+    /// the element index of mode \c d of near-equal size, and the Frobenius
+    /// norm of each slice is stored. A slice of a tile with extent \c e in
+    /// mode \c d is
+    /// \code
+    /// [ s * e / n, (s + 1) * e / n ), n = min(segments, e)
+    /// \endcode
+    /// so tiles with the same extent in a mode are split the same way; if
+    /// \c e is smaller than \c segments , the trailing slice norms are zero.
+    /// Splitting a product of tiles over the contracted mode gives the bound
+    /// \f$ \|A B\| \le \sum_s \|A_s\| \|B_s\| \f$ , which is never larger, and
+    /// is much smaller if the large elements are in a few slices, than
+    /// \f$ \|A\| \|B\| \f$ .
+    /// \tparam T The norm value type
+    template <typename T>
+    class SubtileNorms {
+    public:
+      typedef T value_type; ///< The norm value type
+      typedef Range::size_type size_type; ///< Size type
+
+    private:
+      Range range_; ///< The tiles range
+      unsigned int segments_; ///< The number of slices per tile and mode
+      std::vector<std::vector<value_type> > norms_; ///< The slice norms of each mode; norms_[d][t * segments_ + s] is the norm of slice s of tile t
+
+    public:
+
+      /// Default constructor
+      SubtileNorms() : range_(), segments_(0u), norms_() { }
+
+      /// Construct zero slice norms
+
+      /// \param range The tiles range
+      /// \param segments The number of slices per tile and mode
+      SubtileNorms(const Range& range, const unsigned int segments) :
+        range_(range), segments_(segments),
+        norms_(range.rank(), std::vector<value_type>(range.volume() * segments, value_type(0)))
+      {
+        TA_ASSERT(segments > 0u);
+      }
+
+      /// Slice of an element
+
+      /// \param extent The extent of the tile
+      /// \param segments The number of slices per tile
+      /// \param x The element index, relative to the lower bound of the tile
+      /// \return The slice that contains \c x
+      static unsigned int segment(const size_type extent,
+          const unsigned int segments, const size_type x)
+      {
+        const size_type n = std::min<size_type>(segments, extent);
+        return (x * n) / extent;
+      }
+
+      /// Add the squared slice norms of a tile
+
+      /// The slice norms are sums of squares until \c finalize() is called.
+      /// \tparam Tile The tile type, which provides \c range() and an ordinal
+      /// element accessor
+      /// \param t The ordinal index of the tile
+      /// \param tile The tile
+      template <typename Tile>
+      void accumulate(const size_type t, const Tile& tile) {
+        TA_ASSERT(range_.includes(t));
+        TA_ASSERT(tile.range().rank() == range_.rank());
+
+        const unsigned int rank = range_.rank();
+        const auto* MADNESS_RESTRICT const extent = tile.range().extent_data();
+        const auto* MADNESS_RESTRICT const stride = tile.range().stride_data();
+        const size_type volume = tile.range().volume();
+        for(size_type i = 0ul; i < volume; ++i) {
+          using std::abs;
+          const value_type abs_i = abs(tile[i]);
+          const value_type norm2 = abs_i * abs_i;
+          for(unsigned int d = 0u; d < rank; ++d) {
+            const size_type x = (i / stride[d]) % extent[d];
+            norms_[d][t * segments_ + segment(extent[d], segments_, x)] += norm2;
+          }
+        }
+      }
+
+      /// Sum the squared slice norms of all processes and take the roots
+
+      /// \note This is a collective operation.
+      /// \param world The world of the processes
+      void finalize(World& world) {
+        for(std::vector<value_type>& norms : norms_) {
+          world.gop.sum(norms.data(), norms.size());
+          for(value_type& norm : norms)
+            norm = std::sqrt(norm);
+        }
+      }
+
+      /// \return The tiles range
+      const Range& range() const { return range_; }
+
+      /// \return The number of slices per tile and mode
+      unsigned int segments() const { return segments_; }
+
+      /// Slice norms accessor
+
+      /// \param d The mode
+      /// \return The slice norms of mode \c d ; the \c segments() norms of
+      /// tile \c t start at offset <tt>t * segments()</tt>
+      const value_type* data(const unsigned int d) const {
+        TA_ASSERT(d < norms_.size());
+        return norms_[d].data();
+      }
+
+      /// Scaled slice norms
+
+      /// \param factor The non-negative scaling factor
+      /// \return A copy of this object with norms scaled by \c factor
+      SubtileNorms scale(const value_type factor) const {
+        SubtileNorms result(*this);
+        for(std::vector<value_type>& norms : result.norms_)
+          for(value_type& norm : norms)
+            norm *= factor;
+        return result;
+      }
+
+      /// Permuted slice norms
+
+      /// \param perm The permutation of the modes
+      /// \return The slice norms of the permuted tensor
+      SubtileNorms perm(const Permutation& perm) const {
+        TA_ASSERT(perm.dim() == range_.rank());
+
+        SubtileNorms result(perm * range_, segments_);
+        const PermIndex perm_index(range_, perm);
+        const size_type volume = range_.volume();
+        for(size_type t = 0ul; t < volume; ++t) {
+          const size_type perm_t = perm_index(t);
+          for(unsigned int d = 0u; d < norms_.size(); ++d)
+            std::copy_n(norms_[d].data() + t * segments_, segments_,
+                result.norms_[perm[d]].data() + perm_t * segments_);
+        }
+
+        return result;
+      }
+
+    }; // class SubtileNorms
+
+  } // namespace detail
+} // namespace TiledArray
+
+#endif // TILEDARRAY_SUBTILE_NORMS_H__INCLUDED
@@ -0,0 +1,397 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  symmetric_array.h
+ *  Nov 4, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_SYMM_SYMMETRIC_ARRAY_H__INCLUDED
+#define TILEDARRAY_SYMM_SYMMETRIC_ARRAY_H__INCLUDED
+
+#include <vector>
+#include <algorithm>
+
+#include <TiledArray/symm/permutation_group.h>
+#include <TiledArray/symm/representation.h>
+#include <TiledArray/dist_array.h>
+#include <TiledArray/permutation.h>
+#include <TiledArray/tiled_range.h>
+#include <TiledArray/sparse_shape.h>
+#include <TiledArray/tile_op/tile_interface.h>
+#include <TiledArray/tile_interface/permute.h>
+
+namespace TiledArray {
+  namespace symmetry {
+
+    /**
+     * \addtogroup symmetry
+     * @{
+     */
+
+    /// Phase of a tile under a symmetry transformation
+
+    /// Phase is the simplest tile representative: identity, negation, complex
+    /// conjugation, or negated complex conjugation. Products are encoded
+    /// bitwise, hence multiplication is XOR.
+    class Phase {
+    public:
+      enum phase_type { _i = 0, _n = 1, _cc = 2, _n_cc = 3 };
+
+      Phase(phase_type t = _i) : type_(t) { }
+      Phase(const Phase&) = default;
+      Phase& operator=(const Phase&) = default;
+
+      static Phase identity() { return Phase(_i); }
+      static Phase negate() { return Phase(_n); }
+      static Phase complex_conjugate() { return Phase(_cc); }
+      static Phase negate_complex_conjugate() { return Phase(_n_cc); }
+
+      /// \return the product of \c this and \c other
+      Phase operator*(const Phase& other) const {
+        return Phase(static_cast<phase_type>(type_ ^ other.type_));
+      }
+
+      bool operator==(const Phase& other) const { return type_ == other.type_; }
+      bool operator!=(const Phase& other) const { return type_ != other.type_; }
+
+      /// Phase type accessor
+      phase_type type() const { return type_; }
+
+      /// Apply the phase to a permuted tile
+
+      /// \tparam Tile The tile type
+      /// \param tile The tile to be transformed
+      /// \param perm The permutation applied to \c tile
+      /// \return The permuted tile, transformed by this phase
+      template <typename Tile>
+      Tile operator()(const Tile& tile, const TiledArray::Permutation& perm) const {
+        using TiledArray::permute;
+        using TiledArray::neg;
+        using TiledArray::conj;
+        switch(type_) {
+          case _n:
+            return neg(tile, perm);
+          case _cc:
+            return conj(tile, perm);
+          case _n_cc:
+            return conj(tile, -1, perm);
+          default:
+            return permute(tile, perm);
+        }
+      }
+
+      template <typename Archive>
+      void serialize(Archive& ar) { ar & type_; }
+
+    private:
+      phase_type type_;
+    }; // class Phase
+
+    template <> inline Phase identity<Phase>() { return Phase::identity(); }
+
+    /// Tile-level permutational symmetry of an array
+
+    /// TileSymmetry maps every tile of a \c TiledRange onto its symmetry-unique
+    /// (canonical) tile, the lexicographically smallest tile index in its
+    /// orbit under the permutation group. A non-unique tile is regenerated
+    /// from its canonical tile by the group element \c g and its
+    /// representative \c op as <tt>tile(g * c) = op(permute(tile(c), g))</tt>.
+    /// \tparam Representative The type of the operator that represents the
+    /// group element on a tile (see \c Phase)
+    template <typename Representative = Phase>
+    class TileSymmetry {
+    public:
+      typedef TileSymmetry<Representative> TileSymmetry_; ///< This object type
+      typedef Representation<PermutationGroup, Representative> representation_type; ///< Representation type
+      typedef Representative representative_type; ///< Tile operator type
+      typedef symmetry::Permutation element_type; ///< Group element type
+      typedef std::size_t size_type; ///< Size type
+
+    private:
+      std::vector<element_type> elements_; ///< Group elements
+      std::vector<representative_type> representatives_; ///< Element representatives
+      std::vector<size_type> canonical_; ///< Canonical ordinal of each tile
+      std::vector<unsigned int> element_; ///< Element that maps the canonical tile onto each tile
+      size_type unique_count_ = 0ul; ///< The number of symmetry-unique tiles
+      unsigned int rank_ = 0u; ///< The rank of the tiled range
+
+      /// Convert a group element to a tensor permutation
+      TiledArray::Permutation ta_perm(const element_type& g) const {
+        std::vector<unsigned int> p(rank_);
+        for(unsigned int i = 0u; i < rank_; ++i)
+          p[i] = g[i];
+        return TiledArray::Permutation(std::move(p));
+      }
+
+    public:
+      TileSymmetry() = default;
+      TileSymmetry(const TileSymmetry_&) = default;
+      TileSymmetry(TileSymmetry_&&) = default;
+      TileSymmetry_& operator=(const TileSymmetry_&) = default;
+      TileSymmetry_& operator=(TileSymmetry_&&) = default;
+
+      /// Constructor
+
+      /// \param rep The representation of the permutation group on tiles
+      /// \param trange The tiled range of the array; it must be invariant
+      /// under every element of the group
+      TileSymmetry(const representation_type& rep, const TiledRange& trange) :
+        rank_(trange.rank())
+      {
+        elements_.reserve(rep.order());
+        representatives_.reserve(rep.order());
+        for(const auto& g_op_pair: rep.representatives()) {
+          const auto& g = g_op_pair.first;
+          for(unsigned int i = 0u; i < rank_; ++i) {
+            TA_USER_ASSERT(g[i] < rank_,
+                "TileSymmetry::TileSymmetry(): permutation domain exceeds the rank of the tiled range");
+            TA_USER_ASSERT(trange.data()[i] == trange.data()[g[i]],
+                "TileSymmetry::TileSymmetry(): tiled range is not invariant under the permutation group");
+          }
+          elements_.push_back(g);
+          representatives_.push_back(g_op_pair.second);
+        }
+
+        // Find the canonical tile of every tile; c = h * t is the smallest
+        // image of t, hence t = h^-1 * c
+        const unsigned int identity = std::distance(elements_.begin(),
+            std::find(elements_.begin(), elements_.end(),
+                      PermutationGroup::identity()));
+        TA_ASSERT(identity < elements_.size());
+        const auto& tiles_range = trange.tiles_range();
+        const size_type volume = tiles_range.volume();
+        canonical_.resize(volume);
+        element_.resize(volume);
+        for(size_type ord = 0ul; ord < volume; ++ord) {
+          const auto t = tiles_range.idx(ord);
+          auto c = t;
+          unsigned int h = identity;
+          for(unsigned int e = 0u; e < elements_.size(); ++e) {
+            auto image = elements_[e] * t;
+            if(image < c) {
+              c = std::move(image);
+              h = e;
+            }
+          }
+          const auto g = elements_[h].inv();
+          canonical_[ord] = tiles_range.ordinal(c);
+          element_[ord] = std::distance(elements_.begin(),
+              std::find(elements_.begin(), elements_.end(), g));
+          if(canonical_[ord] == ord)
+            ++unique_count_;
+        }
+      }
+
+      /// \return The number of tiles covered by this symmetry
+      size_type size() const { return canonical_.size(); }
+
+      /// \return The number of symmetry-unique tiles
+      size_type unique_count() const { return unique_count_; }
+
+      /// Uniqueness query
+
+      /// \param ord The tile ordinal
+      /// \return \c true if \c ord is the canonical tile of its orbit
+      bool is_unique(size_type ord) const {
+        TA_ASSERT(ord < canonical_.size());
+        return canonical_[ord] == ord;
+      }
+
+      /// \param ord The tile ordinal
+      /// \return The ordinal of the canonical tile of \c ord
+      size_type canonical(size_type ord) const {
+        TA_ASSERT(ord < canonical_.size());
+        return canonical_[ord];
+      }
+
+      /// \param ord The tile ordinal
+      /// \return The group element that maps the canonical tile onto \c ord
+      const element_type& element(size_type ord) const {
+        TA_ASSERT(ord < element_.size());
+        return elements_[element_[ord]];
+      }
+
+      /// \param ord The tile ordinal
+      /// \return The operator that maps the canonical tile onto \c ord
+      const representative_type& representative(size_type ord) const {
+        TA_ASSERT(ord < element_.size());
+        return representatives_[element_[ord]];
+      }
+
+      /// \param ord The tile ordinal
+      /// \return The tensor permutation that maps the canonical tile onto \c ord
+      TiledArray::Permutation permutation(size_type ord) const {
+        return ta_perm(element(ord));
+      }
+
+      /// Regenerate a tile from its canonical tile
+
+      /// \tparam Tile The tile type
+      /// \param canonical_tile The canonical tile of \c ord
+      /// \param ord The ordinal of the tile to regenerate
+      /// \return The tile at \c ord
+      template <typename Tile>
+      Tile regenerate(const Tile& canonical_tile, size_type ord) const {
+        return representative(ord)(canonical_tile, permutation(ord));
+      }
+
+      /// Mask of the symmetry-unique tiles
+
+      /// The mask may be passed to \c Expr::set_shape() so that only the
+      /// symmetry-unique tiles of an expression result are evaluated, e.g.
+      /// \code
+      /// c("i,j,a,b") = (t("i,j,c,d") * v("c,d,a,b")).set_shape(mask);
+      /// \endcode
+      /// The contraction engine then skips every tile pair that contributes
+      /// to a redundant result tile. The symmetry-unique tiles have the
+      /// (per-element) norm of a tile of ones, so the mask remains a valid
+      /// shape when it is scaled or combined with other shapes.
+      /// \param trange The tiled range of the array
+      /// \return A shape that is non-zero for symmetry-unique tiles only
+      SparseShape<float> mask(const TiledRange& trange) const {
+        TA_ASSERT(trange.tiles_range().volume() == canonical_.size());
+        Tensor<float> norms(trange.tiles_range(), 0.0f);
+        for(size_type ord = 0ul; ord < canonical_.size(); ++ord)
+          if(is_unique(ord))
+            norms[ord] = 1.0f;
+        return SparseShape<float>(norms, trange, true);
+      }
+
+      /// Shape that contains only symmetry-unique tiles
+
+      /// \param shape The shape of the full array
+      /// \param trange The tiled range of the array
+      /// \return A copy of \c shape where every non-unique tile is zero
+      SparseShape<float> unique_shape(const SparseShape<float>& shape,
+          const TiledRange& trange) const
+      {
+        return shape.mask(mask(trange));
+      }
+
+      /// Shape of the full array
+
+      /// \param shape The shape of the symmetry-unique tiles
+      /// \param trange The tiled range of the array
+      /// \return A shape where every tile has the norm of its canonical tile
+      SparseShape<float> full_shape(const SparseShape<float>& shape,
+          const TiledRange& trange) const
+      {
+        TA_ASSERT(trange.tiles_range().volume() == canonical_.size());
+        const auto& unique_norms = shape.tile_norms();
+        Tensor<float> norms(trange.tiles_range(), 0.0f);
+        for(size_type ord = 0ul; ord < canonical_.size(); ++ord)
+          norms[ord] = unique_norms[canonical_[ord]];
+        return SparseShape<float>(norms, trange);
+      }
+
+    }; // class TileSymmetry
+
+    /// Convert an array to symmetry-unique storage
+
+    /// Only the symmetry-unique tiles of \c array are kept; the result
+    /// shares tiles with \c array.
+    /// \tparam Tile The tile type
+    /// \tparam Rep The representative type
+    /// \param array A (full) array that respects \c symm
+    /// \param symm The tile symmetry
+    /// \return An array that holds only symmetry-unique tiles
+    template <typename Tile, typename Rep>
+    inline DistArray<Tile, SparsePolicy>
+    make_unique(const DistArray<Tile, SparsePolicy>& array,
+        const TileSymmetry<Rep>& symm)
+    {
+      TA_USER_ASSERT(array.size() == symm.size(),
+          "symmetry::make_unique(): array and symmetry tiles do not match");
+      DistArray<Tile, SparsePolicy> result(array.world(), array.trange(),
+          symm.unique_shape(array.shape(), array.trange()), array.pmap());
+      for(const auto ord : *result.pmap())
+        if(! result.is_zero(ord))
+          result.set(ord, array.find(ord));
+      return result;
+    }
+
+    /// Symmetry-aware tile accessor
+
+    /// The canonical tile is fetched and, if \c ord is not symmetry-unique,
+    /// the requested tile is regenerated by a task.
+    /// \tparam Tile The tile type
+    /// \tparam Rep The representative type
+    /// \param array An array that holds symmetry-unique tiles
+    /// \param symm The tile symmetry
+    /// \param ord The ordinal of the requested tile
+    /// \return A future to the tile at \c ord
+    /// \note \c ord must be non-zero, i.e. <tt>is_zero(array, symm, ord)</tt>
+    /// is \c false
+    template <typename Tile, typename Rep>
+    inline Future<Tile>
+    find(const DistArray<Tile, SparsePolicy>& array,
+        const TileSymmetry<Rep>& symm, const std::size_t ord)
+    {
+      const auto canonical_ord = symm.canonical(ord);
+      if(canonical_ord == ord) return array.find(ord);
+      const auto op = symm.representative(ord);
+      const auto perm = symm.permutation(ord);
+      return array.world().taskq.add([op,perm] (const Tile& tile) {
+            return op(tile, perm);
+          }, array.find(canonical_ord));
+    }
+
+    /// Symmetry-aware zero tile query
+
+    /// \param array An array that holds symmetry-unique tiles
+    /// \param symm The tile symmetry
+    /// \param ord The tile ordinal
+    /// \return \c true if tile \c ord is zero
+    template <typename Tile, typename Rep>
+    inline bool is_zero(const DistArray<Tile, SparsePolicy>& array,
+        const TileSymmetry<Rep>& symm, const std::size_t ord)
+    {
+      return array.is_zero(symm.canonical(ord));
+    }
+
+    /// Regenerate the full array from symmetry-unique storage
+
+    /// \tparam Tile The tile type
+    /// \tparam Rep The representative type
+    /// \param array An array that holds symmetry-unique tiles
+    /// \param symm The tile symmetry
+    /// \return The full array
+    template <typename Tile, typename Rep>
+    inline DistArray<Tile, SparsePolicy>
+    expand(const DistArray<Tile, SparsePolicy>& array,
+        const TileSymmetry<Rep>& symm)
+    {
+      TA_USER_ASSERT(array.size() == symm.size(),
+          "symmetry::expand(): array and symmetry tiles do not match");
+      DistArray<Tile, SparsePolicy> result(array.world(), array.trange(),
+          symm.full_shape(array.shape(), array.trange()), array.pmap());
+      for(const auto ord : *result.pmap())
+        if(! result.is_zero(ord))
+          result.set(ord, symmetry::find(array, symm, ord));
+      return result;
+    }
+
+    /** @}*/
+
+  } // namespace symmetry
+} // namespace TiledArray
+
+#endif // TILEDARRAY_SYMM_SYMMETRIC_ARRAY_H__INCLUDED
@@ -20,8 +20,11 @@
 #ifndef TILEDARRAY_TENSOR_TENSOR_H__INCLUDED
 #define TILEDARRAY_TENSOR_TENSOR_H__INCLUDED
 
+#include <TiledArray/external/numa.h>
+#include <TiledArray/memory_usage.h>
 #include <TiledArray/math/gemm_helper.h>
 #include <TiledArray/math/blas.h>
+#include <TiledArray/math/simd.h>
 #include <TiledArray/tensor/kernels.h>
 #include <TiledArray/tensor/complex.h>
 
@@ -70,34 +73,70 @@ namespace TiledArray {
       /// Default constructor
 
       /// Construct an empty tensor that has no data or dimensions
-      Impl() : allocator_type(), range_(), data_(NULL) { }
+      Impl() : allocator_type(), range_(), data_(NULL), bytes_(0ul),
+        category_(MemoryCategory::tiles)
+      { }
 
       /// Construct with range
 
       /// \param range The N-dimensional range for this tensor
       explicit Impl(const range_type& range) :
-        allocator_type(), range_(range), data_(NULL)
+        allocator_type(), range_(range), data_(NULL), bytes_(0ul),
+        category_(MemoryCategory::tiles)
       {
-        data_ = allocator_type::allocate(range.volume());
+        allocate_data(range_.volume());
       }
 
       /// Construct with rvalue range
 
       /// \param range The N-dimensional range for this tensor
       explicit Impl(range_type&& range) :
-        allocator_type(), range_(range), data_(NULL)
+        allocator_type(), range_(range), data_(NULL), bytes_(0ul),
+        category_(MemoryCategory::tiles)
       {
-        data_ = allocator_type::allocate(range.volume());
+        allocate_data(range_.volume());
+      }
+
+      /// Construct a view of the data of another tensor
+
+      /// The view does not own the data; it keeps \c owner alive instead.
+      /// \param range The range of the view, which has the volume of the
+      /// range of \c owner
+      /// \param owner The tensor that owns the data
+      Impl(const range_type& range, const std::shared_ptr<Impl>& owner) :
+        allocator_type(), range_(range), data_(owner->data_), bytes_(0ul),
+        category_(owner->category_), owner_(owner->owner_ ? owner->owner_ : owner)
+      {
+        TA_ASSERT(range_.volume() == owner->range_.volume());
       }
 
       ~Impl() {
-        math::destroy_vector(range_.volume(), data_);
-        allocator_type::deallocate(data_, range_.volume());
+        if(! owner_) {
+          math::destroy_vector(range_.volume(), data_);
+          allocator_type::deallocate(data_, range_.volume());
+          detail::memory_deallocated(category_, bytes_);
+        }
         data_ = NULL;
       }
 
+      /// Allocate the data of this tensor
+
+      /// The allocation is placed by the NUMA policy and accounted in the
+      /// memory category of the calling thread.
+      /// \param n The number of elements
+      void allocate_data(const size_type n) {
+        data_ = allocator_type::allocate(n);
+        detail::numa_place(data_, n * sizeof(value_type));
+        bytes_ = n * sizeof(value_type);
+        category_ = detail::memory_category();
+        detail::memory_allocated(category_, bytes_);
+      }
+
       range_type range_; ///< Tensor size info
       pointer data_; ///< Tensor data
+      std::size_t bytes_; ///< The size of the data in bytes
+      MemoryCategory category_; ///< The memory category of the data
+      std::shared_ptr<Impl> owner_; ///< The tensor that owns the data of a view, or null if this tensor owns it
     }; // class Impl
 
     template <typename... Ts>
@@ -114,6 +153,93 @@ namespace TiledArray {
       math::uninitialized_fill_vector(n, U(), u);
     }
 
+    /// SIMD kernel dispatch flag
+
+    /// \c std::true_type if the element-wise operations of this tensor and a
+    /// \c Right tensor use the SIMD kernels, i.e. both are real,
+    /// floating-point tensors of the same type. The kernels are serial, so
+    /// they are not used when the vector operations are parallelized with TBB.
+    template <typename Right>
+    using use_simd = std::integral_constant<bool,
+#ifdef HAVE_INTEL_TBB
+        false
+#else
+        math::simd::is_simd_type<value_type>::value && std::is_same<Right, Tensor_>::value
+#endif // HAVE_INTEL_TBB
+        >;
+
+    template <math::simd::BinaryOp SimdOp, typename Right, typename Op, typename... Scalar>
+    Tensor_& inplace_binary_simd(std::false_type, const Right& right, Op&& op,
+        const Scalar...)
+    {
+      return inplace_binary(right, op);
+    }
+
+    template <math::simd::BinaryOp SimdOp, typename Right, typename Op, typename... Scalar>
+    Tensor_& inplace_binary_simd(std::true_type, const Right& right, Op&&,
+        const Scalar... factor)
+    {
+      TA_ASSERT(! empty());
+      TA_ASSERT(! right.empty());
+      TA_ASSERT(detail::is_range_set_congruent(*this, right));
+      math::simd::inplace_binary<SimdOp>(range().volume(), right.data(), data(),
+          value_type(factor)...);
+      return *this;
+    }
+
+    template <typename Scalar>
+    void scale_to(std::false_type, const Scalar factor) {
+      inplace_unary([factor] (numeric_type& MADNESS_RESTRICT res) { res *= factor; });
+    }
+
+    template <typename Scalar>
+    void scale_to(std::true_type, const Scalar factor) {
+      TA_ASSERT(! empty());
+      math::simd::scale_to(range().volume(), value_type(factor), data());
+    }
+
+    numeric_type sum(std::false_type) const {
+      auto sum_op = [] (numeric_type& MADNESS_RESTRICT res, const numeric_type arg)
+              { res += arg; };
+      return reduce(sum_op, sum_op, numeric_type(0));
+    }
+
+    numeric_type sum(std::true_type) const {
+      TA_ASSERT(! empty());
+      return math::simd::sum(range().volume(), data());
+    }
+
+    scalar_type squared_norm(std::false_type) const {
+      auto square_op = [] (scalar_type& MADNESS_RESTRICT res, const numeric_type arg)
+              { res += TiledArray::detail::norm(arg); };
+      auto sum_op = [] (scalar_type& MADNESS_RESTRICT res, const scalar_type arg)
+              { res += arg; };
+      return reduce(square_op, sum_op, scalar_type(0));
+    }
+
+    scalar_type squared_norm(std::true_type) const {
+      TA_ASSERT(! empty());
+      return math::simd::squared_norm(range().volume(), data());
+    }
+
+    template <typename Right>
+    numeric_type dot(std::false_type, const Right& other) const {
+      auto mult_add_op = [] (numeric_type& res, const numeric_type l,
+                const numeric_t<Right> r)
+                { res += l * r; };
+      auto add_op = [] (numeric_type& MADNESS_RESTRICT res, const numeric_type value)
+            { res += value; };
+      return reduce(other, mult_add_op, add_op, numeric_type(0));
+    }
+
+    template <typename Right>
+    numeric_type dot(std::true_type, const Right& other) const {
+      TA_ASSERT(! empty());
+      TA_ASSERT(! other.empty());
+      TA_ASSERT(detail::is_range_set_congruent(*this, other));
+      return math::simd::dot(range().volume(), data(), other.data());
+    }
+
     std::shared_ptr<Impl> pimpl_; ///< Shared pointer to implementation object
     static const range_type empty_range_; ///< Empty range
 
@@ -509,7 +635,10 @@ namespace TiledArray {
       ar & n;
       if(n) {
         std::shared_ptr<Impl> temp = std::make_shared<Impl>();
-        temp->data_ = temp->allocate(n);
+        {
+          detail::MemoryCategoryScope scope(MemoryCategory::communication);
+          temp->allocate_data(n);
+        }
         try {
           // need to construct elements of data_ using placement new in case its default ctor is not trivial
           // N.B. for fundamental types and standard alloc this incurs no overhead (Eigen::aligned_alloc OK also)
@@ -521,6 +650,9 @@ namespace TiledArray {
           ar & temp->range_;
         } catch(...) {
           temp->deallocate(temp->data_, n);
+          temp->data_ = NULL;
+          detail::memory_deallocated(temp->category_, temp->bytes_);
+          temp->bytes_ = 0ul;
           throw;
         }
 
@@ -594,13 +726,17 @@ namespace TiledArray {
 
     /// Shift the lower and upper bound of this range
 
+    /// The result shares the data of this tensor, like a copy of it, but
+    /// has its own range, so the data is not copied and the range of this
+    /// tensor is not changed.
     /// \tparam Index The shift array type
     /// \param bound_shift The shift to be applied to the tensor range
-    /// \return A shifted copy of this tensor
+    /// \return A shallow copy of this tensor with a shifted range
     template <typename Index>
     Tensor_ shift(const Index& bound_shift) const {
       TA_ASSERT(pimpl_);
-      Tensor_ result = clone();
+      Tensor_ result;
+      result.pimpl_ = std::make_shared<Impl>(pimpl_->range_, pimpl_);
       result.shift_to(bound_shift);
       return result;
     }
@@ -730,7 +866,8 @@ namespace TiledArray {
     template <typename Scalar,
         typename std::enable_if<detail::is_numeric_v<Scalar>>::type* = nullptr>
     Tensor_& scale_to(const Scalar factor) {
-      return inplace_unary([factor] (numeric_type& MADNESS_RESTRICT res) { res *= factor; });
+      scale_to(use_simd<Tensor_>(), factor);
+      return *this;
     }
 
     // Addition operations
@@ -830,8 +967,8 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& add_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r) { l += r; });
+      return inplace_binary_simd<math::simd::BinaryOp::add>(use_simd<Right>(), right,
+          [] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r) { l += r; });
     }
 
     /// Add \c other to this tensor, and scale the result
@@ -845,9 +982,9 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric_v<Scalar>>::type* = nullptr>
     Tensor_& add_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [factor] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r)
-          { (l += r) *= factor; });
+      return inplace_binary_simd<math::simd::BinaryOp::add>(use_simd<Right>(), right,
+          [factor] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r)
+          { (l += r) *= factor; }, factor);
     }
 
     /// Add a constant to this tensor
@@ -952,8 +1089,8 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& subt_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r)
+      return inplace_binary_simd<math::simd::BinaryOp::subt>(use_simd<Right>(), right,
+          [] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r)
           { l -= r; });
     }
 
@@ -968,9 +1105,9 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric_v<Scalar>>::type* = nullptr>
     Tensor_& subt_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [factor] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r)
-          { (l -= r) *= factor; });
+      return inplace_binary_simd<math::simd::BinaryOp::subt>(use_simd<Right>(), right,
+          [factor] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r)
+          { (l -= r) *= factor; }, factor);
     }
 
     /// Subtract a constant from this tensor
@@ -1056,8 +1193,8 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& mult_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r)
+      return inplace_binary_simd<math::simd::BinaryOp::mult>(use_simd<Right>(), right,
+          [] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r)
           { l *= r; });
     }
 
@@ -1072,9 +1209,9 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric_v<Scalar>>::type* = nullptr>
     Tensor_& mult_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [factor] (numeric_type& MADNESS_RESTRICT l,
-          const numeric_t<Right> r)
-          { (l *= r) *= factor; });
+      return inplace_binary_simd<math::simd::BinaryOp::mult>(use_simd<Right>(), right,
+          [factor] (numeric_type& MADNESS_RESTRICT l, const numeric_t<Right> r)
+          { (l *= r) *= factor; }, factor);
     }
 
     // Negation operations
@@ -1411,11 +1548,7 @@ namespace TiledArray {
     /// Sum of elements
 
     /// \return The sum of all elements of this tensor
-    numeric_type sum() const {
-      auto sum_op = [] (numeric_type& MADNESS_RESTRICT res, const numeric_type arg)
-              { res += arg; };
-      return reduce(sum_op, sum_op, numeric_type(0));
-    }
+    numeric_type sum() const { return sum(use_simd<Tensor_>()); }
 
     /// Product of elements
 
@@ -1429,13 +1562,7 @@ namespace TiledArray {
     /// Square of vector 2-norm
 
     /// \return The vector norm of this tensor
-    scalar_type squared_norm() const {
-      auto square_op = [] (scalar_type& MADNESS_RESTRICT res, const numeric_type arg)
-              { res += TiledArray::detail::norm(arg); };
-      auto sum_op = [] (scalar_type& MADNESS_RESTRICT res, const scalar_type arg)
-              { res += arg; };
-      return reduce(square_op, sum_op, scalar_type(0));
-    }
+    scalar_type squared_norm() const { return squared_norm(use_simd<Tensor_>()); }
 
     /// Vector 2-norm
 
@@ -1504,12 +1631,7 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     numeric_type dot(const Right& other) const {
-      auto mult_add_op = [] (numeric_type& res, const numeric_type l,
-                const numeric_t<Right> r)
-                { res += l * r; };
-      auto add_op = [] (numeric_type& MADNESS_RESTRICT res, const numeric_type value)
-            { res += value; };
-      return reduce(other, mult_add_op, add_op, numeric_type(0));
+      return dot(use_simd<Right>(), other);
     }
 
     /// Vector inner product
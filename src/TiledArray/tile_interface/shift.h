@@ -37,7 +37,8 @@ namespace TiledArray {
   /// \tparam Index An array type
   /// \param arg The tile argument to be shifted
   /// \param range_shift The offset to be applied to the argument range
-  /// \return A copy of the tile with a new range
+  /// \return A copy of the tile with a new range; the copy may share the
+  /// data of \c arg , as \c Tensor does
   template <typename Arg, typename Index>
   inline auto shift(const Arg& arg, const Index& range_shift)
   { return arg.shift(range_shift); }
@@ -160,8 +161,10 @@ namespace TiledArray {
 
   /// Shift the range of tile
 
-  /// This operation creates a deep copy of a tile and shifts the lower and
-  /// upper bounds of the range.
+  /// This operation creates a copy of a tile and shifts the lower and upper
+  /// bounds of the range. The copy shares the data of the tile if the tile
+  /// type does, e.g. \c Tensor , so the result must not be modified in
+  /// place.
   /// \tparam Result The result tile type
   /// \tparam Argument The argument tile type
   template <typename Result, typename Arg>
@@ -0,0 +1,268 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  tuple_reduction.h
+ *  Nov 25, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_TILE_OP_TUPLE_REDUCTION_H__INCLUDED
+#define TILEDARRAY_TILE_OP_TUPLE_REDUCTION_H__INCLUDED
+
+#include <tuple>
+#include <utility>
+
+namespace TiledArray {
+
+  /// The result of a tuple reduction
+
+  /// ReductionTuple is a \c std::tuple that can be serialized, so that all
+  /// results of a tuple reduction are packed into a single message.
+  /// \tparam Ts The result types of the reductions
+  template <typename... Ts>
+  class ReductionTuple : public std::tuple<Ts...> {
+  public:
+    typedef std::tuple<Ts...> tuple_type; ///< The base tuple type
+
+    ReductionTuple() = default;
+    ReductionTuple(const ReductionTuple&) = default;
+    ReductionTuple(ReductionTuple&&) = default;
+    ReductionTuple& operator=(const ReductionTuple&) = default;
+    ReductionTuple& operator=(ReductionTuple&&) = default;
+
+    /// Construct from the result of each reduction
+    explicit ReductionTuple(const Ts&... results) : tuple_type(results...) { }
+
+    template <typename Archive>
+    void serialize(Archive& ar) {
+      serialize(ar, std::index_sequence_for<Ts...>());
+    }
+
+  private:
+
+    template <typename Archive, std::size_t... Is>
+    void serialize(Archive& ar, std::index_sequence<Is...>) {
+      int expand[] = { 0, ((ar & std::get<Is>(*this)), 0)... };
+      (void)expand;
+    }
+
+  }; // class ReductionTuple
+
+  /// Tuple of tile reductions
+
+  /// This reduction operation evaluates several reductions over the same
+  /// tiles in a single pass; the results are packed into a
+  /// \c ReductionTuple, so they are also combined with a single global
+  /// reduction. Unary reductions are applied to the (left-hand) tile, binary
+  /// reductions, e.g. \c DotReduction , to the argument pair, hence unary and
+  /// binary reductions may be mixed when reducing a pair of expressions.
+  /// \sa UnpairedTupleReduction
+  /// \tparam Ops The reduction operation types
+  template <typename... Ops>
+  class TupleReduction {
+  public:
+    // typedefs
+    typedef ReductionTuple<typename Ops::result_type...> result_type;
+
+  private:
+    std::tuple<Ops...> ops_; ///< The reduction operations
+
+    typedef std::index_sequence_for<Ops...> indices;
+
+    template <std::size_t... Is>
+    result_type identity(std::index_sequence<Is...>) const {
+      return result_type(std::get<Is>(ops_)()...);
+    }
+
+    template <std::size_t... Is>
+    result_type post_process(const result_type& result,
+        std::index_sequence<Is...>) const
+    {
+      return result_type(std::get<Is>(ops_)(std::get<Is>(result))...);
+    }
+
+    template <std::size_t... Is>
+    void combine(result_type& result, const result_type& arg,
+        std::index_sequence<Is...>) const
+    {
+      int expand[] = { 0,
+          (std::get<Is>(ops_)(std::get<Is>(result), std::get<Is>(arg)), 0)... };
+      (void)expand;
+    }
+
+    template <typename Arg, std::size_t... Is>
+    void reduce(result_type& result, const Arg& arg,
+        std::index_sequence<Is...>) const
+    {
+      int expand[] = { 0,
+          (std::get<Is>(ops_)(std::get<Is>(result), arg), 0)... };
+      (void)expand;
+    }
+
+    // Binary reductions consume the pair ...
+    template <typename Op, typename Result, typename Left, typename Right>
+    static auto reduce_pair(const Op& op, Result& result, const Left& left,
+        const Right& right, int) -> decltype(op(result, left, right), void())
+    { op(result, left, right); }
+
+    // ... unary reductions consume the left-hand argument
+    template <typename Op, typename Result, typename Left, typename Right>
+    static void reduce_pair(const Op& op, Result& result, const Left& left,
+        const Right&, long)
+    { op(result, left); }
+
+    template <typename Left, typename Right, std::size_t... Is>
+    void reduce(result_type& result, const Left& left, const Right& right,
+        std::index_sequence<Is...>) const
+    {
+      int expand[] = { 0,
+          (reduce_pair(std::get<Is>(ops_), std::get<Is>(result), left, right, 0), 0)... };
+      (void)expand;
+    }
+
+    // Binary reductions of a pair with a zero tile are zero ...
+    template <typename Op, typename Result, typename Left, typename Right>
+    static auto reduce_unpaired(const Op& op, Result& result, const Left& left,
+        const Right* right, int) -> decltype(op(result, left, *right), void())
+    { }
+
+    // ... unary reductions consume the left-hand argument
+    template <typename Op, typename Result, typename Left, typename Right>
+    static void reduce_unpaired(const Op& op, Result& result, const Left& left,
+        const Right*, long)
+    { op(result, left); }
+
+    template <typename Right, typename Left, std::size_t... Is>
+    void reduce_unpaired(result_type& result, const Left& left,
+        std::index_sequence<Is...>) const
+    {
+      const Right* right = nullptr;
+      int expand[] = { 0,
+          (reduce_unpaired(std::get<Is>(ops_), std::get<Is>(result), left, right, 0), 0)... };
+      (void)expand;
+    }
+
+  public:
+
+    TupleReduction() = default;
+    TupleReduction(const TupleReduction&) = default;
+    TupleReduction& operator=(const TupleReduction&) = default;
+
+    /// Constructor
+
+    /// \param ops The reduction operations
+    TupleReduction(const std::tuple<Ops...>& ops) : ops_(ops) { }
+
+    // Reduction functions
+
+    // Make an empty result object
+    result_type operator()() const { return identity(indices()); }
+
+    // Post process the result
+    result_type operator()(const result_type& result) const {
+      return post_process(result, indices());
+    }
+
+    // Reduce two result objects
+    void operator()(result_type& result, const result_type& arg) const {
+      combine(result, arg, indices());
+    }
+
+    // Reduce an argument
+    template <typename Arg>
+    void operator()(result_type& result, const Arg& arg) const {
+      reduce(result, arg, indices());
+    }
+
+    // Reduce an argument pair
+    template <typename Left, typename Right>
+    void operator()(result_type& result, const Left& left,
+        const Right& right) const
+    {
+      reduce(result, left, right, indices());
+    }
+
+    /// Reduce a left-hand argument whose right-hand argument is zero
+
+    /// Only the unary reductions are applied to \c left ; the binary
+    /// reductions of a pair with a zero tile are zero.
+    /// \tparam Right The right-hand argument type
+    /// \tparam Left The left-hand argument type
+    /// \param result The result object
+    /// \param left The left-hand argument
+    template <typename Right, typename Left>
+    void reduce_unpaired(result_type& result, const Left& left) const {
+      reduce_unpaired<Right>(result, left, indices());
+    }
+
+  }; // class TupleReduction
+
+  /// The unary reductions of a tuple reduction of argument pairs
+
+  /// A pair reduction visits only the pairs in which both tiles are
+  /// non-zero. This reduction applies the unary reductions of a
+  /// \c TupleReduction to the left-hand tiles whose right-hand tile is zero,
+  /// so that each unary reduction visits every non-zero tile of its argument.
+  /// \tparam Right The right-hand argument type
+  /// \tparam Ops The reduction operation types
+  template <typename Right, typename... Ops>
+  class UnpairedTupleReduction {
+  public:
+    // typedefs
+    typedef typename TupleReduction<Ops...>::result_type result_type;
+
+  private:
+    TupleReduction<Ops...> op_; ///< The tuple reduction
+
+  public:
+
+    UnpairedTupleReduction() = default;
+    UnpairedTupleReduction(const UnpairedTupleReduction&) = default;
+    UnpairedTupleReduction& operator=(const UnpairedTupleReduction&) = default;
+
+    /// Constructor
+
+    /// \param op The tuple reduction
+    UnpairedTupleReduction(const TupleReduction<Ops...>& op) : op_(op) { }
+
+    // Reduction functions
+
+    // Make an empty result object
+    result_type operator()() const { return op_(); }
+
+    // Post process the result
+    result_type operator()(const result_type& result) const { return result; }
+
+    // Reduce two result objects
+    void operator()(result_type& result, const result_type& arg) const {
+      op_(result, arg);
+    }
+
+    // Reduce a left-hand argument
+    template <typename Left>
+    void operator()(result_type& result, const Left& left) const {
+      op_.template reduce_unpaired<Right>(result, left);
+    }
+
+  }; // class UnpairedTupleReduction
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_TILE_OP_TUPLE_REDUCTION_H__INCLUDED
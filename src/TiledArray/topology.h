@@ -0,0 +1,115 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  topology.h
+ *  Dec 12, 2019
+ *
+ */
+
+#ifndef TILEDARRAY_TOPOLOGY_H__INCLUDED
+#define TILEDARRAY_TOPOLOGY_H__INCLUDED
+
+#include <TiledArray/external/madness.h>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// The maximum number of characters of a host name that are compared
+    constexpr std::size_t max_host_name = 128ul;
+
+    inline std::vector<ProcessID>& node_ids_accessor() {
+      static std::vector<ProcessID> node_ids;
+      return node_ids;
+    }
+
+    /// Gather the node of each rank
+
+    /// Ranks with the same host name are on the same node; nodes are numbered
+    /// in the order of their lowest rank. This is a collective operation,
+    /// which is called by \c TiledArray::initialize() .
+    /// \param world The world of the ranks
+    inline void init_topology(World& world) {
+      const std::size_t nproc = world.size();
+      std::vector<char> names(nproc * max_host_name, 0);
+      char* const name = names.data() + world.rank() * max_host_name;
+      if(gethostname(name, max_host_name) != 0)
+        name[0] = '\0';
+      name[max_host_name - 1ul] = '\0';
+      world.gop.sum(names.data(), names.size());
+
+      std::map<std::string, ProcessID> nodes;
+      std::vector<ProcessID>& node_ids = node_ids_accessor();
+      node_ids.resize(nproc);
+      for(std::size_t p = 0ul; p < nproc; ++p) {
+        const std::string host(names.data() + p * max_host_name);
+        const auto it = nodes.emplace(host, ProcessID(nodes.size())).first;
+        node_ids[p] = it->second;
+      }
+    }
+
+    inline bool& topology_aware_placement_accessor() {
+      static bool enabled = [] () {
+        const char* value = std::getenv("TA_PROC_GRID_TOPOLOGY");
+        return (value != nullptr) && (std::atoi(value) != 0);
+      }();
+      return enabled;
+    }
+
+    /// \return \c true if process grids place ranks by node
+    inline bool topology_aware_placement() {
+      return topology_aware_placement_accessor();
+    }
+
+  } // namespace detail
+
+  /// Enable or disable topology-aware placement of process grid ranks
+
+  /// With topology-aware placement, \c ProcGrid orders the ranks by node so
+  /// that the larger of the SUMMA row and column broadcasts stays within as
+  /// few nodes as possible. This is a collective setting: it
+  /// must have the same value on all ranks when a contraction is evaluated.
+  /// The initial value is read from the \c TA_PROC_GRID_TOPOLOGY environment
+  /// variable [ default = 0 ].
+  /// \param enable \c true to enable topology-aware placement
+  inline void set_proc_grid_topology(const bool enable) {
+    detail::topology_aware_placement_accessor() = enable;
+  }
+
+  /// \return \c true if process grids place ranks by node
+  inline bool proc_grid_topology() { return detail::topology_aware_placement(); }
+
+  /// The nodes of the ranks of the default world
+
+  /// \return The node of each rank, or an empty vector if TiledArray has not
+  /// been initialized
+  inline const std::vector<ProcessID>& node_ids() {
+    return detail::node_ids_accessor();
+  }
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_TOPOLOGY_H__INCLUDED
@@ -30,7 +30,9 @@
 #include <TiledArray/error.h>
 #include <TiledArray/type_traits.h>
 #include <atomic>
+#include <cstdlib>
 #include <iosfwd>
+#include <string>
 #include <vector>
 #include <array>
 #include <initializer_list>
@@ -39,6 +41,26 @@
 namespace TiledArray {
   namespace detail {
 
+    inline std::size_t& eval_chunk_volume_accessor() {
+      static std::size_t volume = [] () {
+        const char* chunk_volume = std::getenv("TA_EVAL_CHUNK_VOLUME");
+        return (chunk_volume ? std::size_t(std::stoul(chunk_volume)) : 0ul);
+      }();
+      return volume;
+    }
+
+    /// Tile volume threshold for coalescing element-wise tile tasks
+
+    /// \return The chunk volume threshold, in elements; zero if coalescing
+    /// is disabled
+    /// \sa TiledArray::set_eval_chunk_volume()
+    inline std::size_t eval_chunk_volume() {
+      return eval_chunk_volume_accessor();
+    }
+
+    /// Maximum number of tiles evaluated by one coalesced task
+    constexpr std::size_t eval_chunk_max_tiles = 64ul;
+
 #if __cplusplus <= 201402L
 
     /// Array size accessor
@@ -203,6 +225,21 @@ namespace TiledArray {
     return detail::ignore_tile_position_accessor();
   }
 
+  /// Set the tile volume threshold for coalescing element-wise tile tasks
+
+  /// Element-wise evaluators group consecutive local tiles that are
+  /// smaller than this threshold into a single task, until the combined
+  /// volume of the group reaches the threshold, so that arrays of many
+  /// small tiles are not bound by task overhead. Coalescing delays the
+  /// evaluation of a tile until all argument tiles of its group are
+  /// available, so it is opt-in. The initial value is read from the
+  /// \c TA_EVAL_CHUNK_VOLUME environment variable [ default = 0 ].
+  /// \param volume The chunk volume threshold, in elements; zero disables
+  /// coalescing
+  inline void set_eval_chunk_volume(const std::size_t volume) {
+    detail::eval_chunk_volume_accessor() = volume;
+  }
+
 } // namespace TiledArray
 
 namespace std {
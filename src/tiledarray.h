@@ -36,15 +36,19 @@
 // Expression functionality
 #include <TiledArray/expressions/scal_expr.h>
 #include <TiledArray/expressions/tsr_expr.h>
+#include <TiledArray/expressions/einsum.h>
 #include <TiledArray/conversions/sparse_to_dense.h>
 #include <TiledArray/conversions/dense_to_sparse.h>
 #include <TiledArray/conversions/to_new_tile_type.h>
 #include <TiledArray/conversions/truncate.h>
 #include <TiledArray/conversions/foreach.h>
 #include <TiledArray/conversions/make_array.h>
+#include <TiledArray/conversions/rebalance.h>
+#include <TiledArray/conversions/subtile_norms.h>
 
 // Special Arrays
 #include <TiledArray/special/diagonal_array.h>
+#include <TiledArray/special/permuted_view.h>
 
 // Process maps
 #include <TiledArray/pmap/hash_pmap.h>
@@ -55,6 +59,9 @@
 
 // Linear algebra
 #include <TiledArray/algebra/conjgrad.h>
+#include <TiledArray/algebra/davidson.h>
+#include <TiledArray/algebra/cholesky.h>
+#include <TiledArray/algebra/matrix_functions.h>
 #include <TiledArray/dist_array.h>
 
 #ifdef TILEDARRAY_HAS_ELEMENTAL
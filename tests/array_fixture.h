@@ -44,5 +44,29 @@ struct ArrayFixture : public TiledRangeFixture {
   SpArrayN b;
 }; // struct ArrayFixture
 
+/// Gather a replicated copy of every element of \c array
+
+/// This is a collective operation; zero tiles contribute zeros.
+/// \tparam Array The array type
+/// \param array The array to gather
+/// \return The elements of \c array in row-major order
+template <typename Array>
+std::vector<double> gather(const Array& array) {
+  std::vector<double> result(array.trange().elements_range().volume(), 0.0);
+  const auto& pmap = *array.pmap();
+  for(const auto ord : pmap) {
+    // with a replicated pmap every rank holds every tile, so only the owner
+    // of each tile contributes it
+    if(array.is_zero(ord) || (!pmap.is_replicated() && pmap.owner(ord) != pmap.rank()))
+      continue;
+    const auto tile = array.find(ord).get();
+    for(const auto& idx : tile.range())
+      result[array.trange().elements_range().ordinal(idx)] = tile[idx];
+  }
+  if(!pmap.is_replicated())
+    GlobalFixture::world->gop.sum(result.data(), result.size());
+  return result;
+}
+
 
 #endif // TILEDARRAY_TEST_ARRAY_FIXTURE_H__INCLUDED
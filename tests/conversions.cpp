@@ -199,6 +199,73 @@ BOOST_AUTO_TEST_CASE(make_array_test) {
   BOOST_CHECK_NO_THROW(
       auto b_sparse = make_array<TSpArrayI>(*GlobalFixture::world, this->tr,
                                             &this->init_rand_tile<TensorI>));
+
+  // make sparse array from estimated norms; tiles in the first row of tiles
+  // are screened out and must not be computed
+  auto pmap = TSpArrayI::policy_type::default_pmap(
+      *GlobalFixture::world, this->tr.tiles_range().volume());
+  std::atomic<std::size_t> computed{0ul};
+  TSpArrayI c_sparse;
+  BOOST_CHECK_NO_THROW(c_sparse = make_array<TSpArrayI>(
+      *GlobalFixture::world, this->tr, pmap,
+      [](const Range& range) -> float {
+        return (range.lobound(0) == 0 ? 0.0f : float(range.volume()));
+      },
+      [&computed](TensorI& tile, const Range& range) {
+        tile = TensorI(range, 1);
+        ++computed;
+      }));
+  GlobalFixture::world->gop.fence();
+
+  std::size_t local_nonzero = 0ul;
+  for (std::size_t i = 0; i < c_sparse.size(); i++) {
+    const Range range = this->tr.make_tile_range(i);
+    if (range.lobound(0) == 0) {
+      BOOST_CHECK(c_sparse.is_zero(i));
+    } else {
+      BOOST_REQUIRE(!c_sparse.is_zero(i));
+      if (c_sparse.is_local(i)) {
+        ++local_nonzero;
+        const TensorI tile = c_sparse.find(i).get();
+        for (std::size_t j = 0ul; j < tile.size(); ++j)
+          BOOST_CHECK_EQUAL(tile[j], 1);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(computed.load(), local_nonzero);
+}
+
+BOOST_AUTO_TEST_CASE(rebalance_test) {
+  // all the weight is on process 0
+  std::vector<std::size_t> owners(12, 0ul), weights(12, 10ul);
+  weights[11] = 0ul;
+  const auto balanced = detail::balance_tiles(owners, weights, 4ul, 0.1);
+  std::vector<std::size_t> loads(4, 0ul);
+  for (std::size_t i = 0; i < owners.size(); i++)
+    loads[balanced[i]] += weights[i];
+  for (std::size_t p = 0; p < loads.size(); p++)
+    BOOST_CHECK_LE(loads[p], 30ul);
+  BOOST_CHECK_EQUAL(balanced[11], 0ul);  // zero tiles do not move
+
+  // a balanced distribution is left alone
+  for (std::size_t i = 0; i < owners.size(); i++) owners[i] = i % 4;
+  BOOST_CHECK(detail::balance_tiles(owners, weights, 4ul, 0.1) == owners);
+
+  TSpArrayI b_sparse;
+  BOOST_CHECK_NO_THROW(b_sparse = rebalance(a_sparse));
+
+  // check correctness
+  for (std::size_t i = 0; i < a_sparse.size(); i++) {
+    if (!a_sparse.is_zero(i)) {
+      TSpArrayI::value_type a_tile = a_sparse.find(i).get();
+      TSpArrayI::value_type b_tile = b_sparse.find(i).get();
+
+      for (std::size_t j = 0ul; j < a_tile.size(); ++j)
+        BOOST_CHECK_EQUAL(a_tile[j], b_tile[j]);
+    } else {
+      BOOST_CHECK(b_sparse.is_zero(i));
+    }
+  }
 }
 
 BOOST_AUTO_TEST_CASE(vector_of_arrays_unit_blocking){
@@ -24,8 +24,11 @@
  */
 
 #include <array_fixture.h>
+#include <chrono>
+#include <thread>
 
 #include "TiledArray/dist_eval/binary_eval.h"
+#include "TiledArray/pmap/cyclic_pmap.h"
 #include "tiledarray.h"
 #include "unit_test_config.h"
 
@@ -225,4 +228,102 @@ BOOST_AUTO_TEST_CASE( perm_eval )
 
 }
 
+BOOST_AUTO_TEST_CASE( chunked_eval )
+{
+  // Seven tiles of two elements, coalesced three at a time, so that the last
+  // chunk of a rank is partially filled
+  const TiledRange trange{TiledRange1{0, 2, 4, 6, 8, 10, 12, 14}};
+  TArrayI a(*GlobalFixture::world, trange), b(*GlobalFixture::world, trange);
+  a.fill_local(1);
+  b.fill_local(2);
+
+  const std::size_t chunk_volume = TiledArray::detail::eval_chunk_volume();
+  TiledArray::set_eval_chunk_volume(6ul);
+
+  auto left_arg = make_array_eval(a, a.world(), DenseShape(),
+      a.pmap(), Permutation(), make_array_noop());
+  auto right_arg = make_array_eval(b, b.world(), DenseShape(),
+      a.pmap(), Permutation(), make_array_noop());
+
+  auto dist_eval = make_binary_eval(left_arg, right_arg,
+      left_arg.world(), DenseShape(), left_arg.pmap(), Permutation(), make_add());
+
+  BOOST_REQUIRE_NO_THROW(dist_eval.eval());
+  BOOST_REQUIRE_NO_THROW(dist_eval.wait());
+
+  for(auto index : * dist_eval.pmap()) {
+    TensorI eval_tile;
+    BOOST_REQUIRE_NO_THROW(eval_tile = dist_eval.get(index).get());
+
+    BOOST_CHECK_EQUAL(eval_tile.range(), trange.make_tile_range(index));
+    for(std::size_t i = 0ul; i < eval_tile.size(); ++i)
+      BOOST_CHECK_EQUAL(eval_tile[i], 3);
+  }
+
+  GlobalFixture::world->gop.fence();
+  TiledArray::set_eval_chunk_volume(chunk_volume);
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_eval )
+{
+  World& world = *GlobalFixture::world;
+  const bool work_stealing = TiledArray::work_stealing();
+  TiledArray::set_work_stealing(true);
+
+  // Every tile is evaluated by rank 0, so the other ranks evaluate tiles only
+  // if they steal them
+  const std::shared_ptr<TiledArray::Pmap> pmap =
+      std::make_shared<TiledArray::detail::CyclicPmap>(world, 1ul,
+          tr.tiles_range().volume(), 1ul, 1ul);
+  auto left_arg = make_array_eval(left, world, DenseShape(), pmap,
+      Permutation(), make_array_noop());
+  auto right_arg = make_array_eval(right, world, DenseShape(), pmap,
+      Permutation(), make_array_noop());
+
+  auto dist_eval = make_binary_eval(left_arg, right_arg, world, DenseShape(),
+      pmap, Permutation(), make_add());
+  using dist_eval_type = decltype(dist_eval);
+
+  // The threads of rank 0 are kept busy until the other ranks have asked it
+  // for work; the requests are high-priority tasks, so they run before the
+  // tile tasks of rank 0. The other ranks wait for rank 0 to register its
+  // tiles before they ask.
+  const auto delay = std::chrono::milliseconds(500);
+  if(world.rank() == 0) {
+    for(std::size_t t = 0ul; t < madness::ThreadPool::size(); ++t)
+      world.taskq.add([delay] () { std::this_thread::sleep_for(delay); });
+  } else {
+    std::this_thread::sleep_for(delay / 5);
+  }
+  const std::size_t stolen = TiledArray::work_stealing_count();
+
+  BOOST_REQUIRE_NO_THROW(dist_eval.eval());
+  if(world.rank() == 0)
+    std::this_thread::sleep_for(delay / 2);
+  BOOST_REQUIRE_NO_THROW(dist_eval.wait());
+
+  // Tiles that were evaluated by other ranks are sent to their owner
+  for(auto index : * dist_eval.pmap()) {
+    const TArrayI::value_type left_tile = left.find(index);
+    const TArrayI::value_type right_tile = right.find(index);
+
+    dist_eval_type::eval_type eval_tile;
+    BOOST_REQUIRE_NO_THROW(eval_tile = dist_eval.get(index).get());
+
+    BOOST_CHECK_EQUAL(eval_tile.range(), left_tile.range());
+    for(std::size_t i = 0ul; i < eval_tile.size(); ++i) {
+      BOOST_CHECK_EQUAL(eval_tile[i], left_tile[i] + right_tile[i]);
+    }
+  }
+
+  // Some tiles of rank 0 were stolen
+  std::size_t count = TiledArray::work_stealing_count() - stolen;
+  world.gop.sum(count);
+  if(world.size() > 1)
+    BOOST_CHECK_GE(count, 1ul);
+
+  world.gop.fence();
+  TiledArray::set_work_stealing(work_stealing);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
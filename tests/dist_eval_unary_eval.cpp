@@ -184,6 +184,38 @@ BOOST_AUTO_TEST_CASE( eval )
   }
 }
 
+BOOST_AUTO_TEST_CASE( chunked_eval )
+{
+  // Seven tiles of two elements, coalesced three at a time, so that the last
+  // chunk of a rank is partially filled
+  const TiledRange trange{TiledRange1{0, 2, 4, 6, 8, 10, 12, 14}};
+  TArrayI a(*GlobalFixture::world, trange);
+  a.fill_local(2);
+
+  const std::size_t chunk_volume = TiledArray::detail::eval_chunk_volume();
+  TiledArray::set_eval_chunk_volume(6ul);
+
+  auto a_arg = make_array_eval(a, a.world(), DenseShape(),
+      a.pmap(), Permutation(), array_op_type(array_op_base_type()));
+  auto dist_eval = make_unary_eval(a_arg, a_arg.world(),
+      DenseShape(), a_arg.pmap(), Permutation(), make_scal0(3));
+
+  BOOST_REQUIRE_NO_THROW(dist_eval.eval());
+  BOOST_REQUIRE_NO_THROW(dist_eval.wait());
+
+  for(auto index : *dist_eval.pmap()) {
+    TensorI eval_tile;
+    BOOST_REQUIRE_NO_THROW(eval_tile = dist_eval.get(index).get());
+
+    BOOST_CHECK_EQUAL(eval_tile.range(), trange.make_tile_range(index));
+    for(std::size_t i = 0ul; i < eval_tile.size(); ++i)
+      BOOST_CHECK_EQUAL(eval_tile[i], 6);
+  }
+
+  GlobalFixture::world->gop.fence();
+  TiledArray::set_eval_chunk_volume(chunk_volume);
+}
+
 BOOST_AUTO_TEST_CASE( double_eval )
 {
   /// Construct a scaling unary evaluator
@@ -0,0 +1,142 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  expressions_diagonal.cpp
+ *  Dec 9, 2019
+ *
+ */
+
+#include <tiledarray.h>
+#include "unit_test_config.h"
+#include "array_fixture.h"
+
+using namespace TiledArray;
+
+typedef boost::mpl::list<
+    TArrayD,
+    TSpArrayD
+> array_types;
+
+struct DiagonalExprFixture {
+
+  DiagonalExprFixture() :
+    tr_i{0, 2, 5, 9},
+    tr_j{0, 3, 4, 7},
+    diag_i(9), diag_j(7)
+  {
+    for(std::size_t i = 0ul; i < diag_i.size(); ++i)
+      diag_i[i] = 1.0 + 0.5 * i;
+    for(std::size_t j = 0ul; j < diag_j.size(); ++j)
+      diag_j[j] = (j % 2 ? -1.0 : 2.0) * (j + 1);
+  }
+
+  ~DiagonalExprFixture() { GlobalFixture::world->gop.fence(); }
+
+  TiledRange1 tr_i, tr_j;
+  std::vector<double> diag_i, diag_j;
+}; // DiagonalExprFixture
+
+BOOST_FIXTURE_TEST_SUITE( expressions_diagonal_suite, DiagonalExprFixture )
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( scale, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_j});
+  a.fill_random();
+  const DiagonalMatrix<double> e_i(tr_i, diag_i), e_j(tr_j, diag_j);
+
+  Array left, right, left_t;
+  BOOST_REQUIRE_NO_THROW(left("i,j") = e_i("i,k") * a("k,j"));
+  BOOST_REQUIRE_NO_THROW(right("i,j") = a("i,k") * e_j("k,j"));
+  BOOST_REQUIRE_NO_THROW(left_t("j,i") = e_i("i,k") * a("k,j"));
+  BOOST_CHECK_EQUAL(left.trange(), a.trange());
+  BOOST_CHECK_EQUAL(left_t.trange(), (TiledRange{tr_j, tr_i}));
+
+  const auto a_data = gather(a);
+  const auto left_data = gather(left);
+  const auto right_data = gather(right);
+  const auto left_t_data = gather(left_t);
+  const std::size_t ni = diag_i.size(), nj = diag_j.size();
+  for(std::size_t i = 0ul; i < ni; ++i) {
+    for(std::size_t j = 0ul; j < nj; ++j) {
+      const double aij = a_data[i * nj + j];
+      BOOST_CHECK_CLOSE(left_data[i * nj + j] + 1.0, diag_i[i] * aij + 1.0, 1e-10);
+      BOOST_CHECK_CLOSE(right_data[i * nj + j] + 1.0, aij * diag_j[j] + 1.0, 1e-10);
+      BOOST_CHECK_CLOSE(left_t_data[j * ni + i] + 1.0, diag_i[i] * aij + 1.0, 1e-10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( explicit_diagonal, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_j});
+  a.fill_random();
+
+  // the implicit identity reproduces the contraction with an explicit one
+  const DiagonalMatrix<double> e(tr_i);
+  auto identity = diagonal_array<double, typename Array::policy_type>(world,
+      TiledRange{tr_i, tr_i});
+
+  Array implicit_result, explicit_result;
+  implicit_result("i,j") = e("i,k") * a("k,j");
+  explicit_result("i,j") = identity("i,k") * a("k,j");
+
+  const double error =
+      (implicit_result("i,j") - explicit_result("i,j")).norm().get();
+  BOOST_CHECK_SMALL(error, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE( from_vector )
+{
+  World& world = *GlobalFixture::world;
+  TArrayD v(world, TiledRange{tr_i});
+  for(const auto ord : *v.pmap()) {
+    TensorD tile(v.trange().make_tile_range(ord));
+    for(const auto& idx : tile.range())
+      tile[idx] = diag_i[idx[0]];
+    v.set(ord, tile);
+  }
+
+  const DiagonalMatrix<double> e(v);
+  BOOST_CHECK(e.trange() == tr_i);
+  BOOST_CHECK(e.diagonal() == diag_i);
+}
+
+BOOST_AUTO_TEST_CASE( from_replicated_vector )
+{
+  World& world = *GlobalFixture::world;
+  const TiledRange trange{tr_i};
+  TArrayD v(world, trange, DenseShape(),
+      std::make_shared<detail::ReplicatedPmap>(world, trange.tiles_range().volume()));
+  for(const auto ord : *v.pmap()) {
+    TensorD tile(v.trange().make_tile_range(ord));
+    for(const auto& idx : tile.range())
+      tile[idx] = diag_i[idx[0]];
+    v.set(ord, tile);
+  }
+
+  // every rank stores every tile, which must not be counted once per rank
+  const DiagonalMatrix<double> e(v);
+  BOOST_CHECK(e.trange() == tr_i);
+  BOOST_CHECK(e.diagonal() == diag_i);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
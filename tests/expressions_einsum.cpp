@@ -0,0 +1,157 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  expressions_einsum.cpp
+ *  Nov 11, 2019
+ *
+ */
+
+#include <tiledarray.h>
+#include "unit_test_config.h"
+#include "array_fixture.h"
+
+using namespace TiledArray;
+
+typedef boost::mpl::list<
+    TArrayD,
+    TSpArrayD
+> array_types;
+
+struct EinsumFixture {
+
+  EinsumFixture() :
+    tr_i{0, 2, 5},
+    tr_a{0, 3, 4, 7},
+    tr_k{0, 4, 6},
+    tr_b{0, 1, 3}
+  { }
+
+  ~EinsumFixture() { GlobalFixture::world->gop.fence(); }
+
+  TiledRange1 tr_i, tr_a, tr_k, tr_b;
+}; // EinsumFixture
+
+BOOST_FIXTURE_TEST_SUITE( expressions_einsum_suite, EinsumFixture )
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( batch_contraction, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_a, tr_k});
+  Array b(world, TiledRange{tr_i, tr_k, tr_b});
+  a.fill_random();
+  b.fill_random();
+
+  Array c;
+  BOOST_REQUIRE_NO_THROW(c = einsum(a("i,a,k"), b("i,k,b"), "i,a,b"));
+  BOOST_CHECK_EQUAL(c.trange(), (TiledRange{tr_i, tr_a, tr_b}));
+
+  // permuted arguments and result
+  Array d;
+  BOOST_REQUIRE_NO_THROW(d = einsum(a("i,a,k"), b("i,k,b"), "b,i,a"));
+  Array e;
+  BOOST_REQUIRE_NO_THROW(e("i,a,b") = d("b,i,a"));
+
+  const auto a_data = gather(a);
+  const auto b_data = gather(b);
+  const auto c_data = gather(c);
+  const auto e_data = gather(e);
+
+  const std::size_t ni = tr_i.elements_range().second;
+  const std::size_t na = tr_a.elements_range().second;
+  const std::size_t nk = tr_k.elements_range().second;
+  const std::size_t nb = tr_b.elements_range().second;
+  for(std::size_t i = 0ul; i < ni; ++i)
+    for(std::size_t x = 0ul; x < na; ++x)
+      for(std::size_t y = 0ul; y < nb; ++y) {
+        double expected = 0.0;
+        for(std::size_t k = 0ul; k < nk; ++k)
+          expected += a_data[(i * na + x) * nk + k] * b_data[(i * nk + k) * nb + y];
+        BOOST_CHECK_CLOSE(c_data[(i * na + x) * nb + y], expected, 1e-10);
+        BOOST_CHECK_CLOSE(e_data[(i * na + x) * nb + y], expected, 1e-10);
+      }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( no_batch_indices, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_a, tr_k});
+  Array b(world, TiledRange{tr_k, tr_b});
+  a.fill_random();
+  b.fill_random();
+
+  Array c, d;
+  BOOST_REQUIRE_NO_THROW(c = einsum(a("i,a,k"), b("k,b"), "i,a,b"));
+  BOOST_REQUIRE_NO_THROW(d("i,a,b") = a("i,a,k") * b("k,b"));
+  BOOST_CHECK_SMALL((c("i,a,b") - d("i,a,b")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( batch_outer_product, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_a});
+  Array b(world, TiledRange{tr_i, tr_b});
+  a.fill_random();
+  b.fill_random();
+
+  Array c;
+  BOOST_REQUIRE_NO_THROW(c = einsum(a("i,a"), b("i,b"), "i,a,b"));
+  BOOST_CHECK_EQUAL(c.trange(), (TiledRange{tr_i, tr_a, tr_b}));
+
+  const auto a_data = gather(a);
+  const auto b_data = gather(b);
+  const auto c_data = gather(c);
+
+  const std::size_t ni = tr_i.elements_range().second;
+  const std::size_t na = tr_a.elements_range().second;
+  const std::size_t nb = tr_b.elements_range().second;
+  for(std::size_t i = 0ul; i < ni; ++i)
+    for(std::size_t x = 0ul; x < na; ++x)
+      for(std::size_t y = 0ul; y < nb; ++y)
+        BOOST_CHECK_CLOSE(c_data[(i * na + x) * nb + y],
+            a_data[i * na + x] * b_data[i * nb + y], 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( hadamard_product, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_a});
+  Array b(world, TiledRange{tr_i, tr_a});
+  a.fill_random();
+  b.fill_random();
+
+  Array c;
+  BOOST_REQUIRE_NO_THROW(c = einsum(a("i,a"), b("i,a"), "i,a"));
+  BOOST_CHECK_EQUAL(c.trange(), (TiledRange{tr_i, tr_a}));
+
+  const auto a_data = gather(a);
+  const auto b_data = gather(b);
+  const auto c_data = gather(c);
+  for(std::size_t i = 0ul; i < c_data.size(); ++i)
+    BOOST_CHECK_CLOSE(c_data[i], a_data[i] * b_data[i], 1e-10);
+
+  // permuted argument
+  Array d;
+  BOOST_REQUIRE_NO_THROW(d = einsum(a("i,a"), b("i,a"), "a,i"));
+  Array e;
+  BOOST_REQUIRE_NO_THROW(e("i,a") = d("a,i"));
+  BOOST_CHECK_SMALL((c("i,a") - e("i,a")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
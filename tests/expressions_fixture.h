@@ -108,6 +108,30 @@ struct ExpressionsFixture : public TiledRangeFixture {
     return TA::DistArray<Tile, Policy>(*GlobalFixture::world, range);
   }
 
+  /// make an array for SparsePolicy whose diagonal tiles are zero
+  template <typename P = Policy,
+          std::enable_if_t<
+                  std::is_same<P, TiledArray::SparsePolicy>::value>* = nullptr>
+  static TA::DistArray<Tile, Policy> make_offdiagonal_array(
+          const TA::TiledRange& range) {
+    Tensor<float> norms(range.tiles_range(), 1.0);
+    for (const auto& idx : range.tiles_range())
+      if (std::adjacent_find(idx.begin(), idx.end(),
+                             std::not_equal_to<std::size_t>()) == idx.end())
+        norms[idx] = 0.0;
+    return TA::DistArray<Tile, Policy>(*GlobalFixture::world, range,
+                                       SparseShape<float>(norms, range));
+  }
+
+  /// make an array for DensePolicy, which has no zero tiles
+  template <typename P = Policy,
+          std::enable_if_t<std::is_same<P, TiledArray::DensePolicy>::value>* =
+          nullptr>
+  static TA::DistArray<Tile, Policy> make_offdiagonal_array(
+          const TA::TiledRange& range) {
+    return TA::DistArray<Tile, Policy>(*GlobalFixture::world, range);
+  }
+
   /// randomly fill an array
   static void random_fill(DistArray<Tile, Policy>& array) {
     auto it = array.pmap()->begin();
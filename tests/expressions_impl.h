@@ -2851,6 +2851,46 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(dot_contr, F, Fixtures, F) {
         (a("a,b,c") * b("d,b,c")).dot(b("d,e,f") * a("a,e,f")));
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(dot_contr_fused, F, Fixtures, F) {
+  auto& a = F::a;
+  auto& b = F::b;
+  TiledRange trange{F::tr.data()[0], F::tr.data()[0]};
+  // the diagonal tiles of x are zero, unless it is dense
+  auto x = F::make_offdiagonal_array(trange);
+  F::random_fill(x);
+
+  // The tiles of the contraction that are multiplied by zero tiles of x
+  // are masked out of its shape
+  {
+    const auto ab_expr = a("a,b,c") * b("d,b,c");
+    typename std::decay_t<decltype(ab_expr)>::engine_type engine(ab_expr);
+    engine.init(*GlobalFixture::world,
+                std::shared_ptr<typename F::TArray::pmap_interface>(),
+                VariableList("a,d"));
+    engine.mask_shape(x.shape());
+    for (std::size_t i = 0ul; i < x.size(); ++i)
+      if (x.is_zero(i)) BOOST_CHECK(engine.shape().is_zero(i));
+  }
+
+  // The contraction is reduced without forming the result array, and its
+  // tiles that are multiplied by zero tiles of x are skipped
+  typename F::element_type result = 0;
+  BOOST_REQUIRE_NO_THROW(
+      result = (a("a,b,c") * b("d,b,c")).dot(x("a,d")).get());
+
+  // Compute the expected value with the contraction result
+  decltype(x) ab;
+  ab("a,d") = a("a,b,c") * b("d,b,c");
+  typename F::element_type expected = 0;
+  BOOST_REQUIRE_NO_THROW(expected = ab("a,d").dot(x("a,d")).get());
+  BOOST_CHECK_EQUAL(result, expected);
+
+  result = 0;
+  BOOST_REQUIRE_NO_THROW(
+      result = x("a,d").dot(a("a,b,c") * b("d,b,c")).get());
+  BOOST_CHECK_EQUAL(result, expected);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(inner_product, F, Fixtures, F) {
   // Test the inner_product expression function
   auto x = F::make_array(F::tr);
@@ -2876,6 +2916,39 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(inner_product, F, Fixtures, F) {
   BOOST_CHECK_EQUAL(result, expected);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(tuple_reduce, F, Fixtures, F) {
+  using tile_type = typename F::TArray::value_type;
+  auto& a = F::a;
+  auto& b = F::b;
+
+  // Evaluate several reductions of an expression in a single pass
+  const auto ops =
+      std::make_tuple(TiledArray::SquaredNormReduction<tile_type>(),
+                      TiledArray::AbsMaxReduction<tile_type>(),
+                      TiledArray::SumReduction<tile_type>());
+  auto unary_result = (a("a,b,c") - b("a,b,c")).reduce(ops).get();
+  BOOST_CHECK_CLOSE(std::get<0>(unary_result),
+                    (a("a,b,c") - b("a,b,c")).squared_norm().get(), 1e-10);
+  BOOST_CHECK_EQUAL(std::get<1>(unary_result),
+                    (a("a,b,c") - b("a,b,c")).abs_max().get());
+  BOOST_CHECK_SMALL(std::abs(std::get<2>(unary_result) -
+                             (a("a,b,c") - b("a,b,c")).sum().get()),
+                    1e-8);
+
+  // Mix unary reductions of the left-hand argument with binary reductions
+  const auto pair_ops = std::make_tuple(
+      TiledArray::SquaredNormReduction<tile_type>(),
+      TiledArray::DotReduction<tile_type, tile_type>());
+  auto binary_result = a("a,b,c").reduce(b("a,b,c"), pair_ops).get();
+
+  // The unary reduction visits every non-zero tile of the left-hand argument
+  const auto norm = a("a,b,c").norm().get();
+  BOOST_CHECK_CLOSE(std::get<0>(binary_result), norm * norm, 1e-10);
+  BOOST_CHECK_SMALL(std::abs(std::get<1>(binary_result) -
+                             a("a,b,c").dot(b("a,b,c")).get()),
+                    1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif  // TILEDARRAY_TEST_EXPRESSIONS_IMPL_H
@@ -242,4 +242,30 @@ BOOST_AUTO_TEST_CASE( outer_product_factories )
   }
 }
 
+BOOST_AUTO_TEST_CASE( kronecker_delta_contraction )
+{
+  // delta tiles travel, so the delta array may be distributed
+  ArrayKronDelta1 delta(*GlobalFixture::world, trange2e);
+  init_kronecker_delta(delta);
+  TArrayD r;
+
+  // delta relabels the contracted index of e2
+  BOOST_REQUIRE_NO_THROW(r("a,b") = delta("a,c") * e2("c,b"));
+  BOOST_CHECK_SMALL(double((r("a,b") - e2("a,b")).norm().get()), 1e-12);
+  BOOST_REQUIRE_NO_THROW(r("a,b") = e2("a,c") * delta("c,b"));
+  BOOST_CHECK_SMALL(double((r("a,b") - e2("a,b")).norm().get()), 1e-12);
+  BOOST_REQUIRE_NO_THROW(r("a,b") = delta("c,a") * e2("c,b"));
+  BOOST_CHECK_SMALL(double((r("a,b") - e2("a,b")).norm().get()), 1e-12);
+  BOOST_REQUIRE_NO_THROW(r("a,b") = e2("a,c") * delta("b,c"));
+  BOOST_CHECK_SMALL(double((r("a,b") - e2("a,b")).norm().get()), 1e-12);
+
+  // delta spreads e2 along a diagonal, then the trace over that diagonal
+  // recovers e2 scaled by the extent of the diagonal
+  TArrayD r4;
+  BOOST_REQUIRE_NO_THROW(r4("a,b,c,d") = delta("a,b") * e2("c,d"));
+  BOOST_REQUIRE_NO_THROW(r("c,d") = delta("a,b") * r4("a,b,c,d"));
+  const double n = trange1.data()[0].extent();
+  BOOST_CHECK_SMALL(double((r("c,d") - n * e2("c,d")).norm().get()), 1e-12);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  expressions_partial_reduce.cpp
+ *  Nov 18, 2019
+ *
+ */
+
+#include <tiledarray.h>
+#include "unit_test_config.h"
+#include "array_fixture.h"
+
+using namespace TiledArray;
+
+typedef boost::mpl::list<
+    TArrayD,
+    TSpArrayD
+> array_types;
+
+struct PartialReduceFixture {
+
+  PartialReduceFixture() :
+    tr_i{0, 2, 5, 9},
+    tr_j{0, 3, 4, 7},
+    tr_k{0, 4, 6}
+  { }
+
+  ~PartialReduceFixture() { GlobalFixture::world->gop.fence(); }
+
+  TiledRange1 tr_i, tr_j, tr_k;
+}; // PartialReduceFixture
+
+BOOST_FIXTURE_TEST_SUITE( expressions_partial_reduce_suite, PartialReduceFixture )
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( matrix, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_j});
+  a.fill_random();
+
+  Array row_sum, col_norm, row_max;
+  BOOST_REQUIRE_NO_THROW(row_sum("i") = a("i,j").sum("j"));
+  BOOST_REQUIRE_NO_THROW(col_norm("j") = a("i,j").norm("i"));
+  BOOST_REQUIRE_NO_THROW(row_max("i") = a("i,j").abs_max("j"));
+  BOOST_CHECK_EQUAL(row_sum.trange(), TiledRange{tr_i});
+  BOOST_CHECK_EQUAL(col_norm.trange(), TiledRange{tr_j});
+
+  const auto a_data = gather(a);
+  const auto row_sum_data = gather(row_sum);
+  const auto col_norm_data = gather(col_norm);
+  const auto row_max_data = gather(row_max);
+
+  const std::size_t ni = tr_i.extent(), nj = tr_j.extent();
+  for(std::size_t i = 0ul; i < ni; ++i) {
+    double sum = 0.0, max = 0.0;
+    for(std::size_t j = 0ul; j < nj; ++j) {
+      sum += a_data[i * nj + j];
+      max = std::max(max, std::abs(a_data[i * nj + j]));
+    }
+    BOOST_CHECK_CLOSE(row_sum_data[i], sum, 1e-10);
+    BOOST_CHECK_CLOSE(row_max_data[i], max, 1e-10);
+  }
+  for(std::size_t j = 0ul; j < nj; ++j) {
+    double norm2 = 0.0;
+    for(std::size_t i = 0ul; i < ni; ++i)
+      norm2 += a_data[i * nj + j] * a_data[i * nj + j];
+    BOOST_CHECK_CLOSE(col_norm_data[j], std::sqrt(norm2), 1e-10);
+  }
+
+  // full reductions are still available
+  BOOST_CHECK_CLOSE(a("i,j").sum().get(),
+      std::accumulate(a_data.begin(), a_data.end(), 0.0), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( inner_index, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array t(world, TiledRange{tr_i, tr_j, tr_k});
+  t.fill_random();
+
+  Array r;
+  BOOST_REQUIRE_NO_THROW(r("k,i") = t("i,j,k").sum("j"));
+  BOOST_CHECK_EQUAL(r.trange(), (TiledRange{tr_k, tr_i}));
+
+  const auto t_data = gather(t);
+  const auto r_data = gather(r);
+  const std::size_t ni = tr_i.extent(), nj = tr_j.extent(), nk = tr_k.extent();
+  for(std::size_t i = 0ul; i < ni; ++i)
+    for(std::size_t k = 0ul; k < nk; ++k) {
+      double sum = 0.0;
+      for(std::size_t j = 0ul; j < nj; ++j)
+        sum += t_data[(i * nj + j) * nk + k];
+      BOOST_CHECK_CLOSE(r_data[k * ni + i], sum, 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,124 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  expressions_permuted_view.cpp
+ *  Dec 14, 2019
+ *
+ */
+
+#include <tiledarray.h>
+#include "unit_test_config.h"
+
+using namespace TiledArray;
+
+typedef boost::mpl::list<
+    TArrayD,
+    TSpArrayD
+> array_types;
+
+struct PermutedViewFixture {
+
+  PermutedViewFixture() :
+    tr_i{0, 2, 5, 9},
+    tr_j{0, 3, 4, 7},
+    tr_k{0, 1, 4}
+  { }
+
+  ~PermutedViewFixture() { GlobalFixture::world->gop.fence(); }
+
+  TiledRange1 tr_i, tr_j, tr_k;
+}; // PermutedViewFixture
+
+BOOST_FIXTURE_TEST_SUITE( expressions_permuted_view_suite, PermutedViewFixture )
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( transpose, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_j, tr_i});
+  Array b(world, TiledRange{tr_j, tr_k});
+  a.fill_random();
+  b.fill_random();
+
+  const auto at = permuted_view(a, Permutation{1, 0});
+  BOOST_CHECK_EQUAL(at.trange(), (TiledRange{tr_i, tr_j}));
+
+  // the view is an operand of a contraction
+  Array c, c_ref, a_t;
+  BOOST_REQUIRE_NO_THROW(c("i,k") = at("i,j") * b("j,k"));
+  a_t("i,j") = a("j,i");
+  c_ref("i,k") = a_t("i,j") * b("j,k");
+  BOOST_CHECK_SMALL((c("i,k") - c_ref("i,k")).norm().get(), 1e-10);
+
+  // the view is assigned
+  Array d;
+  BOOST_REQUIRE_NO_THROW(d("i,j") = at("i,j"));
+  BOOST_CHECK_EQUAL(d.trange(), at.trange());
+  BOOST_CHECK_SMALL((d("i,j") - a_t("i,j")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( permute, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_j, tr_k});
+  a.fill_random();
+
+  // a cyclic permutation has order 3
+  const Permutation p{1, 2, 0};
+  const auto v = permuted_view(a, p);
+  BOOST_CHECK_EQUAL(v.trange(), p * a.trange());
+  const auto v3 = v.permute(p).permute(p);
+  BOOST_CHECK_EQUAL(v3.trange(), a.trange());
+  BOOST_CHECK_SMALL((v3("i,j,k") - a("i,j,k")).norm().get(), 1e-10);
+
+  // views of views are views of the array by the product permutation
+  Array b, v_ref, b_ref;
+  BOOST_REQUIRE_NO_THROW(b("i,j,k") = v.permute(p)("i,j,k"));
+  v_ref("i,j,k") = v("i,j,k");
+  b_ref("i,j,k") = permuted_view(v_ref, p)("i,j,k");
+  BOOST_CHECK_EQUAL(b.trange(), b_ref.trange());
+  BOOST_CHECK_SMALL((b("i,j,k") - b_ref("i,j,k")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( permute_noncommuting, Array, array_types )
+{
+  World& world = *GlobalFixture::world;
+  Array a(world, TiledRange{tr_i, tr_j, tr_k});
+  a.fill_random();
+
+  // p1 * p2 != p2 * p1, so the views must apply p1 first, then p2
+  const Permutation p1{1, 0, 2};
+  const Permutation p2{0, 2, 1};
+  const auto v = permuted_view(a, p1).permute(p2);
+  BOOST_CHECK_EQUAL(v.trange(), (TiledRange{tr_j, tr_k, tr_i}));
+  BOOST_CHECK(! (v.trange() == permuted_view(a, p2).permute(p1).trange()));
+
+  // the same permutations, materialized in the same order
+  Array a1, a12;
+  a1("i,j,k") = a("j,i,k");
+  a12("i,j,k") = a1("i,k,j");
+  BOOST_CHECK_EQUAL(a12.trange(), v.trange());
+
+  Array b;
+  BOOST_REQUIRE_NO_THROW(b("i,j,k") = v("i,j,k"));
+  BOOST_CHECK_EQUAL(b.trange(), a12.trange());
+  BOOST_CHECK_SMALL((b("i,j,k") - a12("i,j,k")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -350,4 +350,173 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( complex_gemm_ld , T, floating_point_types )
   delete [] c;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( complex_gemm3m , T, floating_point_types )
+{
+  // Allocate and initialize test input
+  std::complex<T>* a = NULL, * b = NULL, * c = NULL, * c0 = NULL;
+
+  try {
+    // Allocate and fill matrices
+    a = new std::complex<T>[k * m];
+    b = new std::complex<T>[k * n];
+    c = new std::complex<T>[m * n];
+    c0 = new std::complex<T>[m * n];
+
+    rand_fill(reinterpret_cast<T*>(a), 2 * k * m, 29);
+    rand_fill(reinterpret_cast<T*>(b), 2 * k * n, 47);
+    rand_fill(reinterpret_cast<T*>(c), 2 * m * n, 99);
+    std::copy(c, c + m * n, c0);
+
+    const integer lda = m, ldb = n, ldc = n;
+    const std::complex<T> alpha(3, -1), beta(2, 1);
+
+    // Test the gemm operation with conj(a)^T
+    BOOST_REQUIRE_NO_THROW(TiledArray::math::gemm3m(madness::cblas::ConjTrans,
+        madness::cblas::NoTrans, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc));
+
+    for(integer i = 0; i < m; ++i) {
+      for(integer j = 0; j < n; ++j) {
+        // Compute the expected value
+        std::complex<T> expected(0.0, 0.0);
+        for(integer x = 0; x < k; ++x) {
+          expected += std::conj(a[x * lda + i]) * b[x * ldb + j];
+        }
+        expected = alpha * expected + beta * c0[i * ldc + j];
+
+        // Check the result against the expected value
+        BOOST_CHECK_CLOSE(c[i * ldc + j].real(), expected.real(), tol);
+        BOOST_CHECK_CLOSE(c[i * ldc + j].imag(), expected.imag(), tol);
+      }
+    }
+
+  } catch(...) {
+    delete [] a;
+    delete [] b;
+    delete [] c;
+    delete [] c0;
+
+    throw;
+  }
+
+  delete [] a;
+  delete [] b;
+  delete [] c;
+  delete [] c0;
+}
+
+BOOST_AUTO_TEST_CASE( gemm3m_opt_in )
+{
+  const bool enabled = TiledArray::math::gemm3m_enabled();
+  const integer size = TiledArray::math::gemm3m_min_size;
+
+  TiledArray::math::set_gemm3m(false);
+  BOOST_CHECK(! TiledArray::math::gemm3m_profitable(size, size, size));
+
+  TiledArray::math::set_gemm3m(true);
+  BOOST_CHECK(TiledArray::math::gemm3m_profitable(size, size, size));
+  BOOST_CHECK(! TiledArray::math::gemm3m_profitable(size, size, size - 1));
+
+  TiledArray::math::set_gemm3m(enabled);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( real_complex_gemm , T, floating_point_types )
+{
+  // Allocate and initialize test input
+  T* a = NULL;
+  std::complex<T>* b = NULL, * c = NULL;
+
+  try {
+    // Allocate and fill matrices
+    a = new T[m * k];
+    b = new std::complex<T>[k * n];
+    c = new std::complex<T>[m * n];
+
+    rand_fill(a, m * k, 29);
+    rand_fill(reinterpret_cast<T*>(b), 2 * k * n, 47);
+    rand_fill(reinterpret_cast<T*>(c), 2 * m * n, 99);
+
+    const integer lda = k, ldb = n, ldc = n;
+
+    // Test the gemm operation
+    BOOST_REQUIRE_NO_THROW(TiledArray::math::gemm(madness::cblas::NoTrans,
+        madness::cblas::NoTrans, m, n, k, 3, a, lda, b, ldb, 0, c, ldc));
+
+    for(integer i = 0; i < m; ++i) {
+      for(integer j = 0; j < n; ++j) {
+        // Compute the expected value
+        std::complex<T> expected(0.0, 0.0);
+        for(integer x = 0; x < k; ++x) {
+          expected += a[i * lda + x] * b[x * ldb + j];
+        }
+        expected *= 3.0;
+
+        // Check the result against the expected value
+        BOOST_CHECK_CLOSE(c[i * ldc + j].real(), expected.real(), tol);
+        BOOST_CHECK_CLOSE(c[i * ldc + j].imag(), expected.imag(), tol);
+      }
+    }
+
+  } catch(...) {
+    delete [] a;
+    delete [] b;
+    delete [] c;
+
+    throw;
+  }
+
+  delete [] a;
+  delete [] b;
+  delete [] c;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( complex_real_gemm , T, floating_point_types )
+{
+  // Allocate and initialize test input
+  std::complex<T>* a = NULL, * c = NULL;
+  T* b = NULL;
+
+  try {
+    // Allocate and fill matrices
+    a = new std::complex<T>[m * k];
+    b = new T[n * k];
+    c = new std::complex<T>[m * n];
+
+    rand_fill(reinterpret_cast<T*>(a), 2 * m * k, 29);
+    rand_fill(b, n * k, 47);
+    rand_fill(reinterpret_cast<T*>(c), 2 * m * n, 99);
+
+    const integer lda = k, ldb = k, ldc = n;
+
+    // Test the gemm operation with b^T
+    BOOST_REQUIRE_NO_THROW(TiledArray::math::gemm(madness::cblas::NoTrans,
+        madness::cblas::Trans, m, n, k, 3, a, lda, b, ldb, 0, c, ldc));
+
+    for(integer i = 0; i < m; ++i) {
+      for(integer j = 0; j < n; ++j) {
+        // Compute the expected value
+        std::complex<T> expected(0.0, 0.0);
+        for(integer x = 0; x < k; ++x) {
+          expected += a[i * lda + x] * b[j * ldb + x];
+        }
+        expected *= 3.0;
+
+        // Check the result against the expected value
+        BOOST_CHECK_CLOSE(c[i * ldc + j].real(), expected.real(), tol);
+        BOOST_CHECK_CLOSE(c[i * ldc + j].imag(), expected.imag(), tol);
+      }
+    }
+
+  } catch(...) {
+    delete [] a;
+    delete [] b;
+    delete [] c;
+
+    throw;
+  }
+
+  delete [] a;
+  delete [] b;
+  delete [] c;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
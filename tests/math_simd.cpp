@@ -0,0 +1,114 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  math_simd.cpp
+ *  Dec 13, 2019
+ *
+ */
+
+#include "TiledArray/math/simd.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+
+struct SimdFixture {
+
+  SimdFixture() : sizes{0ul, 1ul, 3ul, 7ul, 17ul, 64ul, 101ul, 1000ul} { }
+
+  ~SimdFixture() { }
+
+  template <typename V>
+  static void rand_fill(V& x, const int seed) {
+    typedef typename V::value_type T;
+    GlobalFixture::world->srand(seed);
+    for(T& x_i : x)
+      x_i = T(GlobalFixture::world->rand() % 101) - T(50);
+  }
+
+  std::vector<std::size_t> sizes;
+
+}; // SimdFixture
+
+BOOST_FIXTURE_TEST_SUITE( simd_suite, SimdFixture )
+
+typedef boost::mpl::list<float, double> simd_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( kernels, T, simd_types )
+{
+  using namespace TiledArray::math::simd;
+
+  const Kernels<T> reference = detail::make_kernels<T>(Isa::scalar);
+
+  // Check all instruction sets supported by this CPU against the scalar loops
+  for(int isa = 0; isa <= static_cast<int>(TiledArray::math::simd::isa()); ++isa) {
+    const Kernels<T> kernels = detail::make_kernels<T>(static_cast<Isa>(isa));
+
+    for(const std::size_t n : sizes) {
+      std::vector<T> x(n), y(n);
+      rand_fill(x, 23);
+      rand_fill(y, 47);
+
+      std::vector<T> result = y, expected = y;
+      kernels.scale(n, T(3), result.data());
+      reference.scale(n, T(3), expected.data());
+      BOOST_CHECK(result == expected);
+
+      for(int op = 0; op < 3; ++op) {
+        for(int scaled = 0; scaled < 2; ++scaled) {
+          result = y;
+          expected = y;
+          kernels.binary[op][scaled](n, T(3), x.data(), result.data());
+          reference.binary[op][scaled](n, T(3), x.data(), expected.data());
+          BOOST_CHECK(result == expected);
+        }
+      }
+
+      // Integer-valued elements are summed exactly
+      BOOST_CHECK_EQUAL(kernels.sum(n, x.data()), reference.sum(n, x.data()));
+      BOOST_CHECK_EQUAL(kernels.dot(n, x.data(), y.data()),
+          reference.dot(n, x.data(), y.data()));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( tensor_ops )
+{
+  TiledArray::Range r(std::array<std::size_t, 2>{{13, 17}});
+  TiledArray::Tensor<double> a(r), b(r);
+  rand_fill(a, 23);
+  rand_fill(b, 47);
+  std::vector<double> x(a.begin(), a.end()), y(b.begin(), b.end());
+
+  TiledArray::Tensor<double> c = a.clone();
+  BOOST_REQUIRE_NO_THROW(c.add_to(b, 2.0));
+  for(std::size_t i = 0ul; i < r.volume(); ++i)
+    BOOST_CHECK_EQUAL(c[i], (x[i] + y[i]) * 2.0);
+
+  double dot = 0.0, sum = 0.0, norm2 = 0.0;
+  for(std::size_t i = 0ul; i < r.volume(); ++i) {
+    dot += x[i] * y[i];
+    sum += x[i];
+    norm2 += x[i] * x[i];
+  }
+  BOOST_CHECK_EQUAL(a.dot(b), dot);
+  BOOST_CHECK_EQUAL(a.sum(), sum);
+  BOOST_CHECK_EQUAL(a.squared_norm(), norm2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -173,9 +173,9 @@ BOOST_AUTO_TEST_CASE( make_groups )
   BOOST_CHECK_EQUAL(col_group.size(), proc_grid.proc_rows());
 
   // Check that the groups contain the correct processes.
-  std::size_t rank = 0;
   for(std::size_t rank_row = 0; rank_row < proc_grid.proc_rows(); ++rank_row) {
-    for(std::size_t rank_col = 0; rank_col < proc_grid.proc_cols(); ++rank_col, ++rank) {
+    for(std::size_t rank_col = 0; rank_col < proc_grid.proc_cols(); ++rank_col) {
+      const ProcessID rank = proc_grid.map_proc(rank_row, rank_col);
       // Check that the row group includes ranks in this this processes
       if(ProcessID(rank_row) == proc_grid.rank_row()) {
         BOOST_CHECK_NE(row_group.rank(rank), -1);
@@ -193,6 +193,97 @@ BOOST_AUTO_TEST_CASE( make_groups )
   }
 }
 
+BOOST_AUTO_TEST_CASE( rank_placement )
+{
+  // Construct the process grid
+  TiledArray::detail::ProcGrid proc_grid(*GlobalFixture::world, 42, 84,
+      2048, 1024);
+
+  // Check that each process appears at most once in the grid
+  std::vector<bool> placed(GlobalFixture::world->size(), false);
+  for(std::size_t p = 0ul; p < proc_grid.proc_size(); ++p) {
+    const ProcessID rank = proc_grid.map_proc(p);
+    BOOST_REQUIRE_GE(rank, 0);
+    BOOST_REQUIRE_LT(rank, GlobalFixture::world->size());
+    BOOST_CHECK(! placed[rank]);
+    placed[rank] = true;
+    if(! proc_grid.is_reordered())
+      BOOST_CHECK_EQUAL(rank, ProcessID(p));
+  }
+
+  // Check that this process is at its own grid coordinate
+  if(proc_grid.rank_row() != -1) {
+    BOOST_CHECK_EQUAL(proc_grid.map_proc(proc_grid.rank_row(), proc_grid.rank_col()),
+        GlobalFixture::world->rank());
+    BOOST_CHECK_EQUAL(proc_grid.map_row(proc_grid.rank_row()), GlobalFixture::world->rank());
+    BOOST_CHECK_EQUAL(proc_grid.map_col(proc_grid.rank_col()), GlobalFixture::world->rank());
+  }
+
+  // Check that the process map follows the placement
+  std::shared_ptr<TiledArray::Pmap> pmap = proc_grid.make_pmap();
+  for(std::size_t tile = 0ul; tile < pmap->size(); ++tile) {
+    const std::size_t proc_row = (tile / 84ul) % proc_grid.proc_rows();
+    const std::size_t proc_col = (tile % 84ul) % proc_grid.proc_cols();
+    BOOST_CHECK_EQUAL(pmap->owner(tile),
+        std::size_t(proc_grid.map_proc(proc_row, proc_col)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( node_placement )
+{
+  // Eight processes on two nodes, assigned to the nodes round-robin
+  const std::size_t nprocs = 8ul;
+  const std::vector<ProcessID> node_ids = {0, 1, 0, 1, 0, 1, 0, 1};
+
+  // A 2x4 process grid; the row broadcasts carry more data, so each process
+  // row is placed within a node ...
+  const std::vector<ProcessID> row_major = {0, 2, 4, 6, 1, 3, 5, 7};
+  // ... otherwise each process column is
+  const std::vector<ProcessID> col_major = {0, 4, 1, 5, 2, 6, 3, 7};
+
+  for(const bool rows_within_nodes : {true, false}) {
+    const std::vector<ProcessID>& expected = (rows_within_nodes ? row_major : col_major);
+    const std::size_t row_size = (rows_within_nodes ? 1000ul : 10ul);
+
+    for(std::size_t rank = 0ul; rank < nprocs; ++rank) {
+      TiledArray::detail::ProcGrid proc_grid(*GlobalFixture::world, rank, nprocs,
+          2ul, 4ul, row_size, 1000ul, node_ids);
+      BOOST_REQUIRE_EQUAL(proc_grid.proc_rows(), 2u);
+      BOOST_REQUIRE_EQUAL(proc_grid.proc_cols(), 4u);
+      BOOST_CHECK(proc_grid.is_reordered());
+
+      // Check the process at each grid position
+      for(std::size_t p = 0ul; p < nprocs; ++p) {
+        BOOST_CHECK_EQUAL(proc_grid.map_proc(p), expected[p]);
+        BOOST_CHECK_EQUAL(proc_grid.map_proc(p / 4ul, p % 4ul), expected[p]);
+      }
+
+      // Check that this process is at its own grid coordinate
+      BOOST_REQUIRE_NE(proc_grid.rank_row(), -1);
+      BOOST_CHECK_EQUAL(proc_grid.map_proc(proc_grid.rank_row(), proc_grid.rank_col()),
+          ProcessID(rank));
+
+      // Check that the process map follows the placement
+      auto ranks = std::make_shared<std::vector<ProcessID> >(nprocs);
+      for(std::size_t p = 0ul; p < nprocs; ++p)
+        (*ranks)[p] = proc_grid.map_proc(p);
+      const TiledArray::detail::CyclicPmap pmap(rank, nprocs, 6ul, 10ul,
+          proc_grid.proc_rows(), proc_grid.proc_cols(), ranks);
+      for(std::size_t tile = 0ul; tile < pmap.size(); ++tile) {
+        const std::size_t proc_row = (tile / 10ul) % 2ul;
+        const std::size_t proc_col = (tile % 10ul) % 4ul;
+        BOOST_CHECK_EQUAL(pmap.owner(tile), std::size_t(expected[proc_row * 4ul + proc_col]));
+      }
+      std::size_t local_count = 0ul;
+      for(const auto tile : pmap) {
+        BOOST_CHECK_EQUAL(pmap.owner(tile), rank);
+        ++local_count;
+      }
+      BOOST_CHECK_EQUAL(local_count, pmap.local_size());
+    }
+  }
+}
+
 #if 0
 // This test case us used to evaluate distribute statistics. This unit test
 // should only be enabled when changes are made to the ProcGrid algorithm, and
@@ -234,6 +325,61 @@ BOOST_AUTO_TEST_CASE( statistics )
 }
 #endif
 
+BOOST_AUTO_TEST_CASE( node_placement )
+{
+  // Eight processes on two nodes, assigned to the nodes round-robin
+  const std::size_t nprocs = 8ul;
+  const std::vector<ProcessID> node_ids = {0, 1, 0, 1, 0, 1, 0, 1};
+
+  // A 2x4 process grid; the row broadcasts carry more data, so each process
+  // row is placed within a node ...
+  const std::vector<ProcessID> row_major = {0, 2, 4, 6, 1, 3, 5, 7};
+  // ... otherwise each process column is
+  const std::vector<ProcessID> col_major = {0, 4, 1, 5, 2, 6, 3, 7};
+
+  for(const bool rows_within_nodes : {true, false}) {
+    const std::vector<ProcessID>& expected = (rows_within_nodes ? row_major : col_major);
+    const std::size_t row_size = (rows_within_nodes ? 1000ul : 10ul);
+
+    for(std::size_t rank = 0ul; rank < nprocs; ++rank) {
+      TiledArray::detail::ProcGrid proc_grid(*GlobalFixture::world, rank, nprocs,
+          2ul, 4ul, row_size, 1000ul, node_ids);
+      BOOST_REQUIRE_EQUAL(proc_grid.proc_rows(), 2u);
+      BOOST_REQUIRE_EQUAL(proc_grid.proc_cols(), 4u);
+      BOOST_CHECK(proc_grid.is_reordered());
+
+      // Check the process at each grid position
+      for(std::size_t p = 0ul; p < nprocs; ++p) {
+        BOOST_CHECK_EQUAL(proc_grid.map_proc(p), expected[p]);
+        BOOST_CHECK_EQUAL(proc_grid.map_proc(p / 4ul, p % 4ul), expected[p]);
+      }
+
+      // Check that this process is at its own grid coordinate
+      BOOST_REQUIRE_NE(proc_grid.rank_row(), -1);
+      BOOST_CHECK_EQUAL(proc_grid.map_proc(proc_grid.rank_row(), proc_grid.rank_col()),
+          ProcessID(rank));
+
+      // Check that the process map follows the placement
+      auto ranks = std::make_shared<std::vector<ProcessID> >(nprocs);
+      for(std::size_t p = 0ul; p < nprocs; ++p)
+        (*ranks)[p] = proc_grid.map_proc(p);
+      const TiledArray::detail::CyclicPmap pmap(rank, nprocs, 6ul, 10ul,
+          proc_grid.proc_rows(), proc_grid.proc_cols(), ranks);
+      for(std::size_t tile = 0ul; tile < pmap.size(); ++tile) {
+        const std::size_t proc_row = (tile / 10ul) % 2ul;
+        const std::size_t proc_col = (tile % 10ul) % 4ul;
+        BOOST_CHECK_EQUAL(pmap.owner(tile), std::size_t(expected[proc_row * 4ul + proc_col]));
+      }
+      std::size_t local_count = 0ul;
+      for(const auto tile : pmap) {
+        BOOST_CHECK_EQUAL(pmap.owner(tile), rank);
+        ++local_count;
+      }
+      BOOST_CHECK_EQUAL(local_count, pmap.local_size());
+    }
+  }
+}
+
 #if 0
 // This test case us used to evaluate quality of ProcGrid output. This unit test
 // should only be enabled when changes are made to the ProcGrid algorithm, and
@@ -137,6 +137,28 @@ BOOST_AUTO_TEST_CASE( reduce_future )
 
 }
 
+BOOST_AUTO_TEST_CASE( reduce_in_place )
+{
+  ReduceTask<plus<int> > in_place_rt(world, plus<int>(), nullptr, true);
+  std::vector<Future<int> > fut_vec;
+
+  int sum = 0;
+  for(int i = 0; i < 100; ++i) {
+    sum += 2 * i;
+    Future<int> f;
+    fut_vec.push_back(f);
+    in_place_rt.add(f);
+    in_place_rt.add(i);
+  }
+
+  Future<int> result = in_place_rt.submit();
+
+  for(int i = 0; i < 100; ++i)
+    fut_vec[i].set(i);
+
+  BOOST_CHECK_EQUAL(result.get(), sum);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -228,4 +250,31 @@ BOOST_AUTO_TEST_CASE( reduce_zero )
   BOOST_CHECK_EQUAL(result.get(), 0);
 }
 
+BOOST_AUTO_TEST_CASE( reduce_in_place )
+{
+  ReducePairTask<ReduceOp> in_place_rt(world, ReduceOp(), nullptr, true);
+  std::vector<Future<int> > fut1_vec;
+  std::vector<Future<int> > fut2_vec;
+
+  int sum = 0;
+  for(int i = 0; i < 100; ++i) {
+    sum += i * i;
+    Future<int> f1;
+    Future<int> f2;
+    fut1_vec.push_back(f1);
+    fut2_vec.push_back(f2);
+    in_place_rt.add(f1, f2);
+  }
+
+  Future<int> result = in_place_rt.submit();
+  BOOST_CHECK(!(result.probe()));
+
+  for(int i = 0; i < 100; ++i) {
+    fut1_vec[i].set(i);
+    fut2_vec[i].set(i);
+  }
+
+  BOOST_CHECK_EQUAL(result.get(), sum);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,9 @@
 
 #include <tiledarray.h>
 #include <TiledArray/algebra/conjgrad.h>
+#include <TiledArray/algebra/cholesky.h>
+#include <TiledArray/algebra/matrix_functions.h>
+#include <TiledArray/algebra/davidson.h>
 
 #include "unit_test_config.h"
 
@@ -165,6 +168,14 @@ struct validate<DistArray<Tile,Policy>> {
   }
 };
 
+/// Convert an array to an Eigen matrix on every rank
+template <typename Array>
+EigenMatrixXd replicated_eigen(Array array) {
+  array.make_replicated();
+  return array_to_eigen<typename Array::value_type, typename Array::policy_type,
+                        Eigen::RowMajor>(array);
+}
+
 BOOST_AUTO_TEST_SUITE(solvers)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(conjugate_gradient, Array, array_types) {
@@ -177,4 +188,197 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(conjugate_gradient, Array, array_types) {
   BOOST_CHECK(validate<Array>{}(x));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(pipelined_conjugate_gradient, Array, array_types) {
+
+  auto Ax = make_Ax<Array>{}();
+  auto b = make_b<Array>{}();
+  auto pc = make_pc<Array>{}();
+  Array x;
+  PipelinedConjugateGradientSolver<Array, decltype(Ax)>{}(Ax, b, x, pc, 1e-11);
+  BOOST_CHECK(validate<Array>{}(x));
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_dot_products) {
+  World& world = get_default_world();
+  const TiledRange trange{TiledRange1{0, 2, 5, 6, 9}};
+
+  // r has zero tiles where u and w do not
+  Tensor<float> r_norms(trange.tiles_range(), 1.0f);
+  r_norms[1] = 0.0f;
+  r_norms[3] = 0.0f;
+  const Tensor<float> norms(trange.tiles_range(), 1.0f);
+  TSpArrayD r(world, trange, SparseShape<float>(r_norms, trange));
+  TSpArrayD u(world, trange, SparseShape<float>(norms, trange));
+  TSpArrayD w(world, trange, SparseShape<float>(norms, trange));
+  r.fill_random();
+  u.fill_random();
+  w.fill_random();
+  BOOST_REQUIRE(r.is_zero(1) && r.is_zero(3));
+
+  const auto result = dot_products(r, u, w);
+  BOOST_CHECK_CLOSE(result[0], r("i").dot(u("i")).get(), 1e-10);
+  BOOST_CHECK_CLOSE(result[1], w("i").dot(u("i")).get(), 1e-10);
+  BOOST_CHECK_CLOSE(result[2], r("i").squared_norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(cholesky_factorization, Array, array_types) {
+  World& world = get_default_world();
+  const TiledRange1 tr1{0, 2, 5, 6, 9};
+  const TiledRange trange{tr1, tr1};
+  const std::size_t n = tr1.extent();
+
+  // A symmetric positive-definite matrix
+  EigenMatrixXd m = EigenMatrixXd::Random(n, n);
+  world.gop.broadcast(m.data(), m.size(), 0);
+  const EigenMatrixXd a_eig = m * m.transpose() + double(n) * EigenMatrixXd::Identity(n, n);
+  const auto A = eigen_to_array<Array>(world, trange, a_eig);
+
+  // A = L * L^T
+  Array L;
+  BOOST_REQUIRE_NO_THROW(L = cholesky(A));
+  const auto l_eig = replicated_eigen(L);
+  BOOST_CHECK_SMALL((l_eig * l_eig.transpose() - a_eig).norm(), 1e-10);
+  for(std::size_t i = 0ul; i < n; ++i)
+    for(std::size_t j = i + 1ul; j < n; ++j)
+      BOOST_CHECK_EQUAL(l_eig(i, j), 0.0);
+
+  // L^-1 * L = 1
+  Array L_inv;
+  BOOST_REQUIRE_NO_THROW(L_inv = triangular_inverse(L));
+  const auto l_inv_eig = replicated_eigen(L_inv);
+  BOOST_CHECK_SMALL((l_inv_eig * l_eig - EigenMatrixXd::Identity(n, n)).norm(), 1e-10);
+
+  // A * X = B
+  const TiledRange b_trange{tr1, TiledRange1{0, 2, 3}};
+  EigenMatrixXd b_eig = EigenMatrixXd::Random(n, 3);
+  world.gop.broadcast(b_eig.data(), b_eig.size(), 0);
+  const auto B = eigen_to_array<Array>(world, b_trange, b_eig);
+  Array X;
+  BOOST_REQUIRE_NO_THROW(X = cholesky_solve(A, B));
+  BOOST_CHECK_SMALL((a_eig * replicated_eigen(X) - b_eig).norm(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(cholesky_fill_in) {
+  World& world = get_default_world();
+  const TiledRange1 tr1{0, 3, 6, 9};
+  const TiledRange trange{tr1, tr1};
+  const std::size_t n = tr1.extent();
+
+  // A = C * C^T, where C(2,1) cancels C(2,0) * C(1,0)^T so that A(2,1) is
+  // zero, but the factor is not; the ill-conditioned C(1,1) makes the
+  // fill-in large
+  EigenMatrixXd c_eig = EigenMatrixXd::Zero(n, n);
+  EigenMatrixXd m = EigenMatrixXd::Random(n, n);
+  world.gop.broadcast(m.data(), m.size(), 0);
+  for(std::size_t i = 0ul; i < n; ++i)
+    for(std::size_t j = 0ul; j < i; ++j)
+      c_eig(i, j) = m(i, j);
+  for(std::size_t i = 0ul; i < n; ++i)
+    c_eig(i, i) = 1.0 + std::abs(m(i, i));
+  c_eig(5, 5) = 1e-3;
+  const EigenMatrixXd c_11 = c_eig.block(3, 3, 3, 3);
+  c_eig.block(6, 3, 3, 3) = -(c_eig.block(6, 0, 3, 3) *
+      c_eig.block(3, 0, 3, 3).transpose()) * c_11.transpose().inverse();
+  EigenMatrixXd a_eig = c_eig * c_eig.transpose();
+  a_eig.block(6, 3, 3, 3).setZero();
+  a_eig.block(3, 6, 3, 3).setZero();
+  const auto A = eigen_to_array<TSpArrayD>(world, trange, a_eig);
+  BOOST_REQUIRE(A.is_zero({2, 1}));
+
+  // compare with the dense factorization
+  const EigenMatrixXd l_ref = a_eig.llt().matrixL();
+  TSpArrayD L;
+  BOOST_REQUIRE_NO_THROW(L = cholesky(A));
+  BOOST_CHECK(! L.is_zero({2, 1}));
+  const auto l_eig = replicated_eigen(L);
+  BOOST_CHECK_SMALL((l_eig - l_ref).norm() / l_ref.norm(), 1e-10);
+
+  // the solution fills in below the non-zero rows of the right-hand side
+  const TiledRange b_trange{tr1, TiledRange1{0, 2}};
+  EigenMatrixXd b_eig = EigenMatrixXd::Zero(n, 2);
+  b_eig.block(0, 0, 3, 2) = m.block(0, 0, 3, 2);
+  const auto B = eigen_to_array<TSpArrayD>(world, b_trange, b_eig);
+  TSpArrayD X;
+  BOOST_REQUIRE_NO_THROW(X = cholesky_solve(A, B));
+  const EigenMatrixXd x_ref = a_eig.llt().solve(b_eig);
+  BOOST_CHECK_SMALL((replicated_eigen(X) - x_ref).norm() / x_ref.norm(), 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(matrix_functions, Array, array_types) {
+  World& world = get_default_world();
+  const TiledRange1 tr1{0, 2, 5, 6, 9};
+  const TiledRange trange{tr1, tr1};
+  const std::size_t n = tr1.extent();
+  const EigenMatrixXd identity = EigenMatrixXd::Identity(n, n);
+
+  // A well-conditioned symmetric positive-definite matrix
+  EigenMatrixXd m = EigenMatrixXd::Random(n, n);
+  world.gop.broadcast(m.data(), m.size(), 0);
+  const EigenMatrixXd s_eig = 0.1 * (m + m.transpose()) + 2.0 * identity;
+  const auto S = eigen_to_array<Array>(world, trange, s_eig);
+
+  // S^-1/2 * S * S^-1/2 = 1
+  MatrixFunctionInfo info;
+  Array X;
+  BOOST_REQUIRE_NO_THROW(X = inverse_sqrt(S, 1e-12, 100u, &info));
+  BOOST_CHECK(info.converged);
+  const auto x_eig = replicated_eigen(X);
+  BOOST_CHECK_SMALL((x_eig * s_eig * x_eig - identity).norm(), 1e-10);
+
+  // sign(S - 2) is idempotent up to a sign
+  const auto A = eigen_to_array<Array>(world, trange, EigenMatrixXd(s_eig - 2.0 * identity));
+  Array Sgn;
+  BOOST_REQUIRE_NO_THROW(Sgn = matrix_sign(A, 1e-12, 100u, &info));
+  BOOST_CHECK(info.converged);
+  const auto sgn_eig = replicated_eigen(Sgn);
+  BOOST_CHECK_SMALL((sgn_eig * sgn_eig - identity).norm(), 1e-10);
+
+  // purification of a perturbed projector
+  const EigenMatrixXd p_eig = 0.5 * (sgn_eig + identity) + 0.01 * (m + m.transpose());
+  const auto P = eigen_to_array<Array>(world, trange, p_eig);
+  Array D;
+  BOOST_REQUIRE_NO_THROW(D = mcweeny_purification(P, 1e-12, 100u, &info));
+  BOOST_CHECK(info.converged);
+  const auto d_eig = replicated_eigen(D);
+  BOOST_CHECK_SMALL((d_eig * d_eig - d_eig).norm(), 1e-10);
+  BOOST_CHECK_SMALL((d_eig - 0.5 * (sgn_eig + identity)).norm(), 0.1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(davidson, Array, array_types) {
+  World& world = get_default_world();
+  const TiledRange1 tr1{0, 5, 12, 20};
+  const std::size_t n = tr1.extent();
+
+  // A diagonally dominant symmetric matrix
+  EigenMatrixXd m = EigenMatrixXd::Random(n, n);
+  world.gop.broadcast(m.data(), m.size(), 0);
+  EigenMatrixXd a_eig = 0.01 * (m + m.transpose());
+  for(std::size_t i = 0ul; i < n; ++i)
+    a_eig(i, i) += double(i + 1);
+  const auto A = eigen_to_array<Array>(world, TiledRange{tr1, tr1}, a_eig);
+  const auto diagonal = eigen_to_array<Array>(world, TiledRange{tr1},
+      EigenVectorXd(a_eig.diagonal()));
+
+  // The unit vectors of the three lowest diagonal elements
+  EigenMatrixXd guess_eig = EigenMatrixXd::Identity(3, n);
+  const auto guess = eigen_to_array<Array>(world,
+      TiledRange{TiledRange1{0, 3}, tr1}, guess_eig);
+
+  // The sigma function receives a block of vectors
+  auto sigma = [&A] (const Array& x, Array& result) {
+    result("k,i") = x("k,j") * A("j,i");
+  };
+
+  DavidsonSolver<typename Array::value_type, typename Array::policy_type>
+      solver(2u);
+  bool converged = false;
+  BOOST_REQUIRE_NO_THROW(converged = solver(sigma, guess, diagonal, 1e-8));
+  BOOST_CHECK(converged);
+
+  Eigen::SelfAdjointEigenSolver<EigenMatrixXd> es(a_eig);
+  BOOST_CHECK_CLOSE(solver.eigenvalues()(0), es.eigenvalues()(0), 1e-8);
+  BOOST_CHECK_CLOSE(solver.eigenvalues()(1), es.eigenvalues()(1), 1e-8);
+  BOOST_CHECK(solver.residual_norms().maxCoeff() < 1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
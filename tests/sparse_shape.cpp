@@ -1245,4 +1245,117 @@ BOOST_AUTO_TEST_CASE( gemm_perm )
   BOOST_CHECK_CLOSE(result.sparsity(), float(zero_tile_count) / float(result_norms.size()), tolerance);
 }
 
+BOOST_AUTO_TEST_CASE( gemm_subtile )
+{
+  // Tiles of the left argument are nonzero in column 0, and tiles of the
+  // right argument in row 3, so all products of tiles are zero.
+  const TiledRange trange({ TiledRange1{0, 4, 8}, TiledRange1{0, 4, 8} });
+  auto make_shape = [&] (const bool left) {
+    Tensor<float> tile_norms(trange.tiles_range(), 0.0f);
+    auto subtile_norms = std::make_shared<detail::SubtileNorms<float> >(
+        trange.tiles_range(), 4u);
+    for(std::size_t t = 0ul; t < trange.tiles_range().volume(); ++t) {
+      const Range range = trange.make_tile_range(t);
+      Tensor<float> tile(range, 0.0f);
+      for(std::size_t x = 0ul; x < 4ul; ++x)
+        tile[left ? x * 4ul : 12ul + x] = 1.0f;
+      tile_norms[t] = tile.norm();
+      if(GlobalFixture::world->rank() == 0)
+        subtile_norms->accumulate(t, tile);
+    }
+    subtile_norms->finalize(*GlobalFixture::world);
+
+    return SparseShape<float>(tile_norms, trange).subtile(subtile_norms);
+  };
+  const SparseShape<float> left_subtile = make_shape(true);
+  const SparseShape<float> right_subtile = make_shape(false);
+  BOOST_REQUIRE(left_subtile.subtile_norms());
+  BOOST_CHECK(left_subtile.scale(2.0).perm(Permutation({1,0})).subtile_norms());
+
+  math::GemmHelper gemm_helper(madness::cblas::NoTrans, madness::cblas::NoTrans,
+      2u, 2u, 2u);
+
+  // Without slice norms, the tile norms do not screen the products
+  const SparseShape<float> result_tile =
+      SparseShape<float>(left_subtile.data(), trange, true).gemm(
+      SparseShape<float>(right_subtile.data(), trange, true), 1.0, gemm_helper);
+  BOOST_CHECK_CLOSE(result_tile.sparsity(), 0.0f, tolerance);
+
+  // With slice norms, all products are screened
+  SparseShape<float> result;
+  BOOST_REQUIRE_NO_THROW(result = left_subtile.gemm(right_subtile, 1.0, gemm_helper));
+  BOOST_CHECK_CLOSE(result.sparsity(), 1.0f, tolerance);
+
+  // With the transposed right argument, which is nonzero in column 3, the
+  // bound is the norm of the product, (2 * 2 * 1) / 16 , instead of the
+  // product of norms, (2 * 2 * 2) / 16
+  const SparseShape<float> overlap =
+      left_subtile.gemm(right_subtile.perm(Permutation({1,0})), 1.0, gemm_helper);
+  for(std::size_t t = 0ul; t < overlap.data().size(); ++t)
+    BOOST_CHECK_CLOSE(overlap[t], 0.25f, tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( local_threshold )
+{
+  const float threshold = SparseShape<float>::threshold() * 1000.0f;
+
+  // Attach a threshold to a shape
+  SparseShape<float> screened;
+  BOOST_REQUIRE_NO_THROW(screened = sparse_shape.screen(threshold));
+  BOOST_CHECK_EQUAL(screened.screening_threshold(), threshold);
+  BOOST_CHECK_EQUAL(sparse_shape.screening_threshold(), SparseShape<float>::threshold());
+
+  size_type zero_tile_count = 0ul;
+  for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i) {
+    if(sparse_shape[i] < threshold) {
+      BOOST_CHECK(screened.is_zero(i));
+      BOOST_CHECK_EQUAL(screened[i], 0.0f);
+      ++zero_tile_count;
+    } else {
+      BOOST_CHECK(! screened.is_zero(i));
+      BOOST_CHECK_EQUAL(screened[i], sparse_shape[i]);
+    }
+  }
+  BOOST_CHECK_CLOSE(screened.sparsity(),
+      float(zero_tile_count) / float(tr.tiles_range().volume()), tolerance);
+
+  // Shapes computed from the screened shape alone keep its threshold
+  const SparseShape<float> screened_scaled = screened.scale(2.0);
+  BOOST_CHECK_EQUAL(screened_scaled.screening_threshold(), threshold);
+  for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i)
+    BOOST_CHECK_EQUAL(screened_scaled.is_zero(i), (screened[i] * 2.0f) < threshold);
+
+  // ... but combined with a shape that uses the global threshold, the
+  // tighter global threshold is kept
+  const SparseShape<float> sum = screened.add(left);
+  BOOST_CHECK_EQUAL(sum.screening_threshold(), SparseShape<float>::threshold());
+  for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i)
+    BOOST_CHECK_EQUAL(sum.is_zero(i),
+        (screened[i] + left[i]) < SparseShape<float>::threshold());
+
+  // Shapes computed in a scope use its threshold
+  {
+    ShapeThresholdScope scope(threshold);
+    const SparseShape<float> scaled = sparse_shape.scale(2.0);
+    BOOST_CHECK_EQUAL(scaled.screening_threshold(), threshold);
+    for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i)
+      BOOST_CHECK_EQUAL(scaled.is_zero(i), (sparse_shape[i] * 2.0f) < threshold);
+  }
+  BOOST_CHECK_EQUAL(sparse_shape.scale(2.0).screening_threshold(),
+      SparseShape<float>::threshold());
+
+  // A loose result of a scope does not spread its threshold to the results
+  // it is combined with outside the scope
+  SparseShape<float> loose;
+  {
+    ShapeThresholdScope scope(threshold);
+    loose = sparse_shape.scale(2.0);
+  }
+  const SparseShape<float> loose_sum = loose.add(right);
+  BOOST_CHECK_EQUAL(loose_sum.screening_threshold(), SparseShape<float>::threshold());
+  for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i)
+    BOOST_CHECK_EQUAL(loose_sum.is_zero(i),
+        (loose[i] + right[i]) < SparseShape<float>::threshold());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2019  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Edward F Valeev
+ *  Department of Chemistry, Virginia Tech
+ *
+ *  symm_symmetric_array.cpp
+ *  Nov 4, 2019
+ *
+ */
+
+#include <tiledarray.h>
+#include <TiledArray/symm/symmetric_array.h>
+#include "unit_test_config.h"
+
+using namespace TiledArray;
+using TiledArray::symmetry::Representation;
+using TiledArray::symmetry::PermutationGroup;
+using TiledArray::symmetry::Phase;
+using TiledArray::symmetry::TileSymmetry;
+
+struct SymmetricArrayFixture {
+
+  SymmetricArrayFixture() :
+    tr1{0, 3, 8, 12, 13},
+    trange{tr1, tr1},
+    r(*GlobalFixture::world, trange)
+  {
+    r.fill_random();
+  }
+
+  ~SymmetricArrayFixture() {
+    GlobalFixture::world->gop.fence();
+  }
+
+  static TileSymmetry<Phase> make_symmetry(const TiledRange& trange, Phase phase) {
+    std::map<symmetry::Permutation, Phase> genops;
+    genops[symmetry::Permutation{1,0}] = phase;
+    return TileSymmetry<Phase>(Representation<PermutationGroup, Phase>(genops), trange);
+  }
+
+  TiledRange1 tr1;
+  TiledRange trange;
+  TSpArrayD r;
+}; // SymmetricArrayFixture
+
+BOOST_FIXTURE_TEST_SUITE( symm_symmetric_array_suite, SymmetricArrayFixture )
+
+BOOST_AUTO_TEST_CASE( canonical_tiles )
+{
+  auto symm = make_symmetry(trange, Phase::identity());
+
+  // 4x4 tiles, of which 4 * 5 / 2 are on or above the diagonal
+  BOOST_CHECK_EQUAL(symm.size(), 16ul);
+  BOOST_CHECK_EQUAL(symm.unique_count(), 10ul);
+
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord) {
+    const auto idx = trange.tiles_range().idx(ord);
+    const auto canonical_idx = trange.tiles_range().idx(symm.canonical(ord));
+    BOOST_CHECK(canonical_idx[0] <= canonical_idx[1]);
+    BOOST_CHECK_EQUAL(symm.is_unique(ord), idx[0] <= idx[1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( symmetric )
+{
+  auto symm = make_symmetry(trange, Phase::identity());
+  TSpArrayD a;
+  BOOST_REQUIRE_NO_THROW(a("i,j") = r("i,j") + r("j,i"));
+
+  TSpArrayD u;
+  BOOST_REQUIRE_NO_THROW(u = symmetry::make_unique(a, symm));
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord)
+    BOOST_CHECK_EQUAL(u.is_zero(ord), ! symm.is_unique(ord));
+
+  // check tiles are regenerated on access
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord) {
+    if(! a.is_local(ord)) continue;
+    auto tile = symmetry::find(u, symm, ord).get();
+    auto ref = a.find(ord).get();
+    BOOST_CHECK_EQUAL(tile.range(), ref.range());
+    for(std::size_t i = 0ul; i < tile.size(); ++i)
+      BOOST_CHECK_EQUAL(tile[i], ref[i]);
+  }
+
+  TSpArrayD e;
+  BOOST_REQUIRE_NO_THROW(e = symmetry::expand(u, symm));
+  BOOST_CHECK_SMALL((e("i,j") - a("i,j")).norm().get(), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE( antisymmetric )
+{
+  auto symm = make_symmetry(trange, Phase::negate());
+  TSpArrayD a;
+  BOOST_REQUIRE_NO_THROW(a("i,j") = r("i,j") - r("j,i"));
+
+  TSpArrayD e;
+  BOOST_REQUIRE_NO_THROW(e = symmetry::expand(symmetry::make_unique(a, symm), symm));
+  BOOST_CHECK_SMALL((e("i,j") - a("i,j")).norm().get(), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE( contraction )
+{
+  auto symm = make_symmetry(trange, Phase::identity());
+  const auto mask = symm.mask(trange);
+
+  TSpArrayD c, u;
+  BOOST_REQUIRE_NO_THROW(c("i,j") = r("i,k") * r("j,k"));
+  BOOST_REQUIRE_NO_THROW(u("i,j") = (r("i,k") * r("j,k")).set_shape(mask));
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord)
+    if(! symm.is_unique(ord))
+      BOOST_CHECK(u.is_zero(ord));
+
+  TSpArrayD e;
+  BOOST_REQUIRE_NO_THROW(e = symmetry::expand(u, symm));
+  BOOST_CHECK_SMALL((e("i,j") - c("i,j")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE( cyclic )
+{
+  // A 3-cycle is not an involution, hence g and g^-1 differ
+  const TiledRange1 tr4{0, 2, 5, 6};
+  const TiledRange trange4{tr4, tr4, tr4, tr4};
+  std::map<symmetry::Permutation, Phase> genops;
+  genops[symmetry::Permutation{1,2,0}] = Phase::identity();
+  const TileSymmetry<Phase> symm(Representation<PermutationGroup, Phase>(genops),
+      trange4);
+
+  // 11 orbits of the first three tile indices, times 3 for the last one
+  BOOST_CHECK_EQUAL(symm.size(), 81ul);
+  BOOST_CHECK_EQUAL(symm.unique_count(), 33ul);
+
+  TSpArrayD r4(*GlobalFixture::world, trange4);
+  r4.fill_random();
+  TSpArrayD a;
+  BOOST_REQUIRE_NO_THROW(a("i,j,k,l") = r4("i,j,k,l") + r4("j,k,i,l") + r4("k,i,j,l"));
+
+  // check tiles are regenerated on access
+  const auto u = symmetry::make_unique(a, symm);
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord) {
+    if(! a.is_local(ord)) continue;
+    auto tile = symmetry::find(u, symm, ord).get();
+    auto ref = a.find(ord).get();
+    BOOST_CHECK_EQUAL(tile.range(), ref.range());
+    for(std::size_t i = 0ul; i < tile.size(); ++i)
+      BOOST_CHECK_CLOSE(tile[i], ref[i], 1e-10);
+  }
+
+  // the mask holds finite norms only
+  const auto mask = symm.mask(trange4);
+  for(std::size_t ord = 0ul; ord < symm.size(); ++ord) {
+    BOOST_CHECK(std::isfinite(mask.tile_norms()[ord]));
+    BOOST_CHECK_EQUAL(mask.is_zero(ord), ! symm.is_unique(ord));
+  }
+
+  // contraction over the last index preserves the symmetry
+  TSpArrayD s(*GlobalFixture::world, TiledRange{tr4, tr4});
+  s.fill_random();
+  TSpArrayD c, m;
+  BOOST_REQUIRE_NO_THROW(c("i,j,k,l") = a("i,j,k,m") * s("m,l"));
+  BOOST_REQUIRE_NO_THROW(m("i,j,k,l") = (a("i,j,k,m") * s("m,l")).set_shape(mask));
+  TSpArrayD e;
+  BOOST_REQUIRE_NO_THROW(e = symmetry::expand(m, symm));
+  BOOST_CHECK_SMALL((e("i,j,k,l") - c("i,j,k,l")).norm().get(), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
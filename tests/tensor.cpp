@@ -21,6 +21,7 @@
 #include "tiledarray.h"
 #include "unit_test_config.h"
 #include "tensor_fixture.h"
+#include <algorithm>
 #include <iterator>
 
 
@@ -269,6 +270,27 @@ BOOST_AUTO_TEST_CASE( clone ) {
   BOOST_CHECK_EQUAL_COLLECTIONS(tc.begin(), tc.end(), t.begin(), t.end());
 }
 
+BOOST_AUTO_TEST_CASE( shift ) {
+  const std::vector<long> offset(t.range().rank(), 3l);
+  const Range range = t.range();
+
+  // check that the shifted tensor shares the data of t
+  TensorN ts;
+  BOOST_REQUIRE_NO_THROW(ts = t.shift(offset));
+  BOOST_CHECK_EQUAL(ts.data(), t.data());
+  BOOST_CHECK_EQUAL(ts.range(), Range(range).inplace_shift(offset));
+  BOOST_CHECK_EQUAL(t.range(), range);
+
+  // check that the data outlives t and that shifted tensors can be shifted
+  const TensorN tc = t.clone();
+  t = TensorN();
+  const std::vector<long> back(offset.size(), -3l);
+  TensorN tss = ts.shift(back);
+  ts = TensorN();
+  BOOST_CHECK_EQUAL(tss.range(), range);
+  BOOST_CHECK_EQUAL_COLLECTIONS(tss.begin(), tss.end(), tc.begin(), tc.end());
+}
+
 BOOST_AUTO_TEST_CASE( range_accessor )
 {
   BOOST_CHECK_EQUAL_COLLECTIONS(t.range().lobound_data(), t.range().lobound_data() + t.range().rank(),
@@ -534,5 +556,77 @@ BOOST_AUTO_TEST_CASE( inplace_conj_scal_op ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( numa_policy ) {
+  const NumaPolicy policy = TiledArray::numa_policy();
+
+  for(const auto p : {NumaPolicy::interleave, NumaPolicy::local, NumaPolicy::first_touch}) {
+    // place every allocation, regardless of its size
+    TiledArray::set_numa_policy(p, 0ul);
+    BOOST_CHECK(TiledArray::numa_policy() == p);
+
+    TensorD t(Range(64, 64, 8), 1.0);
+    BOOST_CHECK_EQUAL(t.sum(), 64.0 * 64.0 * 8.0);
+
+#ifdef TILEDARRAY_HAS_NUMA
+    if(TiledArray::numa_enabled()) {
+      // the middle of the tile lies in a page that was placed by the policy
+      void* const page = t.data() + t.size() / 2ul;
+      int mode = -1;
+      BOOST_REQUIRE_EQUAL(get_mempolicy(&mode, nullptr, 0ul, page, MPOL_F_ADDR), 0);
+      if(p == NumaPolicy::interleave)
+        BOOST_CHECK_EQUAL(mode, MPOL_INTERLEAVE);
+      else if(p == NumaPolicy::local)
+        BOOST_CHECK_EQUAL(mode, MPOL_PREFERRED);
+
+      // the pages of an interleaved tile reside on more than one node
+      const long page_size = sysconf(_SC_PAGESIZE);
+      std::vector<void*> pages;
+      for(auto* first = reinterpret_cast<char*>(t.data()) + page_size,
+          * last = reinterpret_cast<char*>(t.data() + t.size()) - page_size;
+          first < last; first += page_size)
+        pages.push_back(first);
+      std::vector<int> nodes(pages.size(), -1);
+      BOOST_REQUIRE_EQUAL(move_pages(0, pages.size(), pages.data(), nullptr,
+          nodes.data(), 0), 0);
+      for(const int node : nodes) {
+        BOOST_CHECK_GE(node, 0);
+        BOOST_CHECK_LE(node, numa_max_node());
+      }
+      if(p == NumaPolicy::interleave)
+        BOOST_CHECK(std::any_of(nodes.begin(), nodes.end(),
+            [&] (const int node) { return node != nodes.front(); }));
+    } else {
+      BOOST_TEST_MESSAGE("numa_policy: not a NUMA system, placement is not checked");
+    }
+#else
+    BOOST_TEST_MESSAGE("numa_policy: libnuma is not available, placement is not checked");
+#endif  // TILEDARRAY_HAS_NUMA
+  }
+
+  TiledArray::set_numa_policy(policy);
+}
+
+BOOST_AUTO_TEST_CASE( memory_accounting ) {
+  const std::size_t bytes = 16ul * 16ul * sizeof(double);
+  const MemoryUsage before = TiledArray::memory_usage(MemoryCategory::reduce);
+  {
+    detail::MemoryCategoryScope scope(MemoryCategory::reduce);
+    TensorD t(Range(16, 16), 1.0);
+    const MemoryUsage during = TiledArray::memory_usage(MemoryCategory::reduce);
+    BOOST_CHECK_EQUAL(during.current, before.current + bytes);
+    BOOST_CHECK_GE(during.peak, during.current);
+  }
+  BOOST_CHECK(detail::memory_category() == MemoryCategory::tiles);
+  BOOST_CHECK_EQUAL(TiledArray::memory_usage(MemoryCategory::reduce).current, before.current);
+
+  const std::size_t budget = TiledArray::memory_budget();
+  TiledArray::set_memory_budget(TiledArray::memory_usage().current + bytes);
+  BOOST_CHECK_EQUAL(TiledArray::memory_available(), bytes);
+  TiledArray::set_memory_budget(budget);
+
+  BOOST_CHECK_EQUAL(detail::parse_memory_size("2 KiB"), 2048.0);
+  BOOST_CHECK_EQUAL(detail::parse_memory_size("1.5 MB"), 1500000.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 